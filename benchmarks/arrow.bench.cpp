@@ -0,0 +1,42 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+#include <tcb/arrow.hpp>
+#include <tcb/reduce.hpp>
+
+#include "bench_machinery.hpp"
+
+// Sums a column of 32 million int64s handed over through the Arrow C Data
+// Interface: copying it out of the producer's buffer into a vector first,
+// and viewing the buffer in place with arrow_import().
+
+int main()
+{
+    std::vector<std::int64_t> data(32'000'000);
+    std::iota(data.begin(), data.end(), 0);
+    auto const values = tcb::pointer<std::int64_t const[]>::from_address_with_size(data.data(),
+                                                                                   data.size());
+    ArrowSchema schema;
+    ArrowArray array;
+    tcb::arrow_export(values, tcb::ptr_to_mut(schema), tcb::ptr_to_mut(array));
+
+    measure("copy into a vector, then sum", 10, [&] {
+        auto const* const begin = static_cast<std::int64_t const*>(array.buffers[1]) + array.offset;
+        std::vector<std::int64_t> copy(begin, begin + array.length);
+        do_not_optimize(std::accumulate(copy.begin(), copy.end(), std::int64_t{0}));
+    });
+
+    measure("arrow_import, then sum", 10, [&] {
+        auto const column
+            = tcb::arrow_import<std::int64_t>(tcb::ptr_to(schema), tcb::ptr_to(array));
+        do_not_optimize(tcb::sum(column.values));
+    });
+
+    array.release(&array);
+    schema.release(&schema);
+}
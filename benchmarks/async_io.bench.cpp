@@ -0,0 +1,134 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <tcb/async_io.hpp>
+#include <tcb/direct_io.hpp>
+
+#include <fcntl.h>
+
+#include "bench_machinery.hpp"
+
+// Usage: tcb.pointer.bench.async_io [file]
+//
+// Reads random 4 KiB blocks of a file, one at a time with pread() and then
+// 32 at a time with each async_io backend. Without a file, a 256 MiB one is
+// written to /var/tmp. The file is opened with O_DIRECT if possible, so that
+// reads go to the device rather than the page cache.
+
+constexpr std::size_t block = 4096;
+constexpr std::size_t reads = 1 << 14;
+constexpr std::size_t queue_depth = 32;
+
+auto random_offsets(std::size_t file_size) -> std::vector<std::uint64_t>
+{
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<std::uint64_t> dist(0, file_size / block - 1);
+    std::vector<std::uint64_t> offsets(reads);
+    for (auto& off : offsets) {
+        off = dist(gen) * block;
+    }
+    return offsets;
+}
+
+void bench_sync(int fd, std::vector<std::uint64_t> const& offsets)
+{
+    tcb::aligned_buffer buf(block);
+    measure("pread()", 3, [&] {
+        for (std::uint64_t off : offsets) {
+            do_not_optimize(tcb::pread_aligned(fd, buf.get(), off));
+        }
+    });
+}
+
+void bench_async(int fd, std::vector<std::uint64_t> const& offsets, tcb::io_backend backend)
+{
+    tcb::async_io io({.queue_depth = queue_depth, .backend = backend, .threads = queue_depth});
+    tcb::aligned_buffer buf(block * queue_depth);
+    auto const data = buf.get();
+    std::vector<tcb::pointer<std::byte[]>> slots;
+    for (std::size_t i = 0; i < queue_depth; ++i) {
+        slots.push_back(data->subslice(i * block, block));
+    }
+    (void)io.register_buffers(tcb::ptr_to_array(slots));
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "async_io, %s, depth %zu",
+                  io.backend() == tcb::io_backend::io_uring ? "io_uring" : "thread pool",
+                  queue_depth);
+    measure(name, 3, [&] {
+        // Each completion starts the next read into the same slot
+        std::size_t next = 0;
+        std::size_t total = 0;
+        auto start = [&](std::size_t slot, auto& self) -> void {
+            if (next < offsets.size()) {
+                auto then = [&, slot](std::error_code, std::size_t n) {
+                    total += n;
+                    self(slot, self);
+                };
+                io.read(fd, slots[slot], offsets[next++], then);
+            }
+        };
+        for (std::size_t slot = 0; slot < queue_depth; ++slot) {
+            start(slot, start);
+        }
+        io.run();
+        do_not_optimize(total);
+    });
+}
+
+int main(int argc, char** argv)
+{
+    char path[] = "/var/tmp/tcb_async_io_bench_XXXXXX";
+    std::size_t file_size = 256u << 20;
+    if (argc > 1) {
+        int const fd = ::open(argv[1], O_RDONLY);
+        if (fd < 0) {
+            std::perror(argv[1]);
+            return 1;
+        }
+        file_size = static_cast<std::size_t>(::lseek(fd, 0, SEEK_END)) / block * block;
+        ::close(fd);
+    } else {
+        int const fd = ::mkstemp(path);
+        if (fd < 0) {
+            std::perror("mkstemp");
+            return 1;
+        }
+        tcb::aligned_buffer chunk(1 << 20);
+        auto const chunk_data = chunk.get();
+        std::mt19937 gen(1);
+        for (auto& b : *chunk_data) {
+            b = static_cast<std::byte>(gen());
+        }
+        for (std::size_t off = 0; off < file_size; off += chunk.size()) {
+            tcb::pwrite_aligned(fd, chunk_data, off);
+        }
+        ::close(fd);
+    }
+    char const* const file = argc > 1 ? argv[1] : path;
+
+    bool direct = true;
+    int fd = ::open(file, O_RDONLY | O_DIRECT);
+    if (fd < 0) {
+        direct = false;
+        fd = ::open(file, O_RDONLY);
+    }
+    if (argc <= 1) {
+        ::unlink(path);
+    }
+
+    std::printf("%zu random 4 KiB reads from %zu MiB%s\n", reads, file_size >> 20,
+                direct ? " with O_DIRECT" : " through the page cache");
+    auto const offsets = random_offsets(file_size);
+    bench_sync(fd, offsets);
+    bench_async(fd, offsets, tcb::io_backend::io_uring);
+    bench_async(fd, offsets, tcb::io_backend::thread_pool);
+    ::close(fd);
+}
@@ -0,0 +1,40 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+// Stops the compiler from optimising away a computed value
+template <typename T>
+void do_not_optimize(T const& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static T const volatile* sink;
+    sink = &value;
+#endif
+}
+
+// Runs fn() reps times, and reports the fastest run
+template <typename F>
+auto measure(char const* name, int reps, F fn) -> double
+{
+    using clock = std::chrono::steady_clock;
+
+    double best = 0.0;
+    for (int i = 0; i < reps; ++i) {
+        auto const start = clock::now();
+        fn();
+        std::chrono::duration<double, std::micro> const elapsed = clock::now() - start;
+        if (i == 0 || elapsed.count() < best) {
+            best = elapsed.count();
+        }
+    }
+
+    std::printf("%-40s %12.1f us\n", name, best);
+    return best;
+}
@@ -0,0 +1,94 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include <tcb/chunked_reader.hpp>
+#include <tcb/direct_io.hpp>
+
+#include <fcntl.h>
+
+#include "bench_machinery.hpp"
+
+// Usage: tcb.pointer.bench.chunked_reader [file]
+//
+// Checksums a file in 1 MiB chunks, reading each chunk and then summing it,
+// and then with chunked_reader, which reads the next chunk while the current
+// one is summed. Without a file, a 256 MiB one is written to /var/tmp. The file
+// is opened with O_DIRECT if possible, so that reads go to the device.
+
+constexpr std::size_t chunk_size = 1 << 20;
+
+// Cheap enough that the reads matter
+auto checksum(tcb::pointer<std::byte const[]> chunk, std::uint64_t sum) -> std::uint64_t
+{
+    for (std::byte b : *chunk) {
+        sum += std::to_integer<std::uint64_t>(b);
+    }
+    return sum;
+}
+
+int main(int argc, char** argv)
+{
+    char path[] = "/var/tmp/tcb_chunked_reader_bench_XXXXXX";
+    if (argc <= 1) {
+        int const fd = ::mkstemp(path);
+        if (fd < 0) {
+            std::perror("mkstemp");
+            return 1;
+        }
+        tcb::aligned_buffer chunk(chunk_size);
+        auto const chunk_data = chunk.get();
+        std::mt19937 gen(1);
+        for (auto& b : *chunk_data) {
+            b = static_cast<std::byte>(gen());
+        }
+        for (std::size_t off = 0; off < (256u << 20); off += chunk_size) {
+            tcb::pwrite_aligned(fd, chunk_data, off);
+        }
+        ::close(fd);
+    }
+    char const* const file = argc > 1 ? argv[1] : path;
+
+    bool direct = true;
+    int fd = ::open(file, O_RDONLY | O_DIRECT);
+    if (fd < 0) {
+        direct = false;
+        fd = ::open(file, O_RDONLY);
+    }
+    if (fd < 0) {
+        std::perror(file);
+        return 1;
+    }
+    std::printf("Summing in 1 MiB chunks%s\n",
+                direct ? " with O_DIRECT" : " through the page cache");
+
+    tcb::aligned_buffer buf(chunk_size);
+    auto const data = buf.get();
+    measure("read(), then sum", 3, [&] {
+        std::uint64_t h = 0;
+        std::uint64_t offset = 0;
+        while (std::size_t const n = tcb::pread_aligned(fd, data, offset)) {
+            h = checksum(data->first(n), h);
+            offset += n;
+        }
+        do_not_optimize(h);
+    });
+
+    measure("chunked_reader, overlapped", 3, [&] {
+        std::uint64_t h = 0;
+        for (auto chunk : tcb::chunked_reader(fd, chunk_size)) {
+            h = checksum(chunk, h);
+        }
+        do_not_optimize(h);
+    });
+
+    ::close(fd);
+    if (argc <= 1) {
+        ::unlink(path);
+    }
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <tcb/histogram.hpp>
+
+#include "bench_machinery.hpp"
+
+// Skewed keys: with few bins, every thread hammers the same counters
+void bench_histogram(std::size_t n, std::size_t bins, std::size_t threads)
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<std::uint32_t> dist(0, static_cast<std::uint32_t>(bins - 1));
+    std::vector<std::uint32_t> in_vec(n);
+    for (auto& x : in_vec) {
+        x = dist(gen);
+    }
+    std::vector<std::uint64_t> counts_vec(bins);
+
+    auto const in = tcb::ptr_to_array(in_vec);
+    auto const counts = tcb::ptr_to_mut_array(counts_vec);
+    auto bin_fn = [](std::uint32_t x) { return x; };
+
+    std::printf("\n%zu keys into %zu bins, %zu threads\n", n, bins, threads);
+
+    constexpr int reps = 5;
+
+    measure("sequential", reps, [&] {
+        tcb::histogram(in, bin_fn, counts);
+        do_not_optimize(counts_vec.front());
+    });
+
+    // Every thread increments the shared counters through an atomic view
+    measure("shared counters (atomic_view)", reps, [&] {
+        auto view = counts->atomic_view();
+        std::vector<std::jthread> workers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                std::size_t const begin = n / threads * t;
+                std::size_t const end = t + 1 == threads ? n : n / threads * (t + 1);
+                for (std::size_t i = begin; i < end; ++i) {
+                    view[in_vec[i]].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        workers.clear();
+        do_not_optimize(counts_vec.front());
+    });
+
+    measure("private sub-histograms (parallel)", reps, [&] {
+        tcb::histogram(tcb::parallel_t{threads}, in, bin_fn, counts);
+        do_not_optimize(counts_vec.front());
+    });
+}
+
+int main()
+{
+    std::size_t const hw = std::thread::hardware_concurrency();
+    std::size_t const threads = hw > 1 ? hw : 2;
+
+    for (std::size_t bins : {4u, 256u, 65536u}) {
+        bench_histogram(1 << 24, bins, threads);
+    }
+}
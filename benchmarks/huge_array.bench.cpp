@@ -0,0 +1,74 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include <tcb/huge_array.hpp>
+
+#include "bench_machinery.hpp"
+
+// Usage: tcb.pointer.bench.huge_array [GiB]
+//
+// Chases dependent random indices through a table of the given size (2 GiB
+// by default), so that nearly every access misses the cache, and with
+// normal pages, the TLB too.
+
+auto kind_name(tcb::page_kind kind) -> char const*
+{
+    switch (kind) {
+    case tcb::page_kind::normal: return "normal";
+    case tcb::page_kind::transparent_huge: return "transparent huge";
+    case tcb::page_kind::huge: return "hugetlb";
+    }
+    return "?";
+}
+
+void bench_random_access(std::size_t bytes, tcb::page_kind request)
+{
+    std::size_t const n = bytes / sizeof(std::uint64_t);
+    tcb::huge_array<std::uint64_t> table(n, request);
+    auto const data = table.get();
+
+    // Fill with random values, which touches every page
+    std::mt19937_64 gen(42);
+    for (auto& x : *data) {
+        x = gen();
+    }
+
+    char name[96];
+    std::snprintf(name, sizeof(name), "%s pages (%zu KiB)", kind_name(table.pages()),
+                  table.page_size() / 1024);
+
+    constexpr std::size_t accesses = 1 << 22;
+    std::uint64_t const mask = n - 1;
+    std::uint64_t const* first = data->data();
+    measure(name, 3, [&] {
+        // Mixing in the loop counter stops the chase getting stuck in a
+        // short cycle
+        std::uint64_t idx = 0;
+        for (std::size_t i = 0; i < accesses; ++i) {
+            idx = (first[idx] + i) & mask;
+        }
+        do_not_optimize(idx);
+    });
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t gib = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2;
+    // A power of two, so that indices can be masked
+    std::size_t bytes = std::size_t{1} << 30;
+    while (gib > 1) {
+        bytes *= 2;
+        gib /= 2;
+    }
+
+    std::printf("%zu MiB table, 4M dependent random reads\n", bytes >> 20);
+    bench_random_access(bytes, tcb::page_kind::normal);
+    bench_random_access(bytes, tcb::page_kind::transparent_huge);
+    bench_random_access(bytes, tcb::page_kind::huge);
+}
@@ -0,0 +1,89 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <tcb/intern.hpp>
+
+#include "bench_machinery.hpp"
+
+// Four million occurrences of 10,000 distinct path-like tags: deduplicating
+// them with a std::unordered_set<std::string> and with an intern_table, and
+// then counting the occurrences of one tag, by comparing contents and by
+// comparing interned pointers.
+
+int main()
+{
+    std::vector<std::string> distinct;
+    for (std::size_t i = 0; i < 10'000; ++i) {
+        distinct.push_back("/service/region-" + std::to_string(i % 16) + "/metric/"
+                           + std::to_string(i * 7919));
+    }
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<std::size_t> dist(0, distinct.size() - 1);
+    std::vector<std::string> storage;
+    for (std::size_t i = 0; i < 4'000'000; ++i) {
+        storage.push_back(distinct[dist(gen)]);
+    }
+    std::vector<tcb::pointer<char const[]>> slices;
+    for (auto const& str : storage) {
+        slices.push_back(
+            tcb::pointer<char const[]>::from_address_with_size(str.data(), str.size()));
+    }
+
+    measure("unordered_set<string>::insert", 3, [&] {
+        std::unordered_set<std::string> set;
+        for (auto const& slice : slices) {
+            set.emplace(slice->data(), slice->size());
+        }
+        do_not_optimize(set.size());
+    });
+
+    measure("intern_table::intern", 3, [&] {
+        tcb::intern_table<char> table;
+        for (auto const& slice : slices) {
+            do_not_optimize(table.intern(slice));
+        }
+        do_not_optimize(table.size());
+    });
+
+    std::size_t const threads = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("\n%zu threads\n", threads);
+    measure("intern_table::intern (parallel)", 3, [&] {
+        tcb::intern_table<char> table;
+        auto copy = slices;
+        table.intern(tcb::parallel_t{threads}, tcb::ptr_to_mut_array(copy));
+        do_not_optimize(table.size());
+    });
+
+    tcb::intern_table<char> table;
+    auto interned = slices;
+    table.intern(tcb::parallel_t{threads}, tcb::ptr_to_mut_array(interned));
+    auto const needle = slices.front();
+    auto const interned_needle = interned.front();
+    std::printf("\n");
+
+    measure("count, comparing contents", 10, [&] {
+        std::size_t count = 0;
+        for (auto const& slice : slices) {
+            count += *slice == *needle;
+        }
+        do_not_optimize(count);
+    });
+
+    measure("count, comparing interned pointers", 10, [&] {
+        std::size_t count = 0;
+        for (auto const& slice : interned) {
+            count += slice == interned_needle;
+        }
+        do_not_optimize(count);
+    });
+}
@@ -0,0 +1,95 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <tcb/mapped_log.hpp>
+
+#include "bench_machinery.hpp"
+
+// Usage: tcb.pointer.bench.mapped_log [threads]
+//
+// Several threads each append a million 64-byte events to a log file in
+// /var/tmp: first by serialising each into a buffer and calling write()
+// under a mutex, and then by serialising straight into a mapped_log.
+
+constexpr std::size_t events_per_thread = 1'000'000;
+
+struct event {
+    std::uint64_t words[8];
+};
+
+void serialise(std::byte* dest, std::uint64_t thread, std::uint64_t seq)
+{
+    event ev{};
+    for (std::uint64_t i = 0; i < 8; ++i) {
+        ev.words[i] = thread * 31 + seq * 7 + i;
+    }
+    std::memcpy(dest, &ev, sizeof(event));
+}
+
+template <typename F>
+void run_threads(unsigned threads, F fn)
+{
+    std::vector<std::jthread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back(fn, t);
+    }
+}
+
+auto make_file(char* path) -> int
+{
+    int const fd = ::mkstemp(path);
+    if (fd < 0) {
+        std::perror("mkstemp");
+        std::exit(1);
+    }
+    ::unlink(path);
+    return fd;
+}
+
+int main(int argc, char** argv)
+{
+    unsigned const threads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 4;
+    std::printf("%u threads appending %zu events each\n", threads, events_per_thread);
+
+    measure("write() per event, under a mutex", 3, [&] {
+        char path[] = "/var/tmp/tcb_mapped_log_bench_XXXXXX";
+        int const fd = make_file(path);
+        std::mutex mutex;
+        run_threads(threads, [&](unsigned t) {
+            std::byte buf[sizeof(event)];
+            for (std::size_t i = 0; i < events_per_thread; ++i) {
+                serialise(buf, t, i);
+                std::lock_guard lock(mutex);
+                if (::write(fd, buf, sizeof(buf)) != sizeof(buf)) {
+                    std::abort();
+                }
+            }
+        });
+        ::close(fd);
+    });
+
+    measure("tcb::mapped_log", 3, [&] {
+        char path[] = "/var/tmp/tcb_mapped_log_bench_XXXXXX";
+        int const fd = make_file(path);
+        {
+            tcb::mapped_log log(fd);
+            run_threads(threads, [&](unsigned t) {
+                for (std::size_t i = 0; i < events_per_thread; ++i) {
+                    tcb::pointer<std::byte[]> const space = log.reserve(sizeof(event));
+                    serialise(space->data(), t, i);
+                    log.commit(space);
+                }
+            });
+        }
+        ::close(fd);
+    });
+}
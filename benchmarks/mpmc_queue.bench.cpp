@@ -0,0 +1,135 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <tcb/mpmc_queue.hpp>
+
+#include "bench_machinery.hpp"
+
+// A mutex-protected deque, for comparison
+template <typename T>
+class locked_queue {
+private:
+    std::mutex mutex_;
+    std::deque<tcb::pointer<T>> items_;
+    std::size_t capacity_;
+
+public:
+    explicit locked_queue(std::size_t capacity) : capacity_(capacity) { }
+
+    auto try_push(tcb::pointer<T> value) -> bool
+    {
+        std::lock_guard lock(mutex_);
+        if (items_.size() == capacity_) {
+            return false;
+        }
+        items_.push_back(value);
+        return true;
+    }
+
+    auto try_pop() -> std::optional<tcb::pointer<T>>
+    {
+        std::lock_guard lock(mutex_);
+        if (items_.empty()) {
+            return std::nullopt;
+        }
+        auto value = items_.front();
+        items_.pop_front();
+        return value;
+    }
+};
+
+// Producers push n pointers in total, and consumers pop them all. Push and
+// pop are attempted batch elements at a time.
+template <typename Queue>
+void transfer(Queue& queue, std::vector<int>& objects, std::size_t threads, std::size_t batch)
+{
+    std::size_t const n = objects.size();
+    std::atomic<std::size_t> popped{0};
+    std::vector<std::jthread> workers;
+
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::size_t const begin = n / threads * t;
+            std::size_t const end = t + 1 == threads ? n : n / threads * (t + 1);
+            std::vector<tcb::pointer<int>> items;
+            for (std::size_t i = begin; i < end; ++i) {
+                items.push_back(tcb::ptr_to_mut(objects[i]));
+            }
+
+            std::size_t i = 0;
+            while (i < items.size()) {
+                std::size_t pushed = 0;
+                if constexpr (requires { queue.try_push(tcb::ptr_to_array(items)); }) {
+                    if (batch > 1) {
+                        std::size_t const len = items.size() - i < batch ? items.size() - i : batch;
+                        auto const all = tcb::ptr_to_array(items);
+                        pushed = queue.try_push(all->subslice(i, len));
+                    } else {
+                        pushed = queue.try_push(items[i]) ? 1 : 0;
+                    }
+                } else {
+                    pushed = queue.try_push(items[i]) ? 1 : 0;
+                }
+                i += pushed;
+                if (pushed == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (std::size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&] {
+            std::vector<tcb::pointer<int>> out(batch, tcb::ptr_to_mut(objects[0]));
+            while (popped.load(std::memory_order_relaxed) < n) {
+                std::size_t got = 0;
+                if constexpr (requires { queue.try_pop(tcb::ptr_to_mut_array(out)); }) {
+                    got = batch > 1 ? queue.try_pop(tcb::ptr_to_mut_array(out))
+                                    : static_cast<std::size_t>(queue.try_pop().has_value());
+                } else {
+                    got = static_cast<std::size_t>(queue.try_pop().has_value());
+                }
+                popped.fetch_add(got, std::memory_order_relaxed);
+                if (got == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+}
+
+int main()
+{
+    std::size_t const hw = std::thread::hardware_concurrency();
+    std::size_t const threads = hw > 3 ? hw / 2 : 2;
+    constexpr std::size_t n = 1 << 20;
+    constexpr std::size_t capacity = 1024;
+    constexpr int reps = 5;
+
+    std::vector<int> objects(n);
+
+    std::printf("%zu pointers, %zu producers and %zu consumers, capacity %zu\n", n, threads,
+                threads, capacity);
+
+    measure("mutex + deque", reps, [&] {
+        locked_queue<int> queue(capacity);
+        transfer(queue, objects, threads, 1);
+    });
+
+    for (std::size_t batch : {1u, 16u, 64u}) {
+        char name[64];
+        std::snprintf(name, sizeof(name), "mpmc_queue, batches of %zu", batch);
+        measure(name, reps, [&] {
+            tcb::mpmc_queue<int> queue(capacity);
+            transfer(queue, objects, threads, batch);
+        });
+    }
+}
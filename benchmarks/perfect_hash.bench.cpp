@@ -0,0 +1,67 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tcb/perfect_hash.hpp>
+
+#include "bench_machinery.hpp"
+
+// Maps ten million header names, a tenth of them unknown, to their indices
+// among 24 known ones: with an if chain of slice comparisons, and with a
+// perfect_hash.
+
+#define TCB_BENCH_HEADERS                                                                     \
+    "accept", "accept-encoding", "accept-language", "authorization", "cache-control",        \
+        "connection", "content-encoding", "content-length", "content-type", "cookie", "date", \
+        "etag", "expect", "host", "if-modified-since", "if-none-match", "last-modified",      \
+        "location", "origin", "range", "referer", "server", "user-agent", "vary"
+
+constexpr char const* header_list[] = {TCB_BENCH_HEADERS};
+constexpr tcb::perfect_hash headers(TCB_BENCH_HEADERS);
+
+int main()
+{
+    std::vector<std::string> names(header_list, header_list + headers.size());
+    names.push_back("x-request-id");
+    names.push_back("x-forwarded-for");
+    names.push_back("sec-fetch-mode");
+
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<std::size_t> dist(0, names.size() - 1);
+    std::vector<tcb::pointer<char const[]>> tokens;
+    for (std::size_t i = 0; i < 10'000'000; ++i) {
+        auto const& name = names[dist(gen)];
+        tokens.push_back(tcb::pointer<char const[]>::from_address_with_size(name.data(),
+                                                                            name.size()));
+    }
+    std::vector<tcb::pointer<char const[]>> keys;
+    for (std::size_t i = 0; i < headers.size(); ++i) {
+        keys.push_back(headers.key(i));
+    }
+
+    measure("if chain of slice comparisons", 5, [&] {
+        std::size_t sum = 0;
+        for (auto const& token : tokens) {
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                if (*token == *keys[i]) {
+                    sum += i;
+                    break;
+                }
+            }
+        }
+        do_not_optimize(sum);
+    });
+
+    measure("perfect_hash::find", 5, [&] {
+        std::size_t sum = 0;
+        for (auto const& token : tokens) {
+            sum += headers.find(token).value_or(0);
+        }
+        do_not_optimize(sum);
+    });
+}
@@ -0,0 +1,66 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <utility> // for std::exchange
+#include <vector>
+
+#include <tcb/radix_partition.hpp>
+
+#include "bench_machinery.hpp"
+
+void bench_partition(std::size_t n, unsigned bits)
+{
+    std::mt19937_64 gen(42);
+    std::vector<std::uint64_t> in_vec(n);
+    for (auto& x : in_vec) {
+        x = gen();
+    }
+    std::vector<std::uint64_t> out_vec(n);
+
+    auto const in = tcb::ptr_to_array(in_vec);
+    auto const out = tcb::ptr_to_mut_array(out_vec);
+    auto key_fn = [](std::uint64_t x) { return x; };
+    std::size_t const num = std::size_t{1} << bits;
+
+    std::printf("\n%zu 8-byte keys into %zu partitions\n", n, num);
+
+    constexpr int reps = 10;
+
+    // Histogram and scatter through the slices' checked operator[]
+    measure("naive scatter (checked operator[])", reps, [&] {
+        std::vector<std::size_t> cursor(num);
+        for (std::size_t i = 0; i < n; ++i) {
+            ++cursor[(*in)[i] & (num - 1)];
+        }
+        std::size_t offset = 0;
+        for (auto& c : cursor) {
+            offset += std::exchange(c, offset);
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            std::uint64_t const x = (*in)[i];
+            (*out)[cursor[x & (num - 1)]++] = x;
+        }
+        do_not_optimize(out_vec.back());
+    });
+
+    measure("tcb::radix_partition", reps, [&] {
+        auto parts = tcb::radix_partition(in, key_fn, bits, out);
+        do_not_optimize(parts.size());
+    });
+
+    measure("tcb::radix_partition (parallel)", reps, [&] {
+        auto parts = tcb::radix_partition(tcb::parallel, in, key_fn, bits, out);
+        do_not_optimize(parts.size());
+    });
+}
+
+int main()
+{
+    for (unsigned bits : {4u, 6u, 7u, 8u, 10u, 12u}) {
+        bench_partition(1 << 24, bits);
+    }
+}
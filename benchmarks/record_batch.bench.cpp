@@ -0,0 +1,63 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <tcb/record_batch.hpp>
+
+#include "bench_machinery.hpp"
+
+// SELECT SUM(quantity) WHERE price > 50 AND region == 3, over 16M rows in
+// batches of 64K: row at a time through the columns' checked indexing, and
+// a batch at a time with two filters and a pass over the selected rows.
+
+int main()
+{
+    constexpr std::size_t n = 16 * 1024 * 1024;
+    constexpr std::size_t batch_rows = 64 * 1024;
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> price_dist(0, 100);
+    std::uniform_int_distribution<std::int32_t> qty_dist(1, 10);
+    std::uniform_int_distribution<int> region_dist(0, 7);
+    std::vector<double> prices(n);
+    std::vector<std::int32_t> quantities(n);
+    std::vector<std::uint8_t> regions(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        prices[i] = price_dist(gen);
+        quantities[i] = qty_dist(gen);
+        regions[i] = static_cast<std::uint8_t>(region_dist(gen));
+    }
+    auto const price_col = tcb::ptr_to_array(prices);
+    auto const qty_col = tcb::ptr_to_array(quantities);
+    auto const region_col = tcb::ptr_to_array(regions);
+
+    measure("row at a time", 5, [&] {
+        std::int64_t total = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            if ((*price_col)[i] > 50 && (*region_col)[i] == 3) {
+                total += (*qty_col)[i];
+            }
+        }
+        do_not_optimize(total);
+    });
+
+    std::vector<std::uint32_t> selection(batch_rows);
+    auto const sel = tcb::ptr_to_mut_array(selection);
+    measure("record_batch, filter twice", 5, [&] {
+        std::int64_t total = 0;
+        for (std::size_t first = 0; first < n; first += batch_rows) {
+            tcb::record_batch batch(price_col->subslice(first, batch_rows),
+                                    qty_col->subslice(first, batch_rows),
+                                    region_col->subslice(first, batch_rows));
+            batch.filter<0>([](double p) { return p > 50; }, sel)
+                .filter<2>([](std::uint8_t r) { return r == 3; }, sel)
+                .project<1>()
+                .for_each_row([&](std::int32_t q) { total += q; });
+        }
+        do_not_optimize(total);
+    });
+}
@@ -0,0 +1,89 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <tcb/seqlock.hpp>
+
+#include "bench_machinery.hpp"
+
+// Many readers taking snapshots of a small block, while one writer updates
+// it now and then
+void bench_readers(std::size_t size, std::size_t readers, std::size_t reads_per_reader)
+{
+    std::vector<std::uint64_t> init(size, 1);
+    tcb::seqlock_buffer<std::uint64_t> seq_buf(tcb::ptr_to_array(init));
+    std::vector<std::uint64_t> mutex_buf = init;
+    std::mutex mutex;
+
+    std::printf("\n%zu readers of %zu elements, %zu reads each\n", readers, size, reads_per_reader);
+
+    constexpr int reps = 5;
+
+    auto run = [&](auto read_fn, auto write_fn) {
+        std::atomic<bool> done{false};
+        std::jthread writer([&] {
+            while (!done.load(std::memory_order_relaxed)) {
+                write_fn();
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        });
+        {
+            std::vector<std::jthread> workers;
+            for (std::size_t r = 0; r < readers; ++r) {
+                workers.emplace_back([&] {
+                    std::vector<std::uint64_t> out(size);
+                    for (std::size_t i = 0; i < reads_per_reader; ++i) {
+                        read_fn(out);
+                        do_not_optimize(out.front());
+                    }
+                });
+            }
+        }
+        done = true;
+    };
+
+    measure("mutex", reps, [&] {
+        run(
+            [&](std::vector<std::uint64_t>& out) {
+                std::lock_guard lock(mutex);
+                out = mutex_buf;
+            },
+            [&] {
+                std::lock_guard lock(mutex);
+                ++mutex_buf.front();
+            });
+    });
+
+    measure("seqlock_buffer::read(out)", reps, [&] {
+        run([&](std::vector<std::uint64_t>& out) { seq_buf.read(tcb::ptr_to_mut_array(out)); },
+            [&] { seq_buf.write([](tcb::pointer<std::uint64_t[]> data) { ++(*data)[0]; }); });
+    });
+
+    measure("seqlock_buffer::read(fn)", reps, [&] {
+        run(
+            [&](std::vector<std::uint64_t>& out) {
+                out.front() = seq_buf.read([](tcb::pointer<std::uint64_t const[]> data) {
+                    return std::accumulate(data->begin(), data->end(), std::uint64_t{0});
+                });
+            },
+            [&] { seq_buf.write([](tcb::pointer<std::uint64_t[]> data) { ++(*data)[0]; }); });
+    });
+}
+
+int main()
+{
+    std::size_t const hw = std::thread::hardware_concurrency();
+    std::size_t const readers = hw > 2 ? hw - 1 : 2;
+
+    for (std::size_t size : {8u, 128u}) {
+        bench_readers(size, readers, 1'000'000);
+    }
+}
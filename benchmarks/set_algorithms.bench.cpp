@@ -0,0 +1,103 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include <tcb/set_algorithms.hpp>
+
+#include "bench_machinery.hpp"
+
+// Posting-list style inputs: n distinct sorted ids from [0, range)
+auto make_postings(std::size_t n, std::uint32_t range, std::mt19937& gen)
+    -> std::vector<std::uint32_t>
+{
+    std::uniform_int_distribution<std::uint32_t> dist(0, range - 1);
+    std::vector<std::uint32_t> vec(n);
+    std::ranges::generate(vec, [&] { return dist(gen); });
+    std::ranges::sort(vec);
+    vec.erase(std::unique(vec.begin(), vec.end()), vec.end());
+    return vec;
+}
+
+void bench_intersection(std::size_t na, std::size_t nb, std::uint32_t range)
+{
+    std::mt19937 gen(42);
+    auto const a_vec = make_postings(na, range, gen);
+    auto const b_vec = make_postings(nb, range, gen);
+    std::vector<std::uint32_t> buffer(std::min(a_vec.size(), b_vec.size()));
+
+    tcb::pointer<std::uint32_t const[]> const a = tcb::ptr_to_array(a_vec);
+    tcb::pointer<std::uint32_t const[]> const b = tcb::ptr_to_array(b_vec);
+    tcb::pointer<std::uint32_t[]> const out = tcb::ptr_to_mut_array(buffer);
+
+    std::printf("\nintersection of %zu and %zu ids from [0, %u)\n", a_vec.size(), b_vec.size(),
+                range);
+
+    constexpr int reps = 50;
+
+    // The standard algorithm, using the slices' (checked) iterators
+    measure("std::set_intersection (slice iterators)", reps, [&] {
+        auto end = std::set_intersection(a->begin(), a->end(), b->begin(), b->end(),
+                                         out->begin());
+        do_not_optimize(end);
+    });
+
+    measure("tcb::set_intersection", reps, [&] {
+        auto result = tcb::set_intersection(a, b, out);
+        do_not_optimize(result->size());
+    });
+}
+
+void bench_kway_merge(std::size_t k, std::size_t n)
+{
+    std::mt19937 gen(1729);
+    std::vector<std::vector<std::uint32_t>> lists;
+    std::vector<tcb::pointer<std::uint32_t const[]>> inputs;
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < k; ++i) {
+        lists.push_back(make_postings(n, 1u << 30, gen));
+        total += lists.back().size();
+    }
+    for (auto const& list : lists) {
+        inputs.push_back(tcb::ptr_to_array(list));
+    }
+    std::vector<std::uint32_t> buffer(total);
+
+    std::printf("\n%zu-way merge of %zu ids each\n", k, n);
+
+    constexpr int reps = 20;
+
+    // Concatenating and sorting is the obvious alternative
+    measure("concatenate + std::sort", reps, [&] {
+        auto it = buffer.begin();
+        for (auto const& list : lists) {
+            it = std::copy(list.begin(), list.end(), it);
+        }
+        std::sort(buffer.begin(), buffer.end());
+        do_not_optimize(buffer.front());
+    });
+
+    measure("tcb::merge (loser tree)", reps, [&] {
+        auto result = tcb::merge(tcb::ptr_to_array(inputs), tcb::ptr_to_mut_array(buffer));
+        do_not_optimize(result->size());
+    });
+}
+
+int main()
+{
+    std::printf("SIMD level: %d\n", static_cast<int>(tcb::active_simd_level()));
+
+    // Similar sizes, at low and high match rates
+    bench_intersection(1'000'000, 1'000'000, 2'000'000);
+    bench_intersection(1'000'000, 1'000'000, 100'000'000);
+
+    // Skewed sizes, where galloping wins
+    bench_intersection(1'000, 1'000'000, 10'000'000);
+
+    bench_kway_merge(16, 100'000);
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <vector>
+
+#include <tcb/reduce.hpp>
+#include <tcb/soa_vector.hpp>
+
+#include "bench_machinery.hpp"
+
+// Ten million particles of eight fields, of which a step reads two: with the
+// particles in a std::vector of structs, and in a soa_vector, by rows and by
+// columns. Summing one field of the soa_vector uses the SIMD sum kernel.
+
+struct particle {
+    float x, y, z;
+    float vx, vy, vz;
+    float mass;
+    std::int32_t id;
+};
+
+int main()
+{
+    constexpr std::size_t n = 10'000'000;
+
+    std::vector<particle> aos(n, particle{0, 0, 0, 1, 2, 3, 1, 0});
+    tcb::soa_vector<float, float, float, float, float, float, float, std::int32_t> soa;
+    soa.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        soa.push_back(0, 0, 0, 1, 2, 3, 1, 0);
+    }
+
+    measure("vector of structs: x += vx", 10, [&] {
+        for (auto& p : aos) {
+            p.x += p.vx;
+        }
+        do_not_optimize(aos.front().x);
+    });
+
+    measure("soa_vector rows: x += vx", 10, [&] {
+        for (auto&& row : soa) {
+            std::get<0>(row) += std::get<3>(row);
+        }
+        do_not_optimize(std::get<0>(soa[0]));
+    });
+
+    measure("soa_vector columns: x += vx", 10, [&] {
+        auto const x = soa.column<0>();
+        auto const vx = soa.column<3>();
+        float* const xs = x->data();
+        float const* const vxs = vx->data();
+        for (std::size_t i = 0; i < n; ++i) {
+            xs[i] += vxs[i];
+        }
+        do_not_optimize(xs[0]);
+    });
+
+    measure("vector of structs: sum of mass", 10, [&] {
+        double total = 0;
+        for (auto const& p : aos) {
+            total += p.mass;
+        }
+        do_not_optimize(total);
+    });
+
+    measure("soa_vector column: tcb::sum of mass", 10, [&] {
+        do_not_optimize(tcb::sum(soa.column<6>(), 0.0));
+    });
+}
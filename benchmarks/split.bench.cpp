@@ -0,0 +1,81 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tcb/split.hpp>
+
+#include "bench_machinery.hpp"
+
+// Log-like text: 64 MiB of words and numbers separated by spaces, '=' and
+// tabs, in lines
+auto make_text() -> std::string
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<std::size_t> len_dist(1, 12);
+    std::uniform_int_distribution<int> char_dist('a', 'z');
+    std::uniform_int_distribution<int> sep_dist(0, 9);
+    std::string text;
+    text.reserve(64u << 20);
+    while (text.size() < (64u << 20)) {
+        std::size_t const len = len_dist(gen);
+        for (std::size_t i = 0; i < len; ++i) {
+            text.push_back(static_cast<char>(char_dist(gen)));
+        }
+        int const sep = sep_dist(gen);
+        text.push_back(sep < 6 ? ' ' : sep < 8 ? '=' : sep < 9 ? '\t' : '\n');
+    }
+    return text;
+}
+
+int main()
+{
+    auto const str = make_text();
+    auto const text = tcb::pointer<char const[]>::from_address_with_size(str.data(), str.size());
+    std::string_view const delims = " =\t\n";
+    std::printf("Tokenising %zu MiB on \" =\\t\\n\"\n", str.size() >> 20);
+
+    measure("find_first_of, std::string tokens", 5, [&] {
+        std::size_t total = 0;
+        std::string_view const sv = str;
+        std::size_t start = 0;
+        while (true) {
+            std::size_t const pos = sv.find_first_of(delims, start);
+            std::string const token(sv.substr(start, pos - start));
+            total += token.size();
+            if (pos == std::string_view::npos) {
+                break;
+            }
+            start = pos + 1;
+        }
+        do_not_optimize(total);
+    });
+
+    measure("string_view::find_first_of", 5, [&] {
+        std::size_t total = 0;
+        std::string_view const sv = str;
+        std::size_t start = 0;
+        while (true) {
+            std::size_t const pos = sv.find_first_of(delims, start);
+            total += sv.substr(start, pos - start).size();
+            if (pos == std::string_view::npos) {
+                break;
+            }
+            start = pos + 1;
+        }
+        do_not_optimize(total);
+    });
+
+    measure("tcb::split", 5, [&] {
+        std::size_t total = 0;
+        for (tcb::pointer<char const[]> token : tcb::split(text, delims)) {
+            total += token->size();
+        }
+        do_not_optimize(total);
+    });
+}
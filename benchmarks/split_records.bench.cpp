@@ -0,0 +1,67 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tcb/split_records.hpp>
+
+#include "bench_machinery.hpp"
+
+// CSV-like text: 256 MiB of lines averaging 80 bytes
+auto make_text() -> std::string
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<std::size_t> len_dist(20, 140);
+    std::uniform_int_distribution<int> char_dist(' ', '~');
+    std::string text;
+    text.reserve(256u << 20);
+    while (text.size() < (256u << 20)) {
+        std::size_t const len = len_dist(gen);
+        for (std::size_t i = 0; i < len; ++i) {
+            text.push_back(static_cast<char>(char_dist(gen)));
+        }
+        text.push_back('\n');
+    }
+    return text;
+}
+
+int main()
+{
+    auto const str = make_text();
+    auto const text = tcb::pointer<char const[]>::from_address_with_size(str.data(), str.size());
+    std::printf("Splitting %zu MiB of lines\n", str.size() >> 20);
+
+    std::vector<tcb::pointer<char const[]>> records;
+    records.reserve(str.size() / 16);
+
+    measure("memchr loop", 5, [&] {
+        records.clear();
+        char const* first = str.data();
+        char const* const last = first + str.size();
+        while (first != last) {
+            auto const rest = static_cast<std::size_t>(last - first);
+            auto const* nl = static_cast<char const*>(std::memchr(first, '\n', rest));
+            char const* const end = nl ? nl : last;
+            records.push_back(tcb::pointer<char const[]>::from_address_with_size(
+                first, static_cast<std::size_t>(end - first)));
+            first = nl ? nl + 1 : last;
+        }
+        do_not_optimize(records.size());
+    });
+
+    measure("tcb::split_records", 5, [&] {
+        records.clear();
+        tcb::split_records(text, '\n', records);
+        do_not_optimize(records.size());
+    });
+
+    measure("tcb::split_records (parallel)", 5, [&] {
+        auto per_task = tcb::split_records(tcb::parallel, text);
+        do_not_optimize(per_task.size());
+    });
+}
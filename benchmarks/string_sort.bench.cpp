@@ -0,0 +1,59 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <tcb/string_sort.hpp>
+
+#include "bench_machinery.hpp"
+
+// Sorts two million URL-like keys, which share long prefixes, as an index
+// build would: with std::sort and the slices' operator<=>, and with
+// string_sort, sequentially and in parallel.
+
+int main()
+{
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> host_dist(0, 99);
+    std::uniform_int_distribution<int> char_dist('a', 'z');
+    std::uniform_int_distribution<std::size_t> len_dist(4, 40);
+    std::vector<std::string> storage;
+    for (std::size_t i = 0; i < 2'000'000; ++i) {
+        std::string str = "https://www." + std::to_string(host_dist(gen)) + ".example.com/";
+        for (std::size_t len = len_dist(gen); len > 0; --len) {
+            str.push_back(static_cast<char>(char_dist(gen)));
+        }
+        storage.push_back(std::move(str));
+    }
+    std::vector<tcb::pointer<char const[]>> keys;
+    for (auto const& str : storage) {
+        keys.push_back(tcb::pointer<char const[]>::from_address_with_size(str.data(), str.size()));
+    }
+
+    measure("std::sort", 3, [&] {
+        auto sorted = keys;
+        std::sort(sorted.begin(), sorted.end(),
+                  [](auto const& a, auto const& b) { return *a < *b; });
+        do_not_optimize(sorted.front());
+    });
+
+    measure("string_sort", 3, [&] {
+        auto sorted = keys;
+        tcb::string_sort(tcb::ptr_to_mut_array(sorted));
+        do_not_optimize(sorted.front());
+    });
+
+    std::size_t const threads = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("\n%zu threads\n", threads);
+    measure("string_sort (parallel)", 3, [&] {
+        auto sorted = keys;
+        tcb::string_sort(tcb::parallel_t{threads}, tcb::ptr_to_mut_array(sorted));
+        do_not_optimize(sorted.front());
+    });
+}
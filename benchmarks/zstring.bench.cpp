@@ -0,0 +1,54 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <tcb/zstring.hpp>
+
+#include "bench_machinery.hpp"
+
+// Counts the commas in a million C strings of assorted lengths, as a parser
+// which scans each string once would: first by converting each to a
+// pointer<char const[]>, which needs strlen(), and then by iterating a
+// zstring_ptr up to its terminator.
+
+int main()
+{
+    std::vector<std::string> storage;
+    for (std::size_t i = 0; i < 1'000'000; ++i) {
+        std::string str(8 + i * 7919 % 120, 'a');
+        for (std::size_t j = 3; j < str.size(); j += 7) {
+            str[j] = ',';
+        }
+        storage.push_back(std::move(str));
+    }
+    std::vector<char const*> c_strs;
+    for (auto const& str : storage) {
+        c_strs.push_back(str.c_str());
+    }
+
+    measure("strlen(), then scan", 10, [&] {
+        std::size_t commas = 0;
+        for (char const* s : c_strs) {
+            auto const arr = tcb::pointer<char const[]>::from_address_with_size(s, std::strlen(s));
+            for (char c : *arr) {
+                commas += c == ',';
+            }
+        }
+        do_not_optimize(commas);
+    });
+
+    measure("zstring_ptr, scan to sentinel", 10, [&] {
+        std::size_t commas = 0;
+        for (char const* s : c_strs) {
+            for (char c : tcb::zstring_ptr::from_address(s)) {
+                commas += c == ',';
+            }
+        }
+        do_not_optimize(commas);
+    });
+}
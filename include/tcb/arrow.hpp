@@ -0,0 +1,315 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_ARROW_HPP_INCLUDED
+#define TCB_ARROW_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+
+#include <bit> // for std::popcount
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // for std::strcmp, std::memcpy
+#include <memory> // for std::shared_ptr
+#include <optional>
+#include <stdexcept> // for std::invalid_argument, std::out_of_range
+
+// Zero-copy exchange of primitive columns through the Apache Arrow C Data
+// Interface, the plain C structs below, which need no Arrow library.
+//
+// arrow_import<T>() checks an ArrowArray's format, lengths and buffers once,
+// and gives its values as a pointer<T const[]> and its validity bitmap as a
+// bit_slice, both pointing into the producer's buffers. They stay valid
+// until the consumer calls the array's release callback.
+//
+// arrow_export() fills in an ArrowSchema and ArrowArray which point at
+// existing array pointers' data. Their release callbacks free only what
+// arrow_export() allocated, and drop the reference to an optional owner of
+// the data, such as a shared_ptr to the vector holding it.
+
+// The structs, exactly as the Arrow specification defines them, so that
+// they are compatible with any other definition guarded the same way
+#ifndef ARROW_C_DATA_INTERFACE
+#    define ARROW_C_DATA_INTERFACE
+
+#    define ARROW_FLAG_DICTIONARY_ORDERED 1
+#    define ARROW_FLAG_NULLABLE 2
+#    define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    // Array type description
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+#endif // ARROW_C_DATA_INTERFACE
+
+namespace tcb {
+
+// A read-only view of size bits of a bitmap, starting offset bits in. Bits
+// are numbered from the least significant bit of each byte, as in Arrow.
+class bit_slice {
+private:
+    std::uint8_t const* bytes_;
+    std::size_t offset_;
+    std::size_t size_;
+
+    // Bit number bit of the whole bitmap, ignoring the offset
+    auto test(std::size_t bit) const -> bool { return (bytes_[bit / 8] >> (bit % 8)) & 1; }
+
+public:
+    // bytes must hold at least offset + size bits
+    bit_slice(pointer<std::uint8_t const[]> bytes, std::size_t offset, std::size_t size)
+        : bytes_(bytes->data()), offset_(offset), size_(size)
+    {
+        if (offset > SIZE_MAX - 7 - size || (offset + size + 7) / 8 > bytes->size()) {
+            TCB_PTR_RUNTIME_ERROR("Bitmap too small passed to bit_slice");
+        }
+    }
+
+    auto size() const -> std::size_t { return size_; }
+
+    auto empty() const -> bool { return size_ == 0; }
+
+    auto operator[](std::size_t i) const -> bool
+    {
+        if (i >= size_) {
+            TCB_PTR_THROW(std::out_of_range("Index out of bounds in bit_slice access"));
+        }
+        return test(offset_ + i);
+    }
+
+    // The number of set bits, counted a word at a time
+    auto count() const -> std::size_t
+    {
+        std::size_t bit = offset_;
+        std::size_t const end = offset_ + size_;
+        std::size_t total = 0;
+        for (; bit < end && bit % 8 != 0; ++bit) {
+            total += test(bit);
+        }
+        for (; bit + 64 <= end; bit += 64) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes_ + bit / 8, sizeof(word));
+            total += static_cast<std::size_t>(std::popcount(word));
+        }
+        for (; bit < end; ++bit) {
+            total += test(bit);
+        }
+        return total;
+    }
+};
+
+namespace detail {
+
+// The Arrow format string of each primitive type we exchange
+template <typename T>
+inline constexpr char const* arrow_format = nullptr;
+template <>
+inline constexpr char const* arrow_format<std::int8_t> = "c";
+template <>
+inline constexpr char const* arrow_format<std::uint8_t> = "C";
+template <>
+inline constexpr char const* arrow_format<std::int16_t> = "s";
+template <>
+inline constexpr char const* arrow_format<std::uint16_t> = "S";
+template <>
+inline constexpr char const* arrow_format<std::int32_t> = "i";
+template <>
+inline constexpr char const* arrow_format<std::uint32_t> = "I";
+template <>
+inline constexpr char const* arrow_format<std::int64_t> = "l";
+template <>
+inline constexpr char const* arrow_format<std::uint64_t> = "L";
+template <>
+inline constexpr char const* arrow_format<float> = "f";
+template <>
+inline constexpr char const* arrow_format<double> = "g";
+
+template <typename T>
+concept arrow_primitive = arrow_format<T> != nullptr;
+
+// An address for the values of empty arrays whose producer passed null
+template <typename T>
+inline constexpr T empty_arrow_values[1] = {};
+
+// What arrow_export() allocates, freed by the array's release callback
+struct arrow_export_data {
+    void const* buffers[2];
+    std::shared_ptr<void const> owner;
+};
+
+inline void release_exported_array(ArrowArray* array) noexcept
+{
+    delete static_cast<arrow_export_data*>(array->private_data);
+    array->release = nullptr;
+}
+
+inline void release_exported_schema(ArrowSchema* schema) noexcept { schema->release = nullptr; }
+
+} // namespace detail
+
+// A primitive column imported from Arrow
+template <typename T>
+struct arrow_column {
+    pointer<T const[]> values;
+    // Absent if the array has no validity bitmap, because it has no nulls
+    std::optional<bit_slice> validity;
+    std::size_t null_count;
+
+    auto is_valid(std::size_t i) const -> bool { return !validity || (*validity)[i]; }
+};
+
+template <detail::arrow_primitive T>
+struct arrow_import_t {
+    // Views array, whose type schema describes, as a column of T. The
+    // format must be T's, and the array must not have been released. The C
+    // interface doesn't give the buffers' sizes, so those are trusted to
+    // cover the array's offset and length. Structures which are invalid, or
+    // not of T, come from the other side of the interface, so are thrown as
+    // std::invalid_argument.
+    auto operator()(pointer<ArrowSchema const> schema_ptr,
+                    pointer<ArrowArray const> array_ptr) const -> arrow_column<T>
+    {
+        ArrowSchema const& schema = *schema_ptr;
+        ArrowArray const& array = *array_ptr;
+        if (schema.release == nullptr || array.release == nullptr) {
+            TCB_PTR_THROW(
+                std::invalid_argument("Released Arrow structure passed to arrow_import()"));
+        }
+        if (schema.format == nullptr || std::strcmp(schema.format, detail::arrow_format<T>) != 0) {
+            TCB_PTR_THROW(
+                std::invalid_argument("Arrow format doesn't match the type in arrow_import()"));
+        }
+        if (array.length < 0 || array.offset < 0 || array.null_count < -1
+            || array.null_count > array.length || array.length > INT64_MAX - array.offset) {
+            TCB_PTR_THROW(
+                std::invalid_argument("Invalid Arrow array length passed to arrow_import()"));
+        }
+        if (array.n_buffers != 2 || array.buffers == nullptr || array.n_children != 0
+            || array.dictionary != nullptr) {
+            TCB_PTR_THROW(
+                std::invalid_argument("Arrow array of the wrong layout passed to arrow_import()"));
+        }
+        auto const length = static_cast<std::size_t>(array.length);
+        auto const offset = static_cast<std::size_t>(array.offset);
+
+        T const* first = nullptr;
+        if (auto const* values = static_cast<T const*>(array.buffers[1])) {
+            if (reinterpret_cast<std::uintptr_t>(values) % alignof(T) != 0) {
+                TCB_PTR_THROW(std::invalid_argument(
+                    "Misaligned Arrow values buffer passed to arrow_import()"));
+            }
+            first = values + offset;
+        } else if (length == 0) {
+            // There are no values, so nothing for the offset to skip
+            first = detail::empty_arrow_values<T>;
+        } else {
+            TCB_PTR_THROW(
+                std::invalid_argument("Null Arrow values buffer passed to arrow_import()"));
+        }
+
+        std::optional<bit_slice> validity;
+        std::size_t null_count = 0;
+        if (auto const* bits = static_cast<std::uint8_t const*>(array.buffers[0])) {
+            validity.emplace(pointer<std::uint8_t const[]>::from_address_with_size(
+                                 bits, (offset + length + 7) / 8),
+                             offset, length);
+            // -1 means the producer didn't count them
+            null_count = array.null_count >= 0 ? static_cast<std::size_t>(array.null_count)
+                                               : length - validity->count();
+        } else if (array.null_count > 0) {
+            TCB_PTR_THROW(std::invalid_argument(
+                "Arrow array with nulls but no bitmap passed to arrow_import()"));
+        }
+
+        return arrow_column<T>{pointer<T const[]>::from_address_with_size(first, length), validity,
+                               null_count};
+    }
+};
+
+template <typename T>
+inline constexpr auto arrow_import = arrow_import_t<T>{};
+
+struct arrow_export_t {
+private:
+    template <typename T>
+    static void fill(pointer<T const[]> const& values, std::uint8_t const* validity,
+                     std::size_t null_count, pointer<ArrowSchema> schema, pointer<ArrowArray> array,
+                     std::shared_ptr<void const> owner)
+    {
+        // The only allocation, so nothing has been written if it throws
+        auto* const data = new detail::arrow_export_data{{validity, values->data()},
+                                                         std::move(owner)};
+
+        *schema = ArrowSchema{};
+        schema->format = detail::arrow_format<T>;
+        schema->name = "";
+        schema->flags = validity != nullptr ? ARROW_FLAG_NULLABLE : 0;
+        schema->release = detail::release_exported_schema;
+
+        *array = ArrowArray{};
+        array->length = static_cast<std::int64_t>(values->size());
+        array->null_count = static_cast<std::int64_t>(null_count);
+        array->n_buffers = 2;
+        array->buffers = data->buffers;
+        array->release = detail::release_exported_array;
+        array->private_data = data;
+    }
+
+public:
+    // Describes values, which have no nulls, in schema and array. owner, if
+    // given, is kept until the array is released.
+    template <detail::arrow_primitive T>
+    void operator()(pointer<T const[]> values, pointer<ArrowSchema> schema,
+                    pointer<ArrowArray> array, std::shared_ptr<void const> owner = nullptr) const
+    {
+        fill(values, nullptr, 0, schema, array, std::move(owner));
+    }
+
+    // As above, with a validity bitmap of at least one bit per value, which
+    // is clear for the values which are null
+    template <detail::arrow_primitive T>
+    void operator()(pointer<T const[]> values, pointer<std::uint8_t const[]> validity,
+                    pointer<ArrowSchema> schema, pointer<ArrowArray> array,
+                    std::shared_ptr<void const> owner = nullptr) const
+    {
+        bit_slice const bits(validity, 0, values->size());
+        fill(values, validity->data(), values->size() - bits.count(), schema, array,
+             std::move(owner));
+    }
+};
+
+inline constexpr auto arrow_export = arrow_export_t{};
+
+} // namespace tcb
+
+#endif
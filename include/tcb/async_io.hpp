@@ -0,0 +1,765 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_ASYNC_IO_HPP_INCLUDED
+#define TCB_ASYNC_IO_HPP_INCLUDED
+
+#include <tcb/intrusive.hpp>
+#include <tcb/pointer.hpp>
+
+#include <concepts>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <functional> // for std::invoke
+#include <memory> // for std::unique_ptr
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#    include <cerrno>
+#    include <unistd.h>
+#    define TCB_PTR_HAVE_ASYNC_IO 1
+#else
+#    define TCB_PTR_HAVE_ASYNC_IO 0
+#endif
+
+#if TCB_PTR_HAVE_ASYNC_IO && __has_include(<linux/io_uring.h>) && __has_include(<sys/syscall.h>)
+#    include <atomic> // for std::atomic_ref
+#    include <linux/io_uring.h>
+#    include <sys/mman.h>
+#    include <sys/syscall.h>
+#    include <sys/uio.h> // for iovec
+#endif
+
+// IORING_FEAT_RW_CUR_POS arrived in the same kernel (5.6) as the plain
+// IORING_OP_READ and IORING_OP_WRITE opcodes we use, so its absence at
+// runtime tells us the kernel is too old
+#if defined(__NR_io_uring_setup) && defined(IORING_FEAT_RW_CUR_POS)
+#    define TCB_PTR_HAVE_IO_URING 1
+#else
+#    define TCB_PTR_HAVE_IO_URING 0
+#endif
+
+#if TCB_PTR_HAVE_ASYNC_IO
+
+namespace tcb {
+
+// How an async_io performs its reads and writes
+enum class io_backend {
+    // Linux's io_uring: batches of operations are handed to the kernel with
+    // a single system call, and complete without any threads of our own
+    io_uring,
+    // Blocking pread() and pwrite() calls on a pool of threads
+    thread_pool,
+};
+
+struct async_io_options {
+    // The number of operations the backend works on at once. More than this
+    // can be started: the rest wait their turn.
+    unsigned queue_depth = 64;
+    // The backend to try. io_uring falls back to the thread pool if the
+    // kernel doesn't support it, or won't let us use it.
+    io_backend backend = io_backend::io_uring;
+    // The size of the thread pool. Blocking I/O wants more threads than
+    // there are cores.
+    unsigned threads = 8;
+};
+
+namespace detail {
+
+// Linux transfers at most this much in one read or write
+inline constexpr std::size_t max_io_transfer = 0x7ffff000;
+
+// The offset which io_uring takes to mean the file's current position
+inline constexpr std::uint64_t io_current_position = ~std::uint64_t{0};
+
+// A read or write, and then its result. Operations are linked into one
+// list at a time as they move from being queued to being complete.
+struct io_op {
+    list_hook<io_op> hook;
+    // Called when the operation is complete
+    void (*complete)(io_op&);
+    int fd;
+    bool is_write;
+    // Never written through for a write
+    std::byte* addr;
+    std::size_t length;
+    std::uint64_t offset;
+    // The number of bytes transferred, or minus the error number
+    std::int64_t result = 0;
+
+    io_op(void (*complete_fn)(io_op&), int fd_, bool is_write_, std::byte* addr_,
+          std::size_t length_, std::uint64_t offset_)
+        : complete(complete_fn),
+          fd(fd_),
+          is_write(is_write_),
+          addr(addr_),
+          length(length_ < max_io_transfer ? length_ : max_io_transfer),
+          offset(offset_)
+    {
+    }
+
+    auto error() const -> std::error_code
+    {
+        return result < 0 ? std::error_code(static_cast<int>(-result), std::generic_category())
+                          : std::error_code();
+    }
+
+    auto bytes() const -> std::size_t { return result < 0 ? 0 : static_cast<std::size_t>(result); }
+};
+
+using io_op_list = intrusive_list<io_op, &io_op::hook>;
+
+// An operation which calls a callback, and then deletes itself
+template <typename F>
+struct io_callback_op : io_op {
+    F callback;
+
+    template <typename G>
+    io_callback_op(G&& fn, int fd_, bool is_write_, std::byte* addr_, std::size_t length_,
+                   std::uint64_t offset_)
+        : io_op(&run, fd_, is_write_, addr_, length_, offset_), callback(std::forward<G>(fn))
+    {
+    }
+
+    static void run(io_op& op)
+    {
+        std::unique_ptr<io_callback_op> self(static_cast<io_callback_op*>(&op));
+        std::invoke(self->callback, op.error(), op.bytes());
+    }
+};
+
+// Runs blocking pread()s and pwrite()s on a pool of threads
+class io_thread_pool {
+private:
+    std::mutex mutex_;
+    std::condition_variable work_ready_;
+    std::condition_variable done_ready_;
+    io_op_list work_;
+    io_op_list done_;
+    std::size_t outstanding_ = 0;
+    bool stopping_ = false;
+    // Last, so that the threads are joined before anything else is destroyed
+    std::vector<std::jthread> threads_;
+
+    static void perform(io_op& op)
+    {
+        ::ssize_t n = 0;
+        do {
+            if (op.offset == io_current_position) {
+                n = op.is_write ? ::write(op.fd, op.addr, op.length)
+                                : ::read(op.fd, op.addr, op.length);
+            } else {
+                auto const offset = static_cast<::off_t>(op.offset);
+                n = op.is_write ? ::pwrite(op.fd, op.addr, op.length, offset)
+                                : ::pread(op.fd, op.addr, op.length, offset);
+            }
+        } while (n < 0 && errno == EINTR);
+        op.result = n < 0 ? -errno : n;
+    }
+
+    void worker()
+    {
+        std::unique_lock lock(mutex_);
+        while (true) {
+            work_ready_.wait(lock, [this] { return stopping_ || !work_.empty(); });
+            auto const next = work_.pop_front();
+            if (!next) {
+                return;
+            }
+            pointer<io_op> const op = *next;
+            lock.unlock();
+            perform(*op);
+            lock.lock();
+            done_.push_back(op);
+            done_ready_.notify_one();
+        }
+    }
+
+    void stop() noexcept
+    {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        work_ready_.notify_all();
+        threads_.clear();
+    }
+
+public:
+    explicit io_thread_pool(unsigned threads)
+    {
+        threads_.reserve(threads > 0 ? threads : 1);
+        try {
+            do {
+                threads_.emplace_back([this] { worker(); });
+            } while (threads_.size() < threads);
+        } catch (...) {
+            stop();
+            throw;
+        }
+    }
+
+    io_thread_pool(io_thread_pool const&) = delete;
+    auto operator=(io_thread_pool const&) -> io_thread_pool& = delete;
+
+    // There must be no operations outstanding
+    ~io_thread_pool() { stop(); }
+
+    // Hands every operation in ops to the threads
+    void start(io_op_list& ops)
+    {
+        if (ops.empty()) {
+            return;
+        }
+        {
+            std::lock_guard lock(mutex_);
+            while (auto const op = ops.pop_front()) {
+                work_.push_back(*op);
+                ++outstanding_;
+            }
+        }
+        work_ready_.notify_all();
+    }
+
+    // Moves completed operations to out, first waiting for one to complete if
+    // wait is true and there are any outstanding
+    void reap(io_op_list& out, bool wait)
+    {
+        std::unique_lock lock(mutex_);
+        if (wait && outstanding_ > 0) {
+            done_ready_.wait(lock, [this] { return !done_.empty(); });
+        }
+        while (auto const op = done_.pop_front()) {
+            out.push_back(*op);
+            --outstanding_;
+        }
+    }
+};
+
+#    if TCB_PTR_HAVE_IO_URING
+
+// A minimal io_uring, which talks to the kernel directly rather than through
+// liburing
+class io_uring_ring {
+private:
+    int fd_ = -1;
+    void* sq_map_ = nullptr;
+    std::size_t sq_map_size_ = 0;
+    void* cq_map_ = nullptr;
+    std::size_t cq_map_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    std::size_t sqes_size_ = 0;
+
+    std::uint32_t* sq_head_ = nullptr;
+    std::uint32_t* sq_tail_ = nullptr;
+    std::uint32_t* sq_array_ = nullptr;
+    std::uint32_t sq_mask_ = 0;
+    std::uint32_t sq_entries_ = 0;
+    std::uint32_t* cq_head_ = nullptr;
+    std::uint32_t* cq_tail_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;
+    std::uint32_t cq_mask_ = 0;
+    std::uint32_t cq_entries_ = 0;
+
+    // Entries in the submission queue which the kernel hasn't seen yet
+    std::uint32_t unsubmitted_ = 0;
+    // Operations in the submission queue or the kernel, which we haven't
+    // reaped. Keeping this below cq_entries_ means the completion queue
+    // can't overflow.
+    std::size_t outstanding_ = 0;
+    std::vector<::iovec> fixed_;
+
+    // The kernel reads or writes the other end of each ring concurrently
+    static auto shared(std::uint32_t* index) -> std::atomic_ref<std::uint32_t>
+    {
+        return std::atomic_ref<std::uint32_t>(*index);
+    }
+
+    template <typename T>
+    static auto at(void* map, std::uint32_t offset) -> T*
+    {
+        return reinterpret_cast<T*>(static_cast<unsigned char*>(map) + offset);
+    }
+
+    auto map(std::size_t size, unsigned long long offset) const -> void*
+    {
+        void* const addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                  fd_, static_cast<::off_t>(offset));
+        return addr == MAP_FAILED ? nullptr : addr;
+    }
+
+    auto enter(std::uint32_t to_submit, std::uint32_t min_complete, std::uint32_t flags) const
+        -> int
+    {
+        return static_cast<int>(
+            ::syscall(__NR_io_uring_enter, fd_, to_submit, min_complete, flags, nullptr, 0));
+    }
+
+    auto setup(unsigned entries) -> bool
+    {
+        io_uring_params params{};
+        fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (fd_ < 0 || !(params.features & IORING_FEAT_RW_CUR_POS)) {
+            return false;
+        }
+
+        sq_map_size_ = params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+        cq_map_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool const single_map = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_map) {
+            sq_map_size_ = cq_map_size_ = sq_map_size_ > cq_map_size_ ? sq_map_size_ : cq_map_size_;
+        }
+        sq_map_ = map(sq_map_size_, IORING_OFF_SQ_RING);
+        if (!sq_map_) {
+            return false;
+        }
+        cq_map_ = single_map ? sq_map_ : map(cq_map_size_, IORING_OFF_CQ_RING);
+        if (!cq_map_) {
+            return false;
+        }
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map(sqes_size_, IORING_OFF_SQES));
+        if (!sqes_) {
+            return false;
+        }
+
+        sq_head_ = at<std::uint32_t>(sq_map_, params.sq_off.head);
+        sq_tail_ = at<std::uint32_t>(sq_map_, params.sq_off.tail);
+        sq_array_ = at<std::uint32_t>(sq_map_, params.sq_off.array);
+        sq_mask_ = *at<std::uint32_t>(sq_map_, params.sq_off.ring_mask);
+        sq_entries_ = params.sq_entries;
+        cq_head_ = at<std::uint32_t>(cq_map_, params.cq_off.head);
+        cq_tail_ = at<std::uint32_t>(cq_map_, params.cq_off.tail);
+        cqes_ = at<io_uring_cqe>(cq_map_, params.cq_off.cqes);
+        cq_mask_ = *at<std::uint32_t>(cq_map_, params.cq_off.ring_mask);
+        cq_entries_ = params.cq_entries;
+        return true;
+    }
+
+    io_uring_ring() = default;
+
+public:
+    // Returns null if io_uring isn't available
+    static auto create(unsigned entries) -> std::unique_ptr<io_uring_ring>
+    {
+        std::unique_ptr<io_uring_ring> ring(new io_uring_ring);
+        if (!ring->setup(entries)) {
+            ring.reset();
+        }
+        return ring;
+    }
+
+    io_uring_ring(io_uring_ring const&) = delete;
+    auto operator=(io_uring_ring const&) -> io_uring_ring& = delete;
+
+    // There must be no operations outstanding
+    ~io_uring_ring()
+    {
+        if (sqes_) {
+            ::munmap(sqes_, sqes_size_);
+        }
+        if (cq_map_ && cq_map_ != sq_map_) {
+            ::munmap(cq_map_, cq_map_size_);
+        }
+        if (sq_map_) {
+            ::munmap(sq_map_, sq_map_size_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    // Registers buffers with the kernel, replacing any registered before.
+    // Returns false if the kernel refuses.
+    auto register_buffers(pointer<pointer<std::byte[]> const[]> buffers) -> bool
+    {
+        if (!fixed_.empty()) {
+            (void)::syscall(__NR_io_uring_register, fd_, IORING_UNREGISTER_BUFFERS, nullptr, 0);
+            fixed_.clear();
+        }
+        if (buffers->empty()) {
+            return true;
+        }
+        std::vector<::iovec> iovecs;
+        iovecs.reserve(buffers->size());
+        for (pointer<std::byte[]> const& buf : *buffers) {
+            iovecs.push_back(::iovec{buf->data(), buf->size()});
+        }
+        if (::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS, iovecs.data(),
+                      static_cast<unsigned>(iovecs.size()))
+            != 0) {
+            return false;
+        }
+        fixed_ = std::move(iovecs);
+        return true;
+    }
+
+    // Adds op to the submission queue, or returns false if there is no room
+    // for it until some operations have been reaped
+    auto start(io_op& op) -> bool
+    {
+        if (outstanding_ >= cq_entries_) {
+            return false;
+        }
+        std::uint32_t const tail = *sq_tail_;
+        if (tail - shared(sq_head_).load(std::memory_order_acquire) >= sq_entries_) {
+            submit();
+            if (tail - shared(sq_head_).load(std::memory_order_acquire) >= sq_entries_) {
+                return false;
+            }
+        }
+
+        std::uint32_t const index = tail & sq_mask_;
+        io_uring_sqe& sqe = sqes_[index];
+        sqe = io_uring_sqe{};
+        sqe.opcode = op.is_write ? IORING_OP_WRITE : IORING_OP_READ;
+        sqe.fd = op.fd;
+        sqe.addr = reinterpret_cast<std::uintptr_t>(op.addr);
+        sqe.len = static_cast<std::uint32_t>(op.length);
+        sqe.off = op.offset;
+        sqe.user_data = reinterpret_cast<std::uintptr_t>(&op);
+        auto const first = reinterpret_cast<std::uintptr_t>(op.addr);
+        for (std::size_t i = 0; i < fixed_.size(); ++i) {
+            auto const base = reinterpret_cast<std::uintptr_t>(fixed_[i].iov_base);
+            if (first >= base && first - base + op.length <= fixed_[i].iov_len) {
+                sqe.opcode = op.is_write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+                sqe.buf_index = static_cast<std::uint16_t>(i);
+                break;
+            }
+        }
+
+        sq_array_[index] = index;
+        shared(sq_tail_).store(tail + 1, std::memory_order_release);
+        ++unsubmitted_;
+        ++outstanding_;
+        return true;
+    }
+
+    // Hands the submission queue to the kernel. If the kernel is too busy to
+    // take it all, the rest goes with the next call.
+    void submit()
+    {
+        while (unsubmitted_ > 0) {
+            int const n = enter(unsubmitted_, 0, 0);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EBUSY) {
+                    return;
+                }
+                TCB_PTR_THROW(std::system_error(errno, std::generic_category(), "io_uring_enter"));
+            }
+            if (n == 0) {
+                return;
+            }
+            unsubmitted_ -= static_cast<std::uint32_t>(n);
+        }
+    }
+
+    // Moves completed operations to out, first waiting for one to complete if
+    // wait is true and there are any outstanding
+    void reap(io_op_list& out, bool wait)
+    {
+        submit();
+        bool const empty = *cq_head_ == shared(cq_tail_).load(std::memory_order_acquire);
+        if (wait && empty && outstanding_ > 0) {
+            int n = 0;
+            while ((n = enter(unsubmitted_, 1, IORING_ENTER_GETEVENTS)) < 0) {
+                if (errno != EINTR) {
+                    TCB_PTR_THROW(
+                        std::system_error(errno, std::generic_category(), "io_uring_enter"));
+                }
+            }
+            unsubmitted_ -= static_cast<std::uint32_t>(n);
+        }
+
+        std::uint32_t head = *cq_head_;
+        std::uint32_t const tail = shared(cq_tail_).load(std::memory_order_acquire);
+        for (; head != tail; ++head) {
+            io_uring_cqe const& cqe = cqes_[head & cq_mask_];
+            auto* const op = reinterpret_cast<io_op*>(static_cast<std::uintptr_t>(cqe.user_data));
+            op->result = cqe.res;
+            out.push_back(ptr_to_mut(*op));
+            --outstanding_;
+        }
+        shared(cq_head_).store(head, std::memory_order_release);
+    }
+};
+
+#    endif // TCB_PTR_HAVE_IO_URING
+
+} // namespace detail
+
+class async_io;
+
+// The result of async_io::read() or write() without a callback, to be
+// co_awaited. The operation starts when the awaiting coroutine suspends,
+// and the coroutine is resumed by whichever async_io member function reaps
+// the completion.
+class io_awaitable : private detail::io_op {
+private:
+    async_io* io_;
+    std::coroutine_handle<> handle_;
+
+    friend class async_io;
+
+    io_awaitable(async_io& io, int fd, bool is_write, std::byte* addr, std::size_t length,
+                 std::uint64_t offset)
+        : detail::io_op(&resume, fd, is_write, addr, length, offset), io_(&io)
+    {
+    }
+
+    static void resume(detail::io_op& op) { static_cast<io_awaitable&>(op).handle_.resume(); }
+
+public:
+    io_awaitable(io_awaitable const&) = delete;
+    auto operator=(io_awaitable const&) -> io_awaitable& = delete;
+
+    auto await_ready() const noexcept -> bool { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle);
+
+    // The number of bytes transferred, which like pread() and pwrite() may
+    // be fewer than asked for. Throws std::system_error if the operation
+    // failed.
+    auto await_resume() const -> std::size_t
+    {
+        if (result < 0) {
+            TCB_PTR_THROW(std::system_error(error(), is_write ? "async write" : "async read"));
+        }
+        return bytes();
+    }
+};
+
+// Reads and writes files asynchronously, from and into array pointers.
+//
+// Operations are started with read() and write(), and completion is
+// reported either through a callback, called with a std::error_code and the
+// number of bytes transferred, or by resuming a coroutine which co_awaits
+// the operation. Operations are queued until submit(), poll(), wait() or
+// run() is called, so that a batch can be handed to the backend at once;
+// callbacks run and coroutines resume inside those calls, on the calling
+// thread. An async_io isn't thread-safe: one thread should drive it.
+//
+// A buffer must stay alive, and untouched, until its operation completes.
+// Like pread() and pwrite(), an operation may transfer fewer bytes than
+// asked for.
+class async_io {
+private:
+#    if TCB_PTR_HAVE_IO_URING
+    std::unique_ptr<detail::io_uring_ring> ring_;
+#    endif
+    std::unique_ptr<detail::io_thread_pool> pool_;
+    // Started, but not yet handed to the backend
+    detail::io_op_list queued_;
+    // Complete, but not yet reported, because an earlier callback threw
+    detail::io_op_list completed_;
+    std::size_t in_flight_ = 0;
+
+    friend class io_awaitable;
+
+    void queue(detail::io_op& op)
+    {
+        queued_.push_back(ptr_to_mut(op));
+        ++in_flight_;
+    }
+
+    void reap(bool wait)
+    {
+#    if TCB_PTR_HAVE_IO_URING
+        if (ring_) {
+            ring_->reap(completed_, wait);
+            return;
+        }
+#    endif
+        pool_->reap(completed_, wait);
+    }
+
+    auto report() -> std::size_t
+    {
+        std::size_t count = 0;
+        while (auto const next = completed_.pop_front()) {
+            pointer<detail::io_op> const op = *next;
+            --in_flight_;
+            ++count;
+            op->complete(*op);
+        }
+        return count;
+    }
+
+    template <typename F>
+    void start(F&& callback, int fd, bool is_write, std::byte* addr, std::size_t length,
+               std::uint64_t offset)
+    {
+        auto* const op = new detail::io_callback_op<std::decay_t<F>>(
+            std::forward<F>(callback), fd, is_write, addr, length, offset);
+        queue(*op);
+    }
+
+public:
+    // Passed as the offset to read or write at the file's current position,
+    // and advance it, like read() and write() rather than pread() and
+    // pwrite(). This is for pipes and sockets, which have no offsets, and
+    // only one such operation on a file should be in flight at a time. With
+    // io_uring, O_DIRECT reads and writes don't reliably advance the
+    // position of a regular file.
+    static constexpr std::uint64_t current_position = detail::io_current_position;
+
+    explicit async_io(async_io_options options = {})
+    {
+        if (options.queue_depth == 0) {
+            TCB_PTR_RUNTIME_ERROR("Zero queue depth passed to async_io()");
+        }
+#    if TCB_PTR_HAVE_IO_URING
+        if (options.backend == io_backend::io_uring) {
+            ring_ = detail::io_uring_ring::create(options.queue_depth);
+            if (ring_) {
+                return;
+            }
+        }
+#    endif
+        pool_ = std::make_unique<detail::io_thread_pool>(options.threads);
+    }
+
+    async_io(async_io const&) = delete;
+    auto operator=(async_io const&) -> async_io& = delete;
+
+    // Waits for the operations in flight, running their callbacks and
+    // resuming their coroutines, which must not throw
+    ~async_io() { run(); }
+
+    auto backend() const -> io_backend
+    {
+#    if TCB_PTR_HAVE_IO_URING
+        if (ring_) {
+            return io_backend::io_uring;
+        }
+#    endif
+        return io_backend::thread_pool;
+    }
+
+    // The number of operations which have been started but not yet reported
+    auto in_flight() const -> std::size_t { return in_flight_; }
+
+    // Reads into buf from fd at offset, then calls
+    // callback(std::error_code, std::size_t)
+    template <typename F>
+        requires std::invocable<std::decay_t<F>&, std::error_code, std::size_t>
+    void read(int fd, pointer<std::byte[]> buf, std::uint64_t offset, F&& callback)
+    {
+        start(std::forward<F>(callback), fd, false, buf->data(), buf->size(), offset);
+    }
+
+    // Writes buf to fd at offset, then calls
+    // callback(std::error_code, std::size_t)
+    template <typename F>
+        requires std::invocable<std::decay_t<F>&, std::error_code, std::size_t>
+    void write(int fd, pointer<std::byte const[]> buf, std::uint64_t offset, F&& callback)
+    {
+        start(std::forward<F>(callback), fd, true, const_cast<std::byte*>(buf->data()),
+              buf->size(), offset);
+    }
+
+    // Reads into buf from fd at offset, when co_awaited
+    [[nodiscard]] auto read(int fd, pointer<std::byte[]> buf, std::uint64_t offset)
+        -> io_awaitable
+    {
+        return io_awaitable(*this, fd, false, buf->data(), buf->size(), offset);
+    }
+
+    // Writes buf to fd at offset, when co_awaited
+    [[nodiscard]] auto write(int fd, pointer<std::byte const[]> buf, std::uint64_t offset)
+        -> io_awaitable
+    {
+        return io_awaitable(*this, fd, true, const_cast<std::byte*>(buf->data()), buf->size(),
+                            offset);
+    }
+
+    // Registers buffers which operations will use again and again, so that
+    // the kernel can pin them once rather than for every operation, and
+    // replaces any registered before. Operations on any part of a registered
+    // buffer then use io_uring's fixed-buffer opcodes. Returns false if the
+    // buffers can't be registered, because we are using the thread pool or
+    // they exceed RLIMIT_MEMLOCK; operations work the same either way. No
+    // operations may be in flight.
+    auto register_buffers(pointer<pointer<std::byte[]> const[]> buffers) -> bool
+    {
+        if (in_flight_ > 0) {
+            TCB_PTR_RUNTIME_ERROR("register_buffers() called with operations in flight");
+        }
+#    if TCB_PTR_HAVE_IO_URING
+        if (ring_) {
+            return ring_->register_buffers(buffers);
+        }
+#    endif
+        (void)buffers;
+        return false;
+    }
+
+    // Hands queued operations to the backend, without waiting
+    void submit()
+    {
+#    if TCB_PTR_HAVE_IO_URING
+        if (ring_) {
+            while (auto const op = queued_.front()) {
+                if (!ring_->start(**op)) {
+                    break;
+                }
+                queued_.pop_front();
+            }
+            ring_->submit();
+            return;
+        }
+#    endif
+        pool_->start(queued_);
+    }
+
+    // Submits queued operations, then reports those which have completed,
+    // without waiting. Returns the number reported.
+    auto poll() -> std::size_t
+    {
+        submit();
+        reap(false);
+        return report();
+    }
+
+    // Submits queued operations, then waits for at least one to complete, if
+    // any are in flight, and reports those which have. Returns the number
+    // reported.
+    auto wait() -> std::size_t
+    {
+        submit();
+        reap(completed_.empty());
+        return report();
+    }
+
+    // Waits for every operation in flight, including any started by
+    // callbacks and coroutines along the way
+    void run()
+    {
+        while (in_flight_ > 0) {
+            wait();
+        }
+    }
+};
+
+inline void io_awaitable::await_suspend(std::coroutine_handle<> handle)
+{
+    handle_ = handle;
+    io_->queue(*this);
+}
+
+} // namespace tcb
+
+#endif // TCB_PTR_HAVE_ASYNC_IO
+
+#endif
@@ -0,0 +1,402 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_CHUNKED_READER_HPP_INCLUDED
+#define TCB_CHUNKED_READER_HPP_INCLUDED
+
+#include <tcb/async_io.hpp>
+#include <tcb/direct_io.hpp>
+#include <tcb/pointer.hpp>
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // for std::memcpy
+#include <exception> // for std::exception_ptr
+#include <functional> // for std::invoke
+#include <iterator> // for std::default_sentinel_t
+#include <memory> // for std::unique_ptr
+#include <optional>
+#include <stdexcept> // for std::length_error
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if TCB_PTR_HAVE_ASYNC_IO
+
+namespace tcb {
+
+// A range of chunks of a file, produced by a coroutine as it is iterated
+// over. Each chunk is valid until the iterator is next incremented. Errors
+// reading the file are thrown as std::system_error from begin() or
+// operator++().
+class chunk_generator {
+public:
+    struct promise_type {
+        std::optional<pointer<std::byte const[]>> chunk;
+        std::exception_ptr error;
+
+        auto get_return_object() -> chunk_generator
+        {
+            return chunk_generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        auto initial_suspend() noexcept -> std::suspend_always { return {}; }
+        auto final_suspend() noexcept -> std::suspend_always { return {}; }
+
+        auto yield_value(pointer<std::byte const[]> value) noexcept -> std::suspend_always
+        {
+            chunk = value;
+            return {};
+        }
+
+        void return_void() noexcept { chunk = std::nullopt; }
+
+        void unhandled_exception() noexcept
+        {
+            chunk = std::nullopt;
+            error = std::current_exception();
+        }
+    };
+
+private:
+    using handle_type = std::coroutine_handle<promise_type>;
+
+    handle_type handle_;
+
+    explicit chunk_generator(handle_type handle) : handle_(handle) { }
+
+    static void advance(handle_type handle)
+    {
+        handle.resume();
+        if (auto error = std::exchange(handle.promise().error, nullptr)) {
+            std::rethrow_exception(error);
+        }
+    }
+
+public:
+    class iterator {
+    private:
+        handle_type handle_;
+
+        friend class chunk_generator;
+
+        explicit iterator(handle_type handle) : handle_(handle) { }
+
+    public:
+        using value_type = pointer<std::byte const[]>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        // Dereferencing the end iterator is an error
+        auto operator*() const -> pointer<std::byte const[]>
+        {
+            if (!handle_ || !handle_.promise().chunk) {
+                TCB_PTR_RUNTIME_ERROR("Dereferenced the end iterator of a chunk_generator");
+            }
+            return *handle_.promise().chunk;
+        }
+
+        auto operator++() -> iterator&
+        {
+            if (!handle_ || handle_.done()) {
+                TCB_PTR_RUNTIME_ERROR("Incremented past the end of a chunk_generator");
+            }
+            advance(handle_);
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        friend auto operator==(iterator const& it, std::default_sentinel_t) -> bool
+        {
+            return !it.handle_ || it.handle_.done();
+        }
+    };
+
+    chunk_generator(chunk_generator&& other) noexcept
+        : handle_(std::exchange(other.handle_, nullptr))
+    {
+    }
+
+    auto operator=(chunk_generator&& other) noexcept -> chunk_generator&
+    {
+        if (this != &other) {
+            if (handle_) {
+                handle_.destroy();
+            }
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    // Stops reading, waiting for any read in flight
+    ~chunk_generator()
+    {
+        if (handle_) {
+            handle_.destroy();
+        }
+    }
+
+    // Reads the first chunk. Can only be called once.
+    auto begin() -> iterator
+    {
+        if (!handle_ || handle_.promise().chunk || handle_.done()) {
+            TCB_PTR_RUNTIME_ERROR("begin() called twice on a chunk_generator");
+        }
+        advance(handle_);
+        return iterator(handle_);
+    }
+
+    auto end() const -> std::default_sentinel_t { return {}; }
+};
+
+namespace detail {
+
+// A read into one of a chunk reader's buffers
+struct chunk_read {
+    std::size_t bytes = 0;
+    std::error_code error;
+    bool pending = false;
+
+    void start(async_io& io, int fd, pointer<std::byte[]> buf, std::uint64_t offset)
+    {
+        pending = true;
+        io.read(fd, buf, offset, [this](std::error_code ec, std::size_t n) {
+            pending = false;
+            error = ec;
+            bytes = n;
+        });
+    }
+
+    auto finish(async_io& io) -> std::size_t
+    {
+        while (pending) {
+            io.wait();
+        }
+        if (error) {
+            TCB_PTR_THROW(std::system_error(error, "chunked_reader"));
+        }
+        return bytes;
+    }
+};
+
+// Waits for a read still in flight when a chunk reader is destroyed, so
+// that its buffer isn't freed under it
+struct chunk_read_guard {
+    async_io& io;
+    chunk_read& read;
+
+    ~chunk_read_guard()
+    {
+        while (read.pending) {
+            io.wait();
+        }
+    }
+};
+
+// Where to start reading fd: its current position, as an offset if it has
+// one. Reading at the current position only suits pipes and sockets: with
+// io_uring, O_DIRECT reads don't reliably advance it.
+inline auto chunk_start_offset(int fd) -> std::uint64_t
+{
+    ::off_t const pos = ::lseek(fd, 0, SEEK_CUR);
+    return pos < 0 ? async_io::current_position : static_cast<std::uint64_t>(pos);
+}
+
+inline void advance_chunk_offset(std::uint64_t& offset, std::size_t n)
+{
+    if (offset != async_io::current_position) {
+        offset += n;
+    }
+}
+
+inline auto make_chunk_io(std::size_t chunk_size) -> std::unique_ptr<async_io>
+{
+    if (chunk_size == 0) {
+        TCB_PTR_RUNTIME_ERROR("Zero chunk size passed to chunked_reader()");
+    }
+    // Only one read is ever in flight
+    return std::make_unique<async_io>(async_io_options{.queue_depth = 2, .threads = 1});
+}
+
+inline auto make_chunk_buffer(std::size_t chunk_size) -> aligned_buffer
+{
+    std::size_t const align = direct_io_alignment;
+    return aligned_buffer((chunk_size + align - 1) / align * align);
+}
+
+// owned is null if the io belongs to the caller. As a parameter, it is
+// destroyed after the locals, so any read in flight is waited for first.
+inline auto read_chunks(std::unique_ptr<async_io> owned, async_io& io, int fd,
+                        std::size_t chunk_size) -> chunk_generator
+{
+    (void)owned;
+    aligned_buffer storage[2] = {make_chunk_buffer(chunk_size), make_chunk_buffer(chunk_size)};
+    pointer<std::byte[]> const buffers[2] = {storage[0].get(), storage[1].get()};
+    chunk_read read;
+    chunk_read_guard const guard{io, read};
+
+    std::size_t current = 0;
+    std::uint64_t offset = chunk_start_offset(fd);
+    read.start(io, fd, buffers[current]->first(chunk_size), offset);
+    while (true) {
+        std::size_t const n = read.finish(io);
+        if (n == 0) {
+            co_return;
+        }
+        // The next chunk loads while this one is processed
+        advance_chunk_offset(offset, n);
+        read.start(io, fd, buffers[1 - current]->first(chunk_size), offset);
+        co_yield buffers[current]->first(n);
+        current = 1 - current;
+    }
+}
+
+// Like read_chunks(), but each chunk is cut after the prefix made up of
+// whole records, as measured by split, and the rest is moved to the start
+// of the other buffer to be completed by the next read
+template <typename Split>
+auto read_record_chunks(std::unique_ptr<async_io> owned, async_io& io, int fd,
+                        std::size_t chunk_size, Split split) -> chunk_generator
+{
+    (void)owned;
+    aligned_buffer storage[2] = {make_chunk_buffer(chunk_size), make_chunk_buffer(chunk_size)};
+    pointer<std::byte[]> const buffers[2] = {storage[0].get(), storage[1].get()};
+    chunk_read read;
+    chunk_read_guard const guard{io, read};
+
+    std::size_t current = 0;
+    // The bytes of an unfinished record at the start of the current buffer
+    std::size_t carried = 0;
+    std::uint64_t offset = chunk_start_offset(fd);
+    read.start(io, fd, buffers[current]->first(chunk_size), offset);
+    while (true) {
+        std::size_t const n = read.finish(io);
+        if (n == 0) {
+            // The last record needn't be terminated
+            if (carried > 0) {
+                co_yield buffers[current]->first(carried);
+            }
+            co_return;
+        }
+
+        auto const filled = buffers[current]->first(carried + n);
+        std::size_t const whole = std::invoke(split, pointer<std::byte const[]>(filled));
+        if (whole > filled->size()) {
+            TCB_PTR_RUNTIME_ERROR("Record splitter returned too large a size");
+        }
+        std::size_t const rest = filled->size() - whole;
+        if (rest == chunk_size) {
+            TCB_PTR_THROW(
+                std::length_error("Record longer than the chunk size in chunked_record_reader()"));
+        }
+
+        if (rest > 0) {
+            std::memcpy(buffers[1 - current]->data(), filled->data() + whole, rest);
+        }
+        advance_chunk_offset(offset, n);
+        read.start(io, fd, buffers[1 - current]->subslice(rest, chunk_size - rest), offset);
+        if (whole > 0) {
+            co_yield filled->first(whole);
+        }
+        carried = rest;
+        current = 1 - current;
+    }
+}
+
+// Splits after the last delimiter
+struct split_after_last {
+    std::byte delimiter;
+
+    auto operator()(pointer<std::byte const[]> data) const -> std::size_t
+    {
+        std::size_t n = data->size();
+        while (n > 0 && (*data)[n - 1] != delimiter) {
+            --n;
+        }
+        return n;
+    }
+};
+
+} // namespace detail
+
+struct chunked_reader_t {
+    // Reads fd from its current position to the end, as chunks of at most
+    // chunk_size bytes. While one chunk is being processed, the next is read
+    // into a second buffer. fd can be a file, pipe or socket; with a file
+    // opened with O_DIRECT, chunk_size must be a multiple of the block size.
+    // Files are read with explicit offsets, leaving their position where it
+    // was.
+    auto operator()(int fd, std::size_t chunk_size) const -> chunk_generator
+    {
+        auto owned = detail::make_chunk_io(chunk_size);
+        async_io& io = *owned;
+        return detail::read_chunks(std::move(owned), io, fd, chunk_size);
+    }
+
+    // As above, but doing the reads through io, which must outlive the
+    // generator
+    auto operator()(async_io& io, int fd, std::size_t chunk_size) const -> chunk_generator
+    {
+        if (chunk_size == 0) {
+            TCB_PTR_RUNTIME_ERROR("Zero chunk size passed to chunked_reader()");
+        }
+        return detail::read_chunks(nullptr, io, fd, chunk_size);
+    }
+};
+
+inline constexpr auto chunked_reader = chunked_reader_t{};
+
+struct chunked_record_reader_t {
+    // Like chunked_reader, but never splits a record between chunks: each
+    // chunk ends at the end of a record, except perhaps the last one, at the
+    // end of the file. split is called with the data read so far and returns
+    // the length of the prefix made of whole records. The part of a record at
+    // the end of a chunk is copied to the start of the other buffer, so
+    // records must be shorter than chunk_size; a longer one is thrown as
+    // std::length_error. The rest of the chunk is read in after it, at an
+    // unaligned position in the buffer, so unlike chunked_reader this can't
+    // read files opened with O_DIRECT.
+    template <typename Split>
+        requires std::is_invocable_r_v<std::size_t, Split&, pointer<std::byte const[]>>
+    auto operator()(int fd, std::size_t chunk_size, Split split) const -> chunk_generator
+    {
+        auto owned = detail::make_chunk_io(chunk_size);
+        async_io& io = *owned;
+        return detail::read_record_chunks(std::move(owned), io, fd, chunk_size, std::move(split));
+    }
+
+    template <typename Split>
+        requires std::is_invocable_r_v<std::size_t, Split&, pointer<std::byte const[]>>
+    auto operator()(async_io& io, int fd, std::size_t chunk_size, Split split) const
+        -> chunk_generator
+    {
+        if (chunk_size == 0) {
+            TCB_PTR_RUNTIME_ERROR("Zero chunk size passed to chunked_reader()");
+        }
+        return detail::read_record_chunks(nullptr, io, fd, chunk_size, std::move(split));
+    }
+
+    // For records which end with delimiter, such as lines
+    auto operator()(int fd, std::size_t chunk_size, std::byte delimiter) const -> chunk_generator
+    {
+        return (*this)(fd, chunk_size, detail::split_after_last{delimiter});
+    }
+
+    auto operator()(async_io& io, int fd, std::size_t chunk_size, std::byte delimiter) const
+        -> chunk_generator
+    {
+        return (*this)(io, fd, chunk_size, detail::split_after_last{delimiter});
+    }
+};
+
+inline constexpr auto chunked_record_reader = chunked_record_reader_t{};
+
+} // namespace tcb
+
+#endif // TCB_PTR_HAVE_ASYNC_IO
+
+#endif
@@ -0,0 +1,337 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_COMPACT_HPP_INCLUDED
+#define TCB_COMPACT_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+#include <tcb/cpu_dispatch.hpp>
+
+#include <bit> // for std::popcount
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // for std::memcpy
+#include <functional> // for std::invoke
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+#if TCB_PTR_MULTIVERSIONING
+#    include <immintrin.h>
+#endif
+
+// Stream compaction: copying the elements of an array which satisfy a
+// predicate to the front of an output array.
+//
+// The input is processed in blocks of one vector register. The predicate
+// is evaluated for each element of a block to build a bitmask, and then the
+// selected elements are "left-packed" to the output in one go: with the
+// AVX-512 compress instructions, or on AVX2 with a permutation computed
+// from the mask using pext. Elsewhere (and for elements which are not 4 or
+// 8 bytes) a branchless scalar loop is used.
+//
+// The output must be at least as long as the input, as the packing writes
+// whole blocks. Only the returned prefix of the output is meaningful; the
+// elements after it are overwritten with unspecified values taken from the
+// input.
+
+namespace tcb {
+
+namespace detail {
+
+template <typename T>
+inline constexpr bool packable
+    = std::is_trivially_copyable_v<T> && (sizeof(T) == 4 || sizeof(T) == 8);
+
+// The number of elements in a block
+template <typename T, simd_level Level>
+inline constexpr std::size_t pack_width
+    = !packable<T> || Level == simd_level::baseline ? 8
+    : Level == simd_level::avx512                   ? 64 / sizeof(T)
+                                                    : 32 / sizeof(T);
+
+#if TCB_PTR_MULTIVERSIONING
+TCB_PTR_TARGET_AVX512 inline void compress_store_32(void* dst, void const* src,
+                                                    std::uint32_t mask)
+{
+    _mm512_mask_compressstoreu_epi32(dst, static_cast<__mmask16>(mask), _mm512_loadu_si512(src));
+}
+
+TCB_PTR_TARGET_AVX512 inline void compress_store_64(void* dst, void const* src,
+                                                    std::uint32_t mask)
+{
+    _mm512_mask_compressstoreu_epi64(dst, static_cast<__mmask8>(mask), _mm512_loadu_si512(src));
+}
+
+// AVX2 has no compress instruction, so we permute the selected 32-bit lanes
+// to the front of the vector: pdep spreads each mask bit over a byte, and
+// pext then gathers the lane numbers of the selected lanes
+TCB_PTR_TARGET_AVX2 inline auto left_pack_32(__m256i vec, std::uint32_t mask) -> __m256i
+{
+    std::uint64_t const bytes = _pdep_u64(mask, 0x0101010101010101) * 0xFF;
+    std::uint64_t const lanes = _pext_u64(0x0706050403020100, bytes);
+    __m256i const perm = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<long long>(lanes)));
+    return _mm256_permutevar8x32_epi32(vec, perm);
+}
+
+// 64-bit elements are moved as pairs of 32-bit lanes
+TCB_PTR_TARGET_AVX2 inline auto left_pack_64(__m256i vec, std::uint32_t mask) -> __m256i
+{
+    return left_pack_32(vec, _pdep_u32(mask, 0x55) * 3);
+}
+
+// These store a whole vector
+TCB_PTR_TARGET_AVX2 inline void permute_store_32(void* dst, void const* src,
+                                                 std::uint32_t mask)
+{
+    __m256i const vec = _mm256_loadu_si256(static_cast<__m256i const*>(src));
+    _mm256_storeu_si256(static_cast<__m256i*>(dst), left_pack_32(vec, mask));
+}
+
+TCB_PTR_TARGET_AVX2 inline void permute_store_64(void* dst, void const* src,
+                                                 std::uint32_t mask)
+{
+    __m256i const vec = _mm256_loadu_si256(static_cast<__m256i const*>(src));
+    _mm256_storeu_si256(static_cast<__m256i*>(dst), left_pack_64(vec, mask));
+}
+
+// Null-stripping blocks. These only store the selected words, so that no
+// null is ever written to the output.
+TCB_PTR_TARGET_AVX512 inline auto strip_nulls_block_avx512(void* dst, void const* src)
+    -> std::size_t
+{
+    __m512i const vec = _mm512_loadu_si512(src);
+    __mmask8 const mask = _mm512_test_epi64_mask(vec, vec);
+    _mm512_mask_compressstoreu_epi64(dst, mask, vec);
+    return static_cast<std::size_t>(std::popcount(static_cast<unsigned>(mask)));
+}
+
+TCB_PTR_TARGET_AVX2 inline auto strip_nulls_block_avx2(void* dst, void const* src)
+    -> std::size_t
+{
+    __m256i const vec = _mm256_loadu_si256(static_cast<__m256i const*>(src));
+    __m256i const null = _mm256_cmpeq_epi64(vec, _mm256_setzero_si256());
+    auto const mask = ~static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(null)))
+        & 0xFu;
+    auto const count = std::popcount(mask);
+    __m256i const keep
+        = _mm256_cmpgt_epi64(_mm256_set1_epi64x(count), _mm256_setr_epi64x(0, 1, 2, 3));
+    _mm256_maskstore_epi64(static_cast<long long*>(dst), keep, left_pack_64(vec, mask));
+    return static_cast<std::size_t>(count);
+}
+#endif
+
+// Copies the elements src[j] for which bit j of mask is set to the front of
+// dst, and returns how many there were. dst must have room for a whole
+// block, and must not overlap src.
+template <simd_level Level, typename T>
+auto pack_block(T const* src, std::uint32_t mask, T* dst) -> std::size_t
+{
+#if TCB_PTR_MULTIVERSIONING
+    if constexpr (packable<T> && Level == simd_level::avx512) {
+        if constexpr (sizeof(T) == 4) {
+            compress_store_32(dst, src, mask);
+        } else {
+            compress_store_64(dst, src, mask);
+        }
+        return static_cast<std::size_t>(std::popcount(mask));
+    } else if constexpr (packable<T> && Level == simd_level::avx2) {
+        if constexpr (sizeof(T) == 4) {
+            permute_store_32(dst, src, mask);
+        } else {
+            permute_store_64(dst, src, mask);
+        }
+        return static_cast<std::size_t>(std::popcount(mask));
+    }
+#endif
+    std::size_t k = 0;
+    for (std::size_t j = 0; j < pack_width<T, Level>; ++j) {
+        dst[k] = src[j];
+        k += (mask >> j) & 1u;
+    }
+    return k;
+}
+
+struct compact_kernel {
+    template <simd_level Level, typename T, typename Pred>
+    auto operator()(simd_level_constant<Level>, T const* in, std::size_t n, Pred pred,
+                    T* out) const -> std::size_t
+    {
+        constexpr std::size_t width = pack_width<T, Level>;
+
+        std::size_t i = 0;
+        std::size_t k = 0;
+        for (; i + width <= n; i += width) {
+            std::uint32_t mask = 0;
+            for (std::size_t j = 0; j < width; ++j) {
+                mask |= static_cast<std::uint32_t>(static_cast<bool>(std::invoke(pred, in[i + j])))
+                    << j;
+            }
+            k += pack_block<Level>(in + i, mask, out + k);
+        }
+        for (; i < n; ++i) {
+            out[k] = in[i];
+            k += static_cast<std::size_t>(static_cast<bool>(std::invoke(pred, in[i])));
+        }
+        return k;
+    }
+};
+
+// As above, but packs the positions of the selected elements. The
+// positions are generated a block at a time and packed in the same way.
+struct select_kernel {
+    template <simd_level Level, typename T, typename Pred, typename I>
+    auto operator()(simd_level_constant<Level>, T const* in, std::size_t n, Pred pred,
+                    I* out) const -> std::size_t
+    {
+        constexpr std::size_t width = pack_width<I, Level>;
+
+        std::size_t i = 0;
+        std::size_t k = 0;
+        for (; i + width <= n; i += width) {
+            std::uint32_t mask = 0;
+            I positions[width];
+            for (std::size_t j = 0; j < width; ++j) {
+                mask |= static_cast<std::uint32_t>(static_cast<bool>(std::invoke(pred, in[i + j])))
+                    << j;
+                positions[j] = static_cast<I>(i + j);
+            }
+            k += pack_block<Level>(positions, mask, out + k);
+        }
+        for (; i < n; ++i) {
+            out[k] = static_cast<I>(i);
+            k += static_cast<std::size_t>(static_cast<bool>(std::invoke(pred, in[i])));
+        }
+        return k;
+    }
+};
+
+// Null-stripping works on the words of the optionals, which are null
+// exactly when the optional is disengaged
+struct strip_nulls_kernel {
+    template <simd_level Level>
+    auto operator()(simd_level_constant<Level>, void const* in, std::size_t n,
+                    void* out) const -> std::size_t
+    {
+        using word = std::uintptr_t;
+
+        auto const* src = static_cast<unsigned char const*>(in);
+        auto* dst = static_cast<unsigned char*>(out);
+
+        std::size_t i = 0;
+        std::size_t k = 0;
+#if TCB_PTR_MULTIVERSIONING
+        if constexpr (sizeof(word) == 8 && Level != simd_level::baseline) {
+            constexpr std::size_t width = pack_width<word, Level>;
+            for (; i + width <= n; i += width) {
+                if constexpr (Level == simd_level::avx512) {
+                    k += strip_nulls_block_avx512(dst + k * sizeof(word), src + i * sizeof(word));
+                } else {
+                    k += strip_nulls_block_avx2(dst + k * sizeof(word), src + i * sizeof(word));
+                }
+            }
+        }
+#endif
+        for (; i < n; ++i) {
+            word w;
+            std::memcpy(&w, src + i * sizeof(word), sizeof(word));
+            if (w != 0) {
+                std::memcpy(dst + k * sizeof(word), &w, sizeof(word));
+                ++k;
+            }
+        }
+        return k;
+    }
+};
+
+} // namespace detail
+
+struct compact_if_t {
+    // Copies the elements of in which satisfy pred, in order, to the front
+    // of out, and returns that prefix. out must be at least as long as in.
+    template <typename U, typename T, typename Pred>
+        requires std::same_as<std::remove_const_t<U>, T> && std::copyable<T>
+        && std::copy_constructible<Pred> && std::predicate<Pred const&, T const&>
+    auto operator()(pointer<U[]> in, Pred pred, pointer<T[]> out) const -> pointer<T[]>
+    {
+        if (out->size() < in->size()) {
+            TCB_PTR_RUNTIME_ERROR("Output too small in compact_if()");
+        }
+
+        T const* first = in->data();
+        std::size_t const n = in->size();
+        std::size_t count = 0;
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            count = detail::run_kernel<detail::compact_kernel>(first, n, pred, out->data());
+        } else {
+            // Don't speculatively copy elements which might be expensive to copy
+            T* dest = out->data();
+            for (std::size_t i = 0; i < n; ++i) {
+                if (std::invoke(pred, first[i])) {
+                    dest[count++] = first[i];
+                }
+            }
+        }
+        return out->first(count);
+    }
+};
+
+struct select_if_t {
+    // Writes the positions of the elements of in which satisfy pred, in
+    // increasing order, to the front of out, and returns that prefix. This
+    // is a selection vector, which can be used to filter several arrays of
+    // the same length. out must be at least as long as in.
+    template <typename T, typename Pred, typename I>
+        requires std::unsigned_integral<I> && std::copy_constructible<Pred>
+        && std::predicate<Pred const&, std::remove_const_t<T> const&>
+    auto operator()(pointer<T[]> in, Pred pred, pointer<I[]> out) const -> pointer<I[]>
+    {
+        std::size_t const n = in->size();
+        if (out->size() < n) {
+            TCB_PTR_RUNTIME_ERROR("Output too small in select_if()");
+        }
+        if (n > 0 && n - 1 > std::numeric_limits<I>::max()) {
+            TCB_PTR_RUNTIME_ERROR("Index type too small in select_if()");
+        }
+
+        using E = std::remove_const_t<T>;
+        return out->first(detail::run_kernel<detail::select_kernel>(
+            static_cast<E const*>(in->data()), n, pred, out->data()));
+    }
+};
+
+struct strip_nulls_t {
+    // Copies the engaged optionals in in, in order, to the front of out as
+    // non-null pointers, and returns that prefix. out must be at least as
+    // long as in.
+    //
+    // An optional pointer has the same representation as a pointer, with
+    // the empty state represented by null, so this is just a compaction of
+    // the non-zero words of the input.
+    template <typename U, typename T>
+        requires std::same_as<std::remove_const_t<U>, std::optional<pointer<T>>>
+        && (!std::is_unbounded_array_v<T>)
+    auto operator()(pointer<U[]> in, pointer<pointer<T>[]> out) const -> pointer<pointer<T>[]>
+    {
+        static_assert(sizeof(std::optional<pointer<T>>) == sizeof(std::uintptr_t));
+        static_assert(sizeof(pointer<T>) == sizeof(std::uintptr_t));
+        static_assert(std::is_trivially_copyable_v<std::optional<pointer<T>>>);
+        static_assert(std::is_trivially_copyable_v<pointer<T>>);
+
+        if (out->size() < in->size()) {
+            TCB_PTR_RUNTIME_ERROR("Output too small in strip_nulls()");
+        }
+        return out->first(detail::run_kernel<detail::strip_nulls_kernel>(
+            static_cast<void const*>(in->data()), in->size(), static_cast<void*>(out->data())));
+    }
+};
+
+inline constexpr auto compact_if = compact_if_t{};
+inline constexpr auto select_if = select_if_t{};
+inline constexpr auto strip_nulls = strip_nulls_t{};
+
+} // namespace tcb
+
+#endif
@@ -0,0 +1,187 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_CPU_DISPATCH_HPP_INCLUDED
+#define TCB_CPU_DISPATCH_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdlib> // for std::getenv
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <utility> // for std::declval
+
+// Runtime selection of SIMD kernels.
+//
+// Each kernel is a stateless function object whose body is plain C++ written
+// so that it vectorises well. On x86 with GCC or Clang, the dispatcher
+// instantiates a copy of each kernel for every supported instruction set
+// level (using the target attribute, with everything flattened into it so
+// that the kernel body is compiled for that level), and picks the best one
+// for the running CPU the first time the kernel is called. The chosen
+// function pointer is cached, so subsequent calls cost one indirect call.
+//
+// Elsewhere (including MSVC, and non-x86 targets) only the baseline version
+// exists, compiled for whatever ISA the translation unit targets.
+//
+// Setting the environment variable TCB_PTR_SIMD_LEVEL to "baseline", "avx2"
+// or "avx512" caps the level that will be used, which allows every
+// implementation to be tested on a single machine. Levels which the CPU does
+// not support are never selected.
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#    define TCB_PTR_MULTIVERSIONING 1
+#    define TCB_PTR_TARGET_AVX2 __attribute__((target("avx2,fma,bmi,bmi2,popcnt"), flatten))
+#    define TCB_PTR_TARGET_AVX512                                                                \
+        __attribute__((target("avx512f,avx512bw,avx512vl,avx512dq,avx2,fma,bmi,bmi2,popcnt"), \
+                       flatten))
+#else
+#    define TCB_PTR_MULTIVERSIONING 0
+#endif
+
+namespace tcb {
+
+enum class simd_level { baseline, avx2, avx512 };
+
+namespace detail {
+
+// Assumed by code which lays data out to suit the cache, on every target
+inline constexpr std::size_t cache_line_size = 64;
+
+inline auto parse_simd_level(std::string_view str) -> std::optional<simd_level>
+{
+    if (str == "baseline") {
+        return simd_level::baseline;
+    } else if (str == "avx2") {
+        return simd_level::avx2;
+    } else if (str == "avx512") {
+        return simd_level::avx512;
+    } else {
+        return std::nullopt;
+    }
+}
+
+} // namespace detail
+
+// The best level supported by the running CPU
+inline auto supported_simd_level() -> simd_level
+{
+#if TCB_PTR_MULTIVERSIONING
+    __builtin_cpu_init();
+    bool const avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")
+        && __builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2")
+        && __builtin_cpu_supports("popcnt");
+    bool const avx512 = avx2 && __builtin_cpu_supports("avx512f")
+        && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl")
+        && __builtin_cpu_supports("avx512dq");
+    if (avx512) {
+        return simd_level::avx512;
+    } else if (avx2) {
+        return simd_level::avx2;
+    }
+#endif
+    return simd_level::baseline;
+}
+
+// The level used by dispatched kernels. This is determined once, on first use.
+inline auto active_simd_level() -> simd_level
+{
+    static simd_level const level = [] {
+        simd_level supported = supported_simd_level();
+#if TCB_PTR_MULTIVERSIONING
+        if (char const* env = std::getenv("TCB_PTR_SIMD_LEVEL")) {
+            if (auto requested = detail::parse_simd_level(env)) {
+                return *requested < supported ? *requested : supported;
+            }
+        }
+#endif
+        return supported;
+    }();
+    return level;
+}
+
+namespace detail {
+
+// Kernels which need to know which level they are being compiled for (for
+// example, to decide whether fused multiply-add is cheap) may take a
+// simd_level_constant as their first argument
+template <simd_level Level>
+using simd_level_constant = std::integral_constant<simd_level, Level>;
+
+template <typename F, simd_level Level, typename... Args>
+constexpr auto invoke_kernel(Args... args)
+{
+    if constexpr (std::is_invocable_v<F const&, simd_level_constant<Level>, Args...>) {
+        return F{}(simd_level_constant<Level>{}, args...);
+    } else {
+        return F{}(args...);
+    }
+}
+
+template <typename F, typename... Args>
+using kernel_result_t = decltype(invoke_kernel<F, simd_level::baseline>(std::declval<Args>()...));
+
+template <typename F, typename... Args>
+using kernel_ptr_t = kernel_result_t<F, Args...> (*)(Args...);
+
+template <typename F, typename R, typename... Args>
+auto kernel_baseline(Args... args) -> R
+{
+    return invoke_kernel<F, simd_level::baseline>(args...);
+}
+
+#if TCB_PTR_MULTIVERSIONING
+template <typename F, typename R, typename... Args>
+TCB_PTR_TARGET_AVX2 auto kernel_avx2(Args... args) -> R
+{
+    return invoke_kernel<F, simd_level::avx2>(args...);
+}
+
+template <typename F, typename R, typename... Args>
+TCB_PTR_TARGET_AVX512 auto kernel_avx512(Args... args) -> R
+{
+    return invoke_kernel<F, simd_level::avx512>(args...);
+}
+#endif
+
+// Returns the implementation of the kernel F for the given level, which
+// must be supported by the running CPU
+template <typename F, typename... Args>
+auto kernel_for(simd_level level) -> kernel_ptr_t<F, Args...>
+{
+    using R = kernel_result_t<F, Args...>;
+
+    switch (level) {
+#if TCB_PTR_MULTIVERSIONING
+    case simd_level::avx512: return &kernel_avx512<F, R, Args...>;
+    case simd_level::avx2: return &kernel_avx2<F, R, Args...>;
+#endif
+    default: return &kernel_baseline<F, R, Args...>;
+    }
+}
+
+template <typename F, typename... Args>
+auto dispatch_kernel(Args... args) -> kernel_result_t<F, Args...>
+{
+    static kernel_ptr_t<F, Args...> const fn = kernel_for<F, Args...>(active_simd_level());
+    return fn(args...);
+}
+
+// Runs the kernel F, dispatching to the best implementation at run time,
+// or directly during constant evaluation
+template <typename F, typename... Args>
+constexpr auto run_kernel(Args... args) -> kernel_result_t<F, Args...>
+{
+    if (std::is_constant_evaluated()) {
+        return invoke_kernel<F, simd_level::baseline>(args...);
+    } else {
+        return dispatch_kernel<F>(args...);
+    }
+}
+
+} // namespace detail
+
+} // namespace tcb
+
+#endif
@@ -0,0 +1,216 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_DIRECT_IO_HPP_INCLUDED
+#define TCB_DIRECT_IO_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // for std::memset
+#include <memory> // for std::unique_ptr
+#include <new> // for std::align_val_t
+#include <type_traits>
+
+#if __has_include(<unistd.h>)
+#    include <cerrno>
+#    include <system_error>
+#    include <unistd.h>
+#    define TCB_PTR_HAVE_PREAD 1
+#else
+#    define TCB_PTR_HAVE_PREAD 0
+#endif
+
+// Helpers for direct I/O (O_DIRECT on Linux), which bypasses the page cache
+// but requires the buffer address, the file offset and the length of every
+// read and write to be multiples of the device's logical block size.
+// Getting this wrong only shows up as EINVAL at runtime, so these helpers
+// check it up front.
+
+namespace tcb {
+
+// A block size which satisfies direct I/O on almost every device: logical
+// blocks are 512 bytes or 4 KiB
+inline constexpr std::size_t direct_io_alignment = 4096;
+
+namespace detail {
+
+inline auto is_power_of_two(std::size_t n) -> bool { return n != 0 && (n & (n - 1)) == 0; }
+
+inline auto is_block_aligned(void const* addr, std::size_t size, std::size_t block) -> bool
+{
+    return reinterpret_cast<std::uintptr_t>(addr) % block == 0 && size % block == 0;
+}
+
+} // namespace detail
+
+// An owning, zero-initialised byte buffer whose address and size are both
+// multiples of a block size
+class aligned_buffer {
+private:
+    struct aligned_delete {
+        std::size_t alignment;
+
+        void operator()(std::byte* ptr) const
+        {
+            ::operator delete(ptr, std::align_val_t{alignment});
+        }
+    };
+
+    std::unique_ptr<std::byte[], aligned_delete> data_;
+    std::size_t size_;
+
+    static auto allocate(std::size_t size, std::size_t alignment)
+        -> std::unique_ptr<std::byte[], aligned_delete>
+    {
+        if (!detail::is_power_of_two(alignment)) {
+            TCB_PTR_RUNTIME_ERROR("Invalid alignment passed to aligned_buffer()");
+        }
+        if (size == 0 || size % alignment != 0) {
+            TCB_PTR_RUNTIME_ERROR("Invalid size passed to aligned_buffer()");
+        }
+        auto* const ptr
+            = static_cast<std::byte*>(::operator new(size, std::align_val_t{alignment}));
+        std::memset(ptr, 0, size);
+        return {ptr, aligned_delete{alignment}};
+    }
+
+public:
+    // size must be a non-zero multiple of alignment, which must be a power of
+    // two
+    explicit aligned_buffer(std::size_t size, std::size_t alignment = direct_io_alignment)
+        : data_(allocate(size, alignment)), size_(size)
+    {
+    }
+
+    auto size() const -> std::size_t { return size_; }
+
+    auto alignment() const -> std::size_t { return data_.get_deleter().alignment; }
+
+    // The whole buffer. Using this after the buffer has been moved from is an
+    // error.
+    auto get() const -> pointer<std::byte[]>
+    {
+        return pointer<std::byte[]>::from_address_with_size(data_.get(), size_);
+    }
+};
+
+struct aligned_subslice_t {
+    // The smallest subslice of buf which covers the bytes [offset, offset +
+    // length) and whose start and end are on block boundaries, relative to
+    // the start of buf. buf itself must be block-aligned.
+    template <typename B>
+        requires std::same_as<std::remove_const_t<B>, std::byte>
+    auto operator()(pointer<B[]> buf, std::size_t offset, std::size_t length,
+                    std::size_t block = direct_io_alignment) const -> pointer<B[]>
+    {
+        if (!detail::is_power_of_two(block)) {
+            TCB_PTR_RUNTIME_ERROR("Invalid block size passed to aligned_subslice()");
+        }
+        if (!detail::is_block_aligned(buf->data(), buf->size(), block)) {
+            TCB_PTR_RUNTIME_ERROR("Misaligned buffer passed to aligned_subslice()");
+        }
+        if (offset > buf->size() || length > buf->size() - offset) {
+            TCB_PTR_RUNTIME_ERROR("Range out of bounds in aligned_subslice()");
+        }
+        std::size_t const first = offset & ~(block - 1);
+        std::size_t const last = (offset + length + block - 1) & ~(block - 1);
+        return buf->subslice(first, last - first);
+    }
+};
+
+inline constexpr auto aligned_subslice = aligned_subslice_t{};
+
+#if TCB_PTR_HAVE_PREAD
+
+struct pread_aligned_t {
+    // Reads buf->size() bytes from fd starting at offset, retrying short
+    // reads, and returns the number read, which is less than requested only
+    // at the end of the file. buf's address and size, and offset, must be
+    // multiples of block.
+    auto operator()(int fd, pointer<std::byte[]> buf, std::uint64_t offset,
+                    std::size_t block = direct_io_alignment) const -> std::size_t
+    {
+        if (!detail::is_power_of_two(block)) {
+            TCB_PTR_RUNTIME_ERROR("Invalid block size passed to pread_aligned()");
+        }
+        if (!detail::is_block_aligned(buf->data(), buf->size(), block) || offset % block != 0) {
+            TCB_PTR_RUNTIME_ERROR("Misaligned buffer or offset passed to pread_aligned()");
+        }
+
+        std::byte* const first = buf->data();
+        std::size_t done = 0;
+        while (done < buf->size()) {
+            ::ssize_t const n = ::pread(fd, first + done, buf->size() - done,
+                                        static_cast<::off_t>(offset + done));
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                TCB_PTR_THROW(std::system_error(errno, std::generic_category(), "pread"));
+            }
+            done += static_cast<std::size_t>(n);
+            // A short read which isn't a whole number of blocks (or reads
+            // nothing) means we hit the end of the file, and we couldn't
+            // continue from a misaligned offset anyway
+            if (n == 0 || static_cast<std::size_t>(n) % block != 0) {
+                break;
+            }
+        }
+        return done;
+    }
+};
+
+inline constexpr auto pread_aligned = pread_aligned_t{};
+
+struct pwrite_aligned_t {
+    // Writes all of buf to fd starting at offset, retrying short writes of
+    // whole blocks. buf's address and size, and offset, must be multiples of
+    // block. A write of nothing, or of part of a block, which would leave
+    // the rest to be written from a misaligned offset, throws.
+    template <typename B>
+        requires std::same_as<std::remove_const_t<B>, std::byte>
+    void operator()(int fd, pointer<B[]> buf, std::uint64_t offset,
+                    std::size_t block = direct_io_alignment) const
+    {
+        if (!detail::is_power_of_two(block)) {
+            TCB_PTR_RUNTIME_ERROR("Invalid block size passed to pwrite_aligned()");
+        }
+        if (!detail::is_block_aligned(buf->data(), buf->size(), block) || offset % block != 0) {
+            TCB_PTR_RUNTIME_ERROR("Misaligned buffer or offset passed to pwrite_aligned()");
+        }
+
+        std::byte const* const first = buf->data();
+        std::size_t done = 0;
+        while (done < buf->size()) {
+            ::ssize_t const n = ::pwrite(fd, first + done, buf->size() - done,
+                                         static_cast<::off_t>(offset + done));
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                TCB_PTR_THROW(std::system_error(errno, std::generic_category(), "pwrite"));
+            }
+            if (n == 0) {
+                TCB_PTR_THROW(
+                    std::system_error(EIO, std::generic_category(), "pwrite wrote nothing"));
+            }
+            if (static_cast<std::size_t>(n) % block != 0) {
+                TCB_PTR_THROW(std::system_error(EIO, std::generic_category(),
+                                                "pwrite wrote part of a block"));
+            }
+            done += static_cast<std::size_t>(n);
+        }
+    }
+};
+
+inline constexpr auto pwrite_aligned = pwrite_aligned_t{};
+
+#endif // TCB_PTR_HAVE_PREAD
+
+} // namespace tcb
+
+#endif
@@ -0,0 +1,108 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_HISTOGRAM_HPP_INCLUDED
+#define TCB_HISTOGRAM_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+#include <tcb/cpu_dispatch.hpp> // for detail::cache_line_size
+#include <tcb/parallel.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <functional> // for std::invoke
+#include <type_traits>
+#include <vector>
+
+namespace tcb {
+
+namespace detail {
+
+template <typename F, typename T>
+concept bin_fn = std::invocable<F const&, T const&>
+    && std::integral<std::remove_cvref_t<std::invoke_result_t<F const&, T const&>>>;
+
+template <typename T, typename BinFn, typename C>
+void count_bins(T const* in, std::size_t n, BinFn const& bin_fn, C* counts, std::size_t bins)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        auto const bin = static_cast<std::size_t>(std::invoke(bin_fn, in[i]));
+        if (bin >= bins) {
+            TCB_PTR_RUNTIME_ERROR("Bin out of bounds in histogram()");
+        }
+        ++counts[bin];
+    }
+}
+
+} // namespace detail
+
+struct histogram_t {
+private:
+    // Each parallel task handles at least this many elements
+    static constexpr std::size_t min_grain = 1 << 16;
+
+public:
+    // Adds one to counts[bin_fn(elem)] for each element of in. Counts are
+    // accumulated, rather than overwritten, so that a histogram can be
+    // built up from several inputs. If an element's bin is out of bounds,
+    // the counts up to that element will have been updated.
+    template <typename T, typename BinFn, typename C>
+        requires std::unsigned_integral<C> && detail::bin_fn<BinFn, std::remove_const_t<T>>
+    void operator()(pointer<T[]> in, BinFn const& bin_fn, pointer<C[]> counts) const
+    {
+        detail::count_bins(static_cast<T const*>(in->data()), in->size(), bin_fn, counts->data(),
+                           counts->size());
+    }
+
+    // Parallel version. Rather than sharing the counters (which would need
+    // atomic increments, and suffer badly from contention when many elements
+    // fall in the same bin), each task counts its chunk of the input into a
+    // private histogram, and the private histograms are summed at the end.
+    // If any element's bin is out of bounds, counts is not modified.
+    template <typename T, typename BinFn, typename C>
+        requires std::unsigned_integral<C> && detail::bin_fn<BinFn, std::remove_const_t<T>>
+    void operator()(parallel_t policy, pointer<T[]> in, BinFn const& bin_fn,
+                    pointer<C[]> counts) const
+    {
+        T const* first = in->data();
+        std::size_t const n = in->size();
+        std::size_t const bins = counts->size();
+        std::size_t const tasks = detail::task_count(policy, n, min_grain);
+
+        // The private histograms are separated by a cache line of padding,
+        // so that tasks never write to the same line
+        constexpr std::size_t per_line = detail::cache_line_size / sizeof(C);
+        std::size_t const stride = bins + per_line;
+        std::vector<C> local(tasks * stride);
+
+        auto chunk_begin = [&](std::size_t task) { return n / tasks * task; };
+        auto chunk_end = [&](std::size_t task) {
+            return task + 1 == tasks ? n : chunk_begin(task + 1);
+        };
+        detail::parallel_for(tasks, [&](std::size_t t) {
+            detail::count_bins(first + chunk_begin(t), chunk_end(t) - chunk_begin(t), bin_fn,
+                               local.data() + t * stride, bins);
+        });
+
+        // Merge, with each task summing a range of bins
+        C* dest = counts->data();
+        std::size_t const merge_tasks = detail::task_count(policy, bins * tasks, min_grain);
+        detail::parallel_for(merge_tasks, [&](std::size_t m) {
+            std::size_t const begin = bins / merge_tasks * m;
+            std::size_t const end = m + 1 == merge_tasks ? bins : bins / merge_tasks * (m + 1);
+            for (std::size_t t = 0; t < tasks; ++t) {
+                C const* row = local.data() + t * stride;
+                for (std::size_t b = begin; b < end; ++b) {
+                    dest[b] = static_cast<C>(dest[b] + row[b]);
+                }
+            }
+        });
+    }
+};
+
+inline constexpr auto histogram = histogram_t{};
+
+} // namespace tcb
+
+#endif
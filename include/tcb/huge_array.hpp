@@ -0,0 +1,303 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_HUGE_ARRAY_HPP_INCLUDED
+#define TCB_HUGE_ARRAY_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // for std::memset
+#include <new> // for std::bad_alloc
+#include <type_traits>
+#include <utility> // for std::exchange
+
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>)
+#    include <sys/mman.h>
+#    include <unistd.h>
+#    define TCB_PTR_HAVE_MMAP 1
+#else
+#    define TCB_PTR_HAVE_MMAP 0
+#endif
+
+#if defined(__linux__)
+#    include <fstream>
+#    include <string>
+#endif
+
+namespace tcb {
+
+// The kind of pages backing a huge_array
+enum class page_kind {
+    // The system's normal page size, usually 4 KiB
+    normal,
+    // Transparent huge pages: an ordinary mapping, aligned to the huge page
+    // size, which the kernel has been advised to back with huge pages. It
+    // does so when the pages are first touched, if it can find the memory
+    // (and khugepaged may collapse the range into huge pages later if not);
+    // the AnonHugePages lines in /proc/self/smaps show how much it managed.
+    transparent_huge,
+    // Huge pages reserved from the kernel's hugetlb pool, which are
+    // guaranteed to be huge but must have been set aside by the
+    // administrator (see /proc/sys/vm/nr_hugepages)
+    huge,
+};
+
+namespace detail {
+
+#if defined(__linux__)
+// Reads "<key> <value>" from a file like /proc/meminfo, or returns fallback
+inline auto read_proc_value(char const* path, std::string const& key, std::size_t fallback)
+    -> std::size_t
+{
+    std::ifstream file(path);
+    std::string word;
+    while (file >> word) {
+        if (word == key) {
+            std::size_t value = 0;
+            if (file >> value) {
+                return value;
+            }
+            break;
+        }
+    }
+    return fallback;
+}
+#endif
+
+inline auto system_page_size() -> std::size_t
+{
+#if TCB_PTR_HAVE_MMAP
+    static std::size_t const size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+#else
+    return 4096;
+#endif
+}
+
+// The size of the pages which MAP_HUGETLB gives us
+inline auto hugetlb_page_size() -> std::size_t
+{
+#if defined(__linux__)
+    static std::size_t const size
+        = read_proc_value("/proc/meminfo", "Hugepagesize:", 2048) * 1024;
+    return size;
+#else
+    return 0;
+#endif
+}
+
+// The size of transparent huge pages, or zero if they are disabled
+inline auto thp_page_size() -> std::size_t
+{
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    static std::size_t const size = []() -> std::size_t {
+        std::ifstream enabled("/sys/kernel/mm/transparent_hugepage/enabled");
+        std::string setting;
+        std::getline(enabled, setting);
+        if (!enabled || setting.find("[never]") != std::string::npos) {
+            return 0;
+        }
+        std::ifstream pmd_size("/sys/kernel/mm/transparent_hugepage/hpage_pmd_size");
+        std::size_t bytes = 0;
+        pmd_size >> bytes;
+        return pmd_size ? bytes : 2 * 1024 * 1024;
+    }();
+    return size;
+#else
+    return 0;
+#endif
+}
+
+inline auto round_up(std::size_t n, std::size_t multiple) -> std::size_t
+{
+    return (n + multiple - 1) / multiple * multiple;
+}
+
+} // namespace detail
+
+// An owning array of trivial objects in memory mapped directly from the OS,
+// preferably backed by huge pages, for large tables which are accessed
+// randomly and so would otherwise miss the TLB on nearly every access.
+//
+// Asking for page_kind::huge tries the hugetlb pool first, then falls back
+// to transparent huge pages, then to normal pages; asking for
+// transparent_huge skips the first step. Asking for normal pages turns
+// transparent huge pages off for the mapping, so that the two can be
+// compared. The elements start out zeroed.
+template <typename T>
+    requires std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>
+class huge_array {
+private:
+    T* addr_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t mapped_bytes_ = 0;
+    std::size_t page_size_ = 0;
+    page_kind kind_ = page_kind::normal;
+
+#if TCB_PTR_HAVE_MMAP
+    static auto map(std::size_t bytes, int extra_flags) -> void*
+    {
+        void* const addr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                                  MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+        return addr == MAP_FAILED ? nullptr : addr;
+    }
+
+    auto try_hugetlb(std::size_t bytes) -> bool
+    {
+#    if defined(MAP_HUGETLB)
+        std::size_t const page = detail::hugetlb_page_size();
+        std::size_t const len = detail::round_up(bytes, page);
+        if (void* const addr = map(len, MAP_HUGETLB)) {
+            set(addr, len, page, page_kind::huge);
+            return true;
+        }
+#    else
+        (void)bytes;
+#    endif
+        return false;
+    }
+
+    auto try_thp(std::size_t bytes) -> bool
+    {
+#    if defined(MADV_HUGEPAGE)
+        std::size_t const page = detail::thp_page_size();
+        if (page == 0) {
+            return false;
+        }
+        // The kernel only uses huge pages for aligned ranges, so map an extra
+        // page's worth and trim both ends
+        std::size_t const len = detail::round_up(bytes, page);
+        auto* const raw = static_cast<unsigned char*>(map(len + page, 0));
+        if (!raw) {
+            return false;
+        }
+        auto const raw_bits = reinterpret_cast<std::uintptr_t>(raw);
+        auto* const aligned = raw + (detail::round_up(raw_bits, page) - raw_bits);
+        std::size_t const head = static_cast<std::size_t>(aligned - raw);
+        if (head > 0) {
+            ::munmap(raw, head);
+        }
+        ::munmap(aligned + len, page - head);
+        if (::madvise(aligned, len, MADV_HUGEPAGE) != 0) {
+            ::munmap(aligned, len);
+            return false;
+        }
+        set(aligned, len, page, page_kind::transparent_huge);
+        return true;
+#    else
+        (void)bytes;
+        return false;
+#    endif
+    }
+
+    void map_normal(std::size_t bytes)
+    {
+        std::size_t const page = detail::system_page_size();
+        std::size_t const len = detail::round_up(bytes, page);
+        void* const addr = map(len, 0);
+        if (!addr) {
+            TCB_PTR_THROW(std::bad_alloc());
+        }
+#    if defined(MADV_NOHUGEPAGE)
+        // Doesn't matter if this fails: there are no huge pages to turn off
+        (void)::madvise(addr, len, MADV_NOHUGEPAGE);
+#    endif
+        set(addr, len, page, page_kind::normal);
+    }
+#endif
+
+    void set(void* addr, std::size_t mapped_bytes, std::size_t page_size, page_kind kind)
+    {
+        addr_ = static_cast<T*>(addr);
+        mapped_bytes_ = mapped_bytes;
+        page_size_ = page_size;
+        kind_ = kind;
+    }
+
+    void release() noexcept
+    {
+        if (addr_) {
+#if TCB_PTR_HAVE_MMAP
+            ::munmap(addr_, mapped_bytes_);
+#else
+            ::operator delete(addr_, std::align_val_t{page_size_});
+#endif
+            addr_ = nullptr;
+        }
+    }
+
+public:
+    // Allocates an array of size zeroed elements, backed by request pages
+    // or the best available fallback
+    explicit huge_array(std::size_t size, page_kind request = page_kind::huge) : size_(size)
+    {
+        if (size == 0) {
+            TCB_PTR_RUNTIME_ERROR("Zero size passed to huge_array()");
+        }
+        if (size > SIZE_MAX / sizeof(T)) {
+            TCB_PTR_RUNTIME_ERROR("Size too large in huge_array()");
+        }
+        std::size_t const bytes = size * sizeof(T);
+
+#if TCB_PTR_HAVE_MMAP
+        bool done = request == page_kind::huge && try_hugetlb(bytes);
+        if (!done && request != page_kind::normal) {
+            done = try_thp(bytes);
+        }
+        if (!done) {
+            map_normal(bytes);
+        }
+#else
+        (void)request;
+        std::size_t const page = detail::system_page_size();
+        void* const addr = ::operator new(bytes, std::align_val_t{page});
+        std::memset(addr, 0, bytes);
+        set(addr, bytes, page, page_kind::normal);
+#endif
+    }
+
+    huge_array(huge_array&& other) noexcept
+        : addr_(std::exchange(other.addr_, nullptr)),
+          size_(std::exchange(other.size_, 0)),
+          mapped_bytes_(other.mapped_bytes_),
+          page_size_(other.page_size_),
+          kind_(other.kind_)
+    {
+    }
+
+    auto operator=(huge_array&& other) noexcept -> huge_array&
+    {
+        if (this != &other) {
+            release();
+            addr_ = std::exchange(other.addr_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            mapped_bytes_ = other.mapped_bytes_;
+            page_size_ = other.page_size_;
+            kind_ = other.kind_;
+        }
+        return *this;
+    }
+
+    ~huge_array() { release(); }
+
+    // The elements. Using this after the array has been moved from is an
+    // error.
+    auto get() const -> pointer<T[]> { return pointer<T[]>::from_address_with_size(addr_, size_); }
+
+    auto size() const -> std::size_t { return size_; }
+
+    // The kind of pages we got, which may be a fallback from the kind asked
+    // for
+    auto pages() const -> page_kind { return kind_; }
+
+    // The size in bytes of the pages we got. The array starts on a page
+    // boundary.
+    auto page_size() const -> std::size_t { return page_size_; }
+};
+
+} // namespace tcb
+
+#endif
@@ -0,0 +1,282 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_INTERN_HPP_INCLUDED
+#define TCB_INTERN_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+#include <tcb/cpu_dispatch.hpp> // for detail::cache_line_size
+#include <tcb/parallel.hpp>
+
+#include <bit> // for std::rotl, std::bit_ceil, std::countr_zero
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // for std::memcpy, std::memcmp
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+// Interning: storing one copy of each distinct string, so that equal strings
+// are represented by the same pointer.
+//
+// intern_table::intern() returns the canonical pointer<T const[]> for the
+// contents of a slice, copying them into the table's arena the first time
+// they are seen. Two interned slices are equal exactly when they are the
+// same pointer, so they compare with pointer<T[]>::operator== (address and
+// size) in constant time, and can be hashed by std::hash<pointer<T[]>>.
+//
+// The table is split into shards, each an open-addressed hash table with its
+// own mutex and arena, chosen by the top bits of the content hash. Threads
+// interning different strings rarely wait for each other.
+
+namespace tcb {
+
+namespace detail {
+
+// Element types whose values are equal exactly when their bytes are
+template <typename T>
+concept internable = std::is_trivially_copyable_v<T>
+    && std::has_unique_object_representations_v<T> && std::default_initializable<T>;
+
+inline constexpr std::uint64_t hash_multiplier = 0x9E3779B97F4A7C15;
+
+// A 64-bit hash of size bytes, a word at a time
+inline auto hash_bytes(void const* data, std::size_t size) noexcept -> std::uint64_t
+{
+    auto const* bytes = static_cast<unsigned char const*>(data);
+    std::uint64_t h = size * hash_multiplier;
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes + i, 8);
+        h = std::rotl((h ^ word) * hash_multiplier, 29);
+    }
+    if (i < size) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, bytes + i, size - i);
+        h = std::rotl((h ^ word) * hash_multiplier, 29);
+    }
+    // The finaliser of MurmurHash3, so that the top bits, which choose the
+    // shard, depend on all of the input
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCD;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53;
+    h ^= h >> 33;
+    return h;
+}
+
+} // namespace detail
+
+struct content_hash_t {
+    // A hash of the contents of a slice, rather than of its address as
+    // std::hash<pointer<T[]>> is. Equal contents have equal hashes.
+    template <detail::internable T>
+    auto operator()(pointer<T const[]> const& slice) const noexcept -> std::uint64_t
+    {
+        return detail::hash_bytes(slice->data(), slice->size() * sizeof(T));
+    }
+};
+
+inline constexpr auto content_hash = content_hash_t{};
+
+template <detail::internable T>
+class intern_table {
+private:
+    static constexpr std::size_t default_shards = 64;
+    static constexpr std::size_t min_slots = 16;
+    // Each arena chunk holds this many bytes; longer strings get a chunk of
+    // their own
+    static constexpr std::size_t chunk_bytes = 64 * 1024;
+    static constexpr std::size_t chunk_size = chunk_bytes / sizeof(T) > 0 ? chunk_bytes / sizeof(T)
+                                                                          : 1;
+    static constexpr std::size_t min_grain = 1 << 14;
+
+    struct slot {
+        std::uint64_t hash;
+        // Null when the slot is empty
+        T const* data;
+        std::size_t size;
+    };
+
+    struct alignas(detail::cache_line_size) shard {
+        std::mutex mutex;
+        // The number of slots is zero or a power of two, at least twice
+        // count
+        std::vector<slot> slots;
+        std::size_t count = 0;
+        std::vector<std::unique_ptr<T[]>> chunks;
+        T* free = nullptr;
+        std::size_t free_size = 0;
+        std::size_t stored = 0;
+    };
+
+    std::unique_ptr<shard[]> shards_;
+    unsigned shard_bits_;
+
+    auto shard_for(std::uint64_t hash) const -> shard&
+    {
+        return shards_[shard_bits_ == 0 ? 0 : hash >> (64 - shard_bits_)];
+    }
+
+    static auto lookup(shard const& sh, std::uint64_t hash, T const* data, std::size_t size)
+        -> slot const*
+    {
+        if (sh.slots.empty()) {
+            return nullptr;
+        }
+        std::size_t const mask = sh.slots.size() - 1;
+        for (std::size_t i = hash & mask;; i = (i + 1) & mask) {
+            slot const& s = sh.slots[i];
+            if (s.data == nullptr) {
+                return nullptr;
+            }
+            if (s.hash == hash && s.size == size
+                && (size == 0 || std::memcmp(s.data, data, size * sizeof(T)) == 0)) {
+                return &s;
+            }
+        }
+    }
+
+    static void place(std::vector<slot>& slots, slot const& s)
+    {
+        std::size_t const mask = slots.size() - 1;
+        std::size_t i = s.hash & mask;
+        while (slots[i].data != nullptr) {
+            i = (i + 1) & mask;
+        }
+        slots[i] = s;
+    }
+
+    static void grow(shard& sh)
+    {
+        std::vector<slot> slots(sh.slots.empty() ? min_slots : sh.slots.size() * 2);
+        for (slot const& s : sh.slots) {
+            if (s.data != nullptr) {
+                place(slots, s);
+            }
+        }
+        sh.slots = std::move(slots);
+    }
+
+    // Copies size elements into the shard's arena. Empty strings take one
+    // element too, so that they have an address of their own.
+    static auto store(shard& sh, T const* data, std::size_t size) -> T const*
+    {
+        std::size_t const needed = size > 0 ? size : 1;
+        T* dest;
+        if (needed > chunk_size / 4) {
+            dest = sh.chunks.emplace_back(std::make_unique_for_overwrite<T[]>(needed)).get();
+        } else {
+            if (needed > sh.free_size) {
+                sh.free = sh.chunks.emplace_back(std::make_unique_for_overwrite<T[]>(chunk_size))
+                              .get();
+                sh.free_size = chunk_size;
+            }
+            dest = sh.free;
+            sh.free += needed;
+            sh.free_size -= needed;
+        }
+        if (size > 0) {
+            std::memcpy(dest, data, size * sizeof(T));
+        }
+        sh.stored += size;
+        return dest;
+    }
+
+public:
+    // The number of shards is rounded up to a power of two
+    explicit intern_table(std::size_t shards = default_shards)
+    {
+        if (shards == 0) {
+            TCB_PTR_RUNTIME_ERROR("An intern_table needs at least one shard");
+        }
+        shards = std::bit_ceil(shards);
+        shard_bits_ = static_cast<unsigned>(std::countr_zero(shards));
+        shards_ = std::make_unique<shard[]>(shards);
+    }
+
+    // The canonical pointer to a copy of slice's contents, which stays valid
+    // for the lifetime of the table. Safe to call from several threads at
+    // once.
+    auto intern(pointer<T const[]> const& slice) -> pointer<T const[]>
+    {
+        T const* const data = slice->data();
+        std::size_t const size = slice->size();
+        std::uint64_t const hash = detail::hash_bytes(data, size * sizeof(T));
+        shard& sh = shard_for(hash);
+
+        std::lock_guard lock(sh.mutex);
+        if (slot const* found = lookup(sh, hash, data, size)) {
+            return pointer<T const[]>::from_address_with_size(found->data, found->size);
+        }
+        if (2 * (sh.count + 1) > sh.slots.size()) {
+            grow(sh);
+        }
+        slot const s{hash, store(sh, data, size), size};
+        place(sh.slots, s);
+        ++sh.count;
+        return pointer<T const[]>::from_address_with_size(s.data, s.size);
+    }
+
+    // Replaces each slice in slices with its canonical pointer, using
+    // several threads
+    void intern(parallel_t policy, pointer<pointer<T const[]>[]> slices)
+    {
+        pointer<T const[]>* const first = slices->data();
+        std::size_t const n = slices->size();
+        std::size_t const tasks = detail::task_count(policy, n, min_grain);
+        detail::parallel_for(tasks, [&](std::size_t t) {
+            std::size_t const end = t + 1 == tasks ? n : n / tasks * (t + 1);
+            for (std::size_t i = n / tasks * t; i < end; ++i) {
+                first[i] = intern(first[i]);
+            }
+        });
+    }
+
+    // The canonical pointer for slice's contents, if they have been interned
+    auto find(pointer<T const[]> const& slice) const -> std::optional<pointer<T const[]>>
+    {
+        T const* const data = slice->data();
+        std::size_t const size = slice->size();
+        std::uint64_t const hash = detail::hash_bytes(data, size * sizeof(T));
+        shard& sh = shard_for(hash);
+
+        std::lock_guard lock(sh.mutex);
+        if (slot const* found = lookup(sh, hash, data, size)) {
+            return pointer<T const[]>::from_address_with_size(found->data, found->size);
+        }
+        return std::nullopt;
+    }
+
+    // The number of distinct slices interned
+    auto size() const -> std::size_t
+    {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < (std::size_t{1} << shard_bits_); ++i) {
+            std::lock_guard lock(shards_[i].mutex);
+            total += shards_[i].count;
+        }
+        return total;
+    }
+
+    // The total number of elements of the distinct slices, which the arenas
+    // hold one copy of
+    auto stored_size() const -> std::size_t
+    {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < (std::size_t{1} << shard_bits_); ++i) {
+            std::lock_guard lock(shards_[i].mutex);
+            total += shards_[i].stored;
+        }
+        return total;
+    }
+};
+
+} // namespace tcb
+
+#endif
@@ -0,0 +1,150 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_INTEROP_HPP_INCLUDED
+#define TCB_INTEROP_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+#if __has_include(<mdspan>)
+#    include <mdspan>
+#endif
+
+// Conversions between array pointers and the standard views, std::span,
+// std::basic_string_view and (where the library has it) std::mdspan.
+//
+// Each one checks only what the destination needs and the source doesn't
+// already guarantee. Views of a pointer check nothing, except that a
+// static extent or an mdspan's extents match its size. Pointers to a
+// view's elements check that they aren't null, which a default-constructed
+// view's are, unless the view has a fixed, non-zero extent. Otherwise the
+// conversions just copy the address and size, and compile to nothing.
+
+namespace tcb {
+
+namespace detail {
+
+template <typename C>
+concept interop_char = std::same_as<C, char> || std::same_as<C, wchar_t>
+    || std::same_as<C, char8_t> || std::same_as<C, char16_t> || std::same_as<C, char32_t>;
+
+} // namespace detail
+
+struct to_span_t {
+    template <typename T>
+    constexpr auto operator()(pointer<T[]> const& ptr) const noexcept -> std::span<T>
+    {
+        return std::span<T>(ptr->data(), ptr->size());
+    }
+};
+
+// A span of exactly Extent elements, which must be the pointer's size
+template <std::size_t Extent>
+    requires(Extent != std::dynamic_extent)
+struct to_static_span_t {
+    template <typename T>
+    constexpr auto operator()(pointer<T[]> const& ptr) const -> std::span<T, Extent>
+    {
+        if (ptr->size() != Extent) {
+            TCB_PTR_RUNTIME_ERROR("Pointer of the wrong size passed to to_static_span()");
+        }
+        return std::span<T, Extent>(ptr->data(), Extent);
+    }
+};
+
+struct from_span_t {
+    template <typename T, std::size_t Extent>
+    constexpr auto operator()(std::span<T, Extent> span) const -> pointer<T[]>
+    {
+        if constexpr (Extent != std::dynamic_extent && Extent != 0) {
+            // A span of a fixed number of elements always points at them
+            return pointer<T[]>::pointer_to(span);
+        } else {
+            return pointer<T[]>::from_address_with_size(span.data(), span.size());
+        }
+    }
+};
+
+struct to_string_view_t {
+    template <typename T>
+        requires detail::interop_char<std::remove_const_t<T>>
+    constexpr auto operator()(pointer<T[]> const& ptr) const noexcept
+        -> std::basic_string_view<std::remove_const_t<T>>
+    {
+        return std::basic_string_view<std::remove_const_t<T>>(ptr->data(), ptr->size());
+    }
+};
+
+struct from_string_view_t {
+    template <typename CharT, typename Traits>
+    constexpr auto operator()(std::basic_string_view<CharT, Traits> str) const
+        -> pointer<CharT const[]>
+    {
+        return pointer<CharT const[]>::from_address_with_size(str.data(), str.size());
+    }
+};
+
+inline constexpr auto to_span = to_span_t{};
+
+template <std::size_t Extent>
+inline constexpr auto to_static_span = to_static_span_t<Extent>{};
+
+inline constexpr auto from_span = from_span_t{};
+inline constexpr auto to_string_view = to_string_view_t{};
+inline constexpr auto from_string_view = from_string_view_t{};
+
+#ifdef __cpp_lib_mdspan
+
+struct to_mdspan_t {
+    // A row-major view of the pointer's elements, which must number exactly
+    // the product of the extents
+    template <typename T, typename IndexType, std::size_t... Extents>
+    constexpr auto operator()(pointer<T[]> const& ptr,
+                              std::extents<IndexType, Extents...> const& extents) const
+        -> std::mdspan<T, std::extents<IndexType, Extents...>>
+    {
+        std::layout_right::mapping<std::extents<IndexType, Extents...>> const mapping(extents);
+        if (static_cast<std::size_t>(mapping.required_span_size()) != ptr->size()) {
+            TCB_PTR_RUNTIME_ERROR("Extents not matching the size passed to to_mdspan()");
+        }
+        return std::mdspan<T, std::extents<IndexType, Extents...>>(ptr->data(), mapping);
+    }
+
+    // As above, with dynamic extents
+    template <typename T, std::integral... Sizes>
+    constexpr auto operator()(pointer<T[]> const& ptr, Sizes... sizes) const
+        -> std::mdspan<T, std::dextents<std::size_t, sizeof...(Sizes)>>
+    {
+        return (*this)(ptr,
+                       std::dextents<std::size_t, sizeof...(Sizes)>(
+                           static_cast<std::size_t>(sizes)...));
+    }
+};
+
+struct from_mdspan_t {
+    // Every element the mdspan can reach, which for strided layouts may
+    // include elements between those it views
+    template <typename T, typename Extents, typename Layout>
+    constexpr auto operator()(std::mdspan<T, Extents, Layout, std::default_accessor<T>> const& md)
+        const -> pointer<T[]>
+    {
+        return pointer<T[]>::from_address_with_size(
+            md.data_handle(), static_cast<std::size_t>(md.mapping().required_span_size()));
+    }
+};
+
+inline constexpr auto to_mdspan = to_mdspan_t{};
+inline constexpr auto from_mdspan = from_mdspan_t{};
+
+#endif // __cpp_lib_mdspan
+
+} // namespace tcb
+
+#endif
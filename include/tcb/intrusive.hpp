@@ -0,0 +1,975 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_INTRUSIVE_HPP_INCLUDED
+#define TCB_INTRUSIVE_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional> // for std::invoke, std::identity, std::ranges::less
+#include <iterator>
+#include <optional>
+#include <type_traits>
+
+// Intrusive containers: rather than allocating a node for each element, the
+// containers link elements together through a hook which is a member of the
+// element type. An element can be in several containers at once by having
+// several hooks. The containers never own their elements: it is up to the
+// user to make sure that an element outlives its membership of a container.
+//
+// Links are std::optional<pointer<T>>, which is the same size as a raw
+// pointer. Iterating over a container yields pointer<T>s.
+//
+// Copying an element doesn't copy its links: a copied hook starts out
+// unlinked, and assigning to a hook leaves it unchanged.
+
+namespace tcb {
+
+namespace detail {
+
+template <typename T>
+using link = std::optional<pointer<T>>;
+
+template <typename T>
+auto link_address(link<T> const& l) -> T*
+{
+    return l ? l->to_address() : nullptr;
+}
+
+template <typename T>
+auto make_link(T* addr) -> link<T>
+{
+    return addr ? link<T>(pointer<T>::from_address(addr)) : std::nullopt;
+}
+
+// An iterator over an intrusive container, which asks the container how to
+// move between elements
+template <typename Container, typename T>
+class intrusive_iterator {
+private:
+    Container const* cont_ = nullptr;
+    T* node_ = nullptr;
+
+public:
+    using value_type = pointer<T>;
+    using difference_type = std::ptrdiff_t;
+    using iterator_concept
+        = std::conditional_t<Container::is_bidirectional, std::bidirectional_iterator_tag,
+                             std::forward_iterator_tag>;
+
+    intrusive_iterator() = default;
+
+    intrusive_iterator(Container const& cont, T* node) : cont_(&cont), node_(node) { }
+
+    // Dereferencing the end iterator is an error
+    auto operator*() const -> pointer<T> { return pointer<T>::from_address(node_); }
+
+    auto operator++() -> intrusive_iterator&
+    {
+        if (!node_) {
+            TCB_PTR_RUNTIME_ERROR("Incremented past the end of an intrusive container");
+        }
+        node_ = cont_->next_node(node_);
+        return *this;
+    }
+
+    auto operator++(int) -> intrusive_iterator
+    {
+        auto temp = *this;
+        ++*this;
+        return temp;
+    }
+
+    auto operator--() -> intrusive_iterator&
+        requires Container::is_bidirectional
+    {
+        T* prev = node_ ? cont_->prev_node(node_) : cont_->last_node();
+        if (!prev) {
+            TCB_PTR_RUNTIME_ERROR("Decremented past the start of an intrusive container");
+        }
+        node_ = prev;
+        return *this;
+    }
+
+    auto operator--(int) -> intrusive_iterator
+        requires Container::is_bidirectional
+    {
+        auto temp = *this;
+        --*this;
+        return temp;
+    }
+
+    friend auto operator==(intrusive_iterator const& lhs, intrusive_iterator const& rhs) -> bool
+    {
+        return lhs.node_ == rhs.node_;
+    }
+};
+
+} // namespace detail
+
+/*
+ * MARK: List
+ */
+
+// A member of an element type which allows it to be in an intrusive_list
+template <typename T>
+class list_hook {
+private:
+    detail::link<T> prev_;
+    detail::link<T> next_;
+
+    template <typename U, list_hook<U> U::*>
+    friend class intrusive_list;
+
+public:
+    list_hook() = default;
+    list_hook(list_hook const&) noexcept { }
+    auto operator=(list_hook const&) noexcept -> list_hook& { return *this; }
+};
+
+// A doubly-linked list of the elements whose Hook is linked into it.
+// Insertion and removal, anywhere in the list, are O(1). The list unlinks
+// its elements when it is destroyed.
+template <typename T, list_hook<T> T::*Hook>
+class intrusive_list {
+private:
+    detail::link<T> head_;
+    detail::link<T> tail_;
+    std::size_t size_ = 0;
+
+    friend class detail::intrusive_iterator<intrusive_list, T>;
+    static constexpr bool is_bidirectional = true;
+
+    static auto hook(pointer<T> node) -> list_hook<T>& { return (*node).*Hook; }
+
+    auto next_node(T* node) const -> T* { return detail::link_address((node->*Hook).next_); }
+    auto prev_node(T* node) const -> T* { return detail::link_address((node->*Hook).prev_); }
+    auto last_node() const -> T* { return detail::link_address(tail_); }
+
+    // Checks what we can cheaply: an element which is alone in another list
+    // with the same hook looks unlinked
+    auto maybe_linked(pointer<T> node) const -> bool
+    {
+        return hook(node).prev_ || hook(node).next_ || head_ == node;
+    }
+
+    void check_unlinked(pointer<T> node) const
+    {
+        if (maybe_linked(node)) {
+            TCB_PTR_RUNTIME_ERROR("Element is already linked into an intrusive_list");
+        }
+    }
+
+public:
+    using iterator = detail::intrusive_iterator<intrusive_list, T>;
+
+    intrusive_list() = default;
+
+    intrusive_list(intrusive_list&& other) noexcept
+        : head_(other.head_), tail_(other.tail_), size_(other.size_)
+    {
+        other.head_ = other.tail_ = std::nullopt;
+        other.size_ = 0;
+    }
+
+    auto operator=(intrusive_list&& other) noexcept -> intrusive_list&
+    {
+        if (this != &other) {
+            clear();
+            head_ = other.head_;
+            tail_ = other.tail_;
+            size_ = other.size_;
+            other.head_ = other.tail_ = std::nullopt;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    ~intrusive_list() { clear(); }
+
+    auto size() const -> std::size_t { return size_; }
+    auto empty() const -> bool { return size_ == 0; }
+
+    auto front() const -> std::optional<pointer<T>> { return head_; }
+    auto back() const -> std::optional<pointer<T>> { return tail_; }
+
+    auto begin() const -> iterator { return iterator(*this, detail::link_address(head_)); }
+    auto end() const -> iterator { return iterator(*this, nullptr); }
+
+    // Links node in before pos, which must be in this list
+    void insert_before(pointer<T> pos, pointer<T> node)
+    {
+        check_unlinked(node);
+        if (!maybe_linked(pos)) {
+            TCB_PTR_RUNTIME_ERROR("Position is not in this intrusive_list");
+        }
+        auto& pos_hook = hook(pos);
+        auto& node_hook = hook(node);
+        node_hook.prev_ = pos_hook.prev_;
+        node_hook.next_ = pos;
+        if (pos_hook.prev_) {
+            hook(*pos_hook.prev_).next_ = node;
+        } else {
+            head_ = node;
+        }
+        pos_hook.prev_ = node;
+        ++size_;
+    }
+
+    void push_front(pointer<T> node)
+    {
+        if (head_) {
+            insert_before(*head_, node);
+        } else {
+            check_unlinked(node);
+            head_ = tail_ = node;
+            size_ = 1;
+        }
+    }
+
+    void push_back(pointer<T> node)
+    {
+        check_unlinked(node);
+        auto& node_hook = hook(node);
+        node_hook.prev_ = tail_;
+        if (tail_) {
+            hook(*tail_).next_ = node;
+        } else {
+            head_ = node;
+        }
+        tail_ = node;
+        ++size_;
+    }
+
+    // Unlinks node, which must be in this list
+    void erase(pointer<T> node)
+    {
+        if (!maybe_linked(node)) {
+            TCB_PTR_RUNTIME_ERROR("Element is not in this intrusive_list");
+        }
+        auto& node_hook = hook(node);
+        if (node_hook.prev_) {
+            hook(*node_hook.prev_).next_ = node_hook.next_;
+        } else {
+            head_ = node_hook.next_;
+        }
+        if (node_hook.next_) {
+            hook(*node_hook.next_).prev_ = node_hook.prev_;
+        } else {
+            tail_ = node_hook.prev_;
+        }
+        node_hook.prev_ = node_hook.next_ = std::nullopt;
+        --size_;
+    }
+
+    auto pop_front() -> std::optional<pointer<T>>
+    {
+        auto const node = head_;
+        if (node) {
+            erase(*node);
+        }
+        return node;
+    }
+
+    auto pop_back() -> std::optional<pointer<T>>
+    {
+        auto const node = tail_;
+        if (node) {
+            erase(*node);
+        }
+        return node;
+    }
+
+    void clear()
+    {
+        while (head_) {
+            auto& head_hook = hook(*head_);
+            auto const next = head_hook.next_;
+            head_hook.prev_ = head_hook.next_ = std::nullopt;
+            head_ = next;
+        }
+        tail_ = std::nullopt;
+        size_ = 0;
+    }
+};
+
+/*
+ * MARK: Stacks
+ */
+
+// A member of an element type which allows it to be in an intrusive_stack or
+// an atomic_intrusive_stack
+template <typename T>
+class stack_hook {
+private:
+    detail::link<T> next_;
+
+    template <typename U, stack_hook<U> U::*>
+    friend class intrusive_stack;
+
+    template <typename U, stack_hook<U> U::*>
+    friend class atomic_intrusive_stack;
+
+public:
+    stack_hook() = default;
+    stack_hook(stack_hook const&) noexcept { }
+    auto operator=(stack_hook const&) noexcept -> stack_hook& { return *this; }
+};
+
+// A singly-linked, last-in-first-out stack of the elements whose Hook is
+// linked into it. Iteration goes from the top down.
+template <typename T, stack_hook<T> T::*Hook>
+class intrusive_stack {
+private:
+    detail::link<T> top_;
+    std::size_t size_ = 0;
+
+    friend class detail::intrusive_iterator<intrusive_stack, T>;
+    static constexpr bool is_bidirectional = false;
+
+    template <typename U, stack_hook<U> U::*>
+    friend class atomic_intrusive_stack;
+
+    static auto hook(pointer<T> node) -> stack_hook<T>& { return (*node).*Hook; }
+
+    auto next_node(T* node) const -> T* { return detail::link_address((node->*Hook).next_); }
+
+    // Takes ownership of a chain of elements
+    void adopt(detail::link<T> top)
+    {
+        clear();
+        top_ = top;
+        for (auto node = top; node; node = hook(*node).next_) {
+            ++size_;
+        }
+    }
+
+public:
+    using iterator = detail::intrusive_iterator<intrusive_stack, T>;
+
+    intrusive_stack() = default;
+
+    intrusive_stack(intrusive_stack&& other) noexcept : top_(other.top_), size_(other.size_)
+    {
+        other.top_ = std::nullopt;
+        other.size_ = 0;
+    }
+
+    auto operator=(intrusive_stack&& other) noexcept -> intrusive_stack&
+    {
+        if (this != &other) {
+            clear();
+            top_ = other.top_;
+            size_ = other.size_;
+            other.top_ = std::nullopt;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    ~intrusive_stack() { clear(); }
+
+    auto size() const -> std::size_t { return size_; }
+    auto empty() const -> bool { return size_ == 0; }
+
+    auto top() const -> std::optional<pointer<T>> { return top_; }
+
+    auto begin() const -> iterator { return iterator(*this, detail::link_address(top_)); }
+    auto end() const -> iterator { return iterator(*this, nullptr); }
+
+    void push(pointer<T> node)
+    {
+        auto& node_hook = hook(node);
+        // As for intrusive_list, an element at the bottom of another stack
+        // looks unlinked
+        if (node_hook.next_ || top_ == node) {
+            TCB_PTR_RUNTIME_ERROR("Element is already linked into an intrusive_stack");
+        }
+        node_hook.next_ = top_;
+        top_ = node;
+        ++size_;
+    }
+
+    auto pop() -> std::optional<pointer<T>>
+    {
+        auto const node = top_;
+        if (node) {
+            auto& node_hook = hook(*node);
+            top_ = node_hook.next_;
+            node_hook.next_ = std::nullopt;
+            --size_;
+        }
+        return node;
+    }
+
+    void clear()
+    {
+        while (pop()) { }
+    }
+};
+
+// A lock-free intrusive stack (a Treiber stack), for use by any number of
+// threads.
+//
+// The head of the stack is tagged with a counter which changes on every
+// update, so that a pop which reads the top element, is delayed while that
+// element is popped and pushed again, and then tries to replace the head,
+// fails rather than corrupting the stack (the ABA problem). The tag and the
+// address share a 64-bit word: on 64-bit systems, the tag is 16 bits and
+// addresses must fit in 48 bits, which push() checks.
+//
+// A pop can read the link of an element which another thread has just
+// popped, so elements must stay alive while any thread might be popping (for
+// example, by coming from a pool which outlives the stack).
+template <typename T, stack_hook<T> T::*Hook>
+class atomic_intrusive_stack {
+private:
+    static constexpr unsigned address_bits = sizeof(T*) >= 8 ? 48 : 32;
+    static constexpr std::uint64_t address_mask = (std::uint64_t{1} << address_bits) - 1;
+
+    std::atomic<std::uint64_t> head_{0};
+
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+    // Links are read and written by several threads at once
+    static auto next_link(T* node) -> std::atomic_ref<detail::link<T>>
+    {
+        return std::atomic_ref<detail::link<T>>((node->*Hook).next_);
+    }
+
+    static auto address(std::uint64_t head) -> T*
+    {
+        return reinterpret_cast<T*>(static_cast<std::uintptr_t>(head & address_mask));
+    }
+
+    static auto to_bits(T* addr) -> std::uint64_t
+    {
+        return static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(addr));
+    }
+
+    // The next value of the head, pointing at addr, with the tag incremented
+    static auto with_address(std::uint64_t head, T* addr) -> std::uint64_t
+    {
+        std::uint64_t const tag = (head >> address_bits) + 1;
+        return (tag << address_bits) | to_bits(addr);
+    }
+
+public:
+    atomic_intrusive_stack() = default;
+
+    atomic_intrusive_stack(atomic_intrusive_stack const&) = delete;
+    auto operator=(atomic_intrusive_stack const&) -> atomic_intrusive_stack& = delete;
+
+    // Only a snapshot, which may be out of date by the time it is returned
+    auto empty() const -> bool { return address(head_.load(std::memory_order_relaxed)) == nullptr; }
+
+    // node must not be in this or any other stack with the same hook
+    void push(pointer<T> node)
+    {
+        T* const addr = node.to_address();
+        if ((to_bits(addr) & ~address_mask) != 0) {
+            TCB_PTR_RUNTIME_ERROR("Address too large for atomic_intrusive_stack::push()");
+        }
+        std::uint64_t head = head_.load(std::memory_order_relaxed);
+        do {
+            next_link(addr).store(detail::make_link(address(head)), std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(head, with_address(head, addr),
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed));
+    }
+
+    auto pop() -> std::optional<pointer<T>>
+    {
+        std::uint64_t head = head_.load(std::memory_order_acquire);
+        while (true) {
+            T* const top = address(head);
+            if (!top) {
+                return std::nullopt;
+            }
+            T* const next = detail::link_address(next_link(top).load(std::memory_order_relaxed));
+            if (head_.compare_exchange_weak(head, with_address(head, next),
+                                            std::memory_order_acquire,
+                                            std::memory_order_acquire)) {
+                next_link(top).store(std::nullopt, std::memory_order_relaxed);
+                return pointer<T>::from_address(top);
+            }
+        }
+    }
+
+    // Pops every element at once, returning them as a (single-threaded)
+    // stack in the same order
+    auto pop_all() -> intrusive_stack<T, Hook>
+    {
+        std::uint64_t head = head_.load(std::memory_order_relaxed);
+        while (!head_.compare_exchange_weak(head, with_address(head, nullptr),
+                                            std::memory_order_acquire,
+                                            std::memory_order_relaxed)) { }
+        intrusive_stack<T, Hook> result;
+        result.adopt(detail::make_link(address(head)));
+        return result;
+    }
+};
+
+/*
+ * MARK: Red-black tree
+ */
+
+// A member of an element type which allows it to be in an intrusive_rbtree
+template <typename T>
+class rbtree_hook {
+private:
+    detail::link<T> parent_;
+    detail::link<T> left_;
+    detail::link<T> right_;
+    bool red_ = false;
+
+    template <typename U, rbtree_hook<U> U::*, typename, typename>
+    friend class intrusive_rbtree;
+
+public:
+    rbtree_hook() = default;
+    rbtree_hook(rbtree_hook const&) noexcept { }
+    auto operator=(rbtree_hook const&) noexcept -> rbtree_hook& { return *this; }
+};
+
+// A red-black tree of the elements whose Hook is linked into it, ordered by
+// comparing the results of key_fn on the elements. Elements with equal keys
+// are allowed, and stay in the order they were inserted. Insertion and
+// removal are O(log n).
+template <typename T, rbtree_hook<T> T::*Hook, typename KeyFn = std::identity,
+          typename Compare = std::ranges::less>
+class intrusive_rbtree {
+private:
+    detail::link<T> root_;
+    std::size_t size_ = 0;
+    [[no_unique_address]] KeyFn key_fn_;
+    [[no_unique_address]] Compare comp_;
+
+    friend class detail::intrusive_iterator<intrusive_rbtree, T>;
+    static constexpr bool is_bidirectional = true;
+
+    static auto hook(T* node) -> rbtree_hook<T>& { return node->*Hook; }
+
+    static auto parent(T* node) -> T* { return detail::link_address(hook(node).parent_); }
+    static auto left(T* node) -> T* { return detail::link_address(hook(node).left_); }
+    static auto right(T* node) -> T* { return detail::link_address(hook(node).right_); }
+    static void set_parent(T* node, T* p) { hook(node).parent_ = detail::make_link(p); }
+    static void set_left(T* node, T* l) { hook(node).left_ = detail::make_link(l); }
+    static void set_right(T* node, T* r) { hook(node).right_ = detail::make_link(r); }
+
+    // Null leaves count as black
+    static auto is_red(T* node) -> bool { return node && hook(node).red_; }
+    static void set_red(T* node, bool red) { hook(node).red_ = red; }
+
+    auto root() const -> T* { return detail::link_address(root_); }
+
+    static auto minimum(T* node) -> T*
+    {
+        while (left(node)) {
+            node = left(node);
+        }
+        return node;
+    }
+
+    static auto maximum(T* node) -> T*
+    {
+        while (right(node)) {
+            node = right(node);
+        }
+        return node;
+    }
+
+    auto next_node(T* node) const -> T*
+    {
+        if (right(node)) {
+            return minimum(right(node));
+        }
+        T* p = parent(node);
+        while (p && node == right(p)) {
+            node = p;
+            p = parent(p);
+        }
+        return p;
+    }
+
+    auto prev_node(T* node) const -> T*
+    {
+        if (left(node)) {
+            return maximum(left(node));
+        }
+        T* p = parent(node);
+        while (p && node == left(p)) {
+            node = p;
+            p = parent(p);
+        }
+        return p;
+    }
+
+    auto last_node() const -> T* { return root() ? maximum(root()) : nullptr; }
+
+    template <typename A, typename B>
+    auto less(A const& a, B const& b) const -> bool
+    {
+        return std::invoke(comp_, a, b);
+    }
+
+    auto key(T* node) const -> decltype(auto) { return std::invoke(key_fn_, *node); }
+
+    // Puts replacement (which may be null) in old's place under old's parent
+    void replace_child(T* old, T* replacement)
+    {
+        T* const p = parent(old);
+        if (replacement) {
+            set_parent(replacement, p);
+        }
+        if (!p) {
+            root_ = detail::make_link(replacement);
+        } else if (left(p) == old) {
+            set_left(p, replacement);
+        } else {
+            set_right(p, replacement);
+        }
+    }
+
+    void rotate_left(T* x)
+    {
+        T* const y = right(x);
+        set_right(x, left(y));
+        if (left(y)) {
+            set_parent(left(y), x);
+        }
+        replace_child(x, y);
+        set_left(y, x);
+        set_parent(x, y);
+    }
+
+    void rotate_right(T* x)
+    {
+        T* const y = left(x);
+        set_left(x, right(y));
+        if (right(y)) {
+            set_parent(right(y), x);
+        }
+        replace_child(x, y);
+        set_right(y, x);
+        set_parent(x, y);
+    }
+
+    void insert_fixup(T* node)
+    {
+        while (is_red(parent(node))) {
+            T* p = parent(node);
+            // p is red, so isn't the root
+            T* const g = parent(p);
+            if (p == left(g)) {
+                T* const uncle = right(g);
+                if (is_red(uncle)) {
+                    set_red(p, false);
+                    set_red(uncle, false);
+                    set_red(g, true);
+                    node = g;
+                } else {
+                    if (node == right(p)) {
+                        node = p;
+                        rotate_left(node);
+                        p = parent(node);
+                    }
+                    set_red(p, false);
+                    set_red(g, true);
+                    rotate_right(g);
+                }
+            } else {
+                T* const uncle = left(g);
+                if (is_red(uncle)) {
+                    set_red(p, false);
+                    set_red(uncle, false);
+                    set_red(g, true);
+                    node = g;
+                } else {
+                    if (node == left(p)) {
+                        node = p;
+                        rotate_right(node);
+                        p = parent(node);
+                    }
+                    set_red(p, false);
+                    set_red(g, true);
+                    rotate_left(g);
+                }
+            }
+        }
+        set_red(root(), false);
+    }
+
+    // x (possibly null) has an extra black, and is a child of x_parent
+    void erase_fixup(T* x, T* x_parent)
+    {
+        while (x != root() && !is_red(x)) {
+            // x's sibling must exist, as the black heights on both sides of
+            // x_parent differ
+            if (x == left(x_parent)) {
+                T* sibling = right(x_parent);
+                if (is_red(sibling)) {
+                    set_red(sibling, false);
+                    set_red(x_parent, true);
+                    rotate_left(x_parent);
+                    sibling = right(x_parent);
+                }
+                if (!is_red(left(sibling)) && !is_red(right(sibling))) {
+                    set_red(sibling, true);
+                    x = x_parent;
+                    x_parent = parent(x);
+                } else {
+                    if (!is_red(right(sibling))) {
+                        set_red(left(sibling), false);
+                        set_red(sibling, true);
+                        rotate_right(sibling);
+                        sibling = right(x_parent);
+                    }
+                    set_red(sibling, is_red(x_parent));
+                    set_red(x_parent, false);
+                    set_red(right(sibling), false);
+                    rotate_left(x_parent);
+                    x = root();
+                }
+            } else {
+                T* sibling = left(x_parent);
+                if (is_red(sibling)) {
+                    set_red(sibling, false);
+                    set_red(x_parent, true);
+                    rotate_right(x_parent);
+                    sibling = left(x_parent);
+                }
+                if (!is_red(left(sibling)) && !is_red(right(sibling))) {
+                    set_red(sibling, true);
+                    x = x_parent;
+                    x_parent = parent(x);
+                } else {
+                    if (!is_red(left(sibling))) {
+                        set_red(right(sibling), false);
+                        set_red(sibling, true);
+                        rotate_left(sibling);
+                        sibling = left(x_parent);
+                    }
+                    set_red(sibling, is_red(x_parent));
+                    set_red(x_parent, false);
+                    set_red(left(sibling), false);
+                    rotate_right(x_parent);
+                    x = root();
+                }
+            }
+        }
+        if (x) {
+            set_red(x, false);
+        }
+    }
+
+    // Checks what we can cheaply: an element which is alone in another tree
+    // with the same hook looks unlinked
+    auto maybe_linked(T* node) const -> bool
+    {
+        auto const& h = hook(node);
+        return h.parent_ || h.left_ || h.right_ || root() == node;
+    }
+
+public:
+    using iterator = detail::intrusive_iterator<intrusive_rbtree, T>;
+
+    intrusive_rbtree() = default;
+
+    explicit intrusive_rbtree(KeyFn key_fn, Compare comp = Compare())
+        : key_fn_(std::move(key_fn)), comp_(std::move(comp))
+    {
+    }
+
+    intrusive_rbtree(intrusive_rbtree&& other) noexcept
+        : root_(other.root_), size_(other.size_), key_fn_(other.key_fn_), comp_(other.comp_)
+    {
+        other.root_ = std::nullopt;
+        other.size_ = 0;
+    }
+
+    auto operator=(intrusive_rbtree&& other) noexcept -> intrusive_rbtree&
+    {
+        if (this != &other) {
+            clear();
+            root_ = other.root_;
+            size_ = other.size_;
+            key_fn_ = other.key_fn_;
+            comp_ = other.comp_;
+            other.root_ = std::nullopt;
+            other.size_ = 0;
+        }
+        return *this;
+    }
+
+    ~intrusive_rbtree() { clear(); }
+
+    auto size() const -> std::size_t { return size_; }
+    auto empty() const -> bool { return size_ == 0; }
+
+    auto front() const -> std::optional<pointer<T>>
+    {
+        return root() ? detail::make_link(minimum(root())) : std::nullopt;
+    }
+
+    auto back() const -> std::optional<pointer<T>> { return detail::make_link(last_node()); }
+
+    auto begin() const -> iterator { return iterator(*this, root() ? minimum(root()) : nullptr); }
+    auto end() const -> iterator { return iterator(*this, nullptr); }
+
+    void insert(pointer<T> node_ptr)
+    {
+        T* const node = node_ptr.to_address();
+        if (maybe_linked(node)) {
+            TCB_PTR_RUNTIME_ERROR("Element is already linked into an intrusive_rbtree");
+        }
+
+        // After any equal elements
+        T* p = nullptr;
+        bool go_left = false;
+        for (T* cur = root(); cur;) {
+            p = cur;
+            go_left = less(key(node), key(cur));
+            cur = go_left ? left(cur) : right(cur);
+        }
+
+        set_parent(node, p);
+        set_red(node, true);
+        if (!p) {
+            root_ = node_ptr;
+        } else if (go_left) {
+            set_left(p, node);
+        } else {
+            set_right(p, node);
+        }
+        ++size_;
+        insert_fixup(node);
+    }
+
+    // Unlinks node, which must be in this tree
+    void erase(pointer<T> node_ptr)
+    {
+        T* const node = node_ptr.to_address();
+        if (!maybe_linked(node)) {
+            TCB_PTR_RUNTIME_ERROR("Element is not in this intrusive_rbtree");
+        }
+
+        bool removed_red = is_red(node);
+        T* x = nullptr;
+        T* x_parent = nullptr;
+        if (!left(node)) {
+            x = right(node);
+            x_parent = parent(node);
+            replace_child(node, x);
+        } else if (!right(node)) {
+            x = left(node);
+            x_parent = parent(node);
+            replace_child(node, x);
+        } else {
+            // Replace node by its successor, which has no left child
+            T* const succ = minimum(right(node));
+            removed_red = is_red(succ);
+            x = right(succ);
+            if (parent(succ) == node) {
+                x_parent = succ;
+            } else {
+                x_parent = parent(succ);
+                replace_child(succ, x);
+                set_right(succ, right(node));
+                set_parent(right(succ), succ);
+            }
+            replace_child(node, succ);
+            set_left(succ, left(node));
+            set_parent(left(succ), succ);
+            set_red(succ, is_red(node));
+        }
+
+        auto& h = hook(node);
+        h.parent_ = h.left_ = h.right_ = std::nullopt;
+        h.red_ = false;
+        --size_;
+
+        if (!removed_red) {
+            erase_fixup(x, x_parent);
+        }
+    }
+
+    // The first element whose key is not less than k
+    template <typename K>
+    auto lower_bound(K const& k) const -> iterator
+    {
+        T* result = nullptr;
+        for (T* cur = root(); cur;) {
+            if (less(key(cur), k)) {
+                cur = right(cur);
+            } else {
+                result = cur;
+                cur = left(cur);
+            }
+        }
+        return iterator(*this, result);
+    }
+
+    // The first element whose key is greater than k
+    template <typename K>
+    auto upper_bound(K const& k) const -> iterator
+    {
+        T* result = nullptr;
+        for (T* cur = root(); cur;) {
+            if (less(k, key(cur))) {
+                result = cur;
+                cur = left(cur);
+            } else {
+                cur = right(cur);
+            }
+        }
+        return iterator(*this, result);
+    }
+
+    // The first element whose key is equal to k, if any
+    template <typename K>
+    auto find(K const& k) const -> std::optional<pointer<T>>
+    {
+        auto const it = lower_bound(k);
+        if (it == end() || less(k, key((*it).to_address()))) {
+            return std::nullopt;
+        }
+        return *it;
+    }
+
+    void clear()
+    {
+        // Unlink the elements bottom-up, without rebalancing
+        T* node = root();
+        while (node) {
+            if (left(node)) {
+                node = left(node);
+            } else if (right(node)) {
+                node = right(node);
+            } else {
+                T* const p = parent(node);
+                if (p) {
+                    if (left(p) == node) {
+                        hook(p).left_ = std::nullopt;
+                    } else {
+                        hook(p).right_ = std::nullopt;
+                    }
+                }
+                auto& h = hook(node);
+                h.parent_ = std::nullopt;
+                h.red_ = false;
+                node = p;
+            }
+        }
+        root_ = std::nullopt;
+        size_ = 0;
+    }
+};
+
+} // namespace tcb
+
+#endif
@@ -0,0 +1,348 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_MAPPED_LOG_HPP_INCLUDED
+#define TCB_MAPPED_LOG_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+#include <tcb/cpu_dispatch.hpp> // for detail::cache_line_size
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // for std::memcpy
+#include <map>
+#include <mutex>
+#include <stdexcept> // for std::length_error
+
+#if __has_include(<sys/mman.h>) && __has_include(<sys/stat.h>) && __has_include(<fcntl.h>) \
+    && __has_include(<unistd.h>)
+#    include <cerrno>
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <system_error>
+#    include <unistd.h>
+#    define TCB_PTR_HAVE_MAPPED_LOG 1
+#else
+#    define TCB_PTR_HAVE_MAPPED_LOG 0
+#endif
+
+#if TCB_PTR_HAVE_MAPPED_LOG
+
+namespace tcb {
+
+struct mapped_log_options {
+    // The largest the file may grow to. This much address space is mapped up
+    // front, so that the mapping never moves, but the file only takes up the
+    // space it has been grown to.
+    std::size_t capacity = std::size_t{1} << (sizeof(std::size_t) >= 8 ? 40 : 28);
+    // The file is grown this many bytes at a time
+    std::size_t extent = std::size_t{64} << 20;
+    // Committed data is handed to the OS to write back every this many bytes,
+    // without waiting for it. Zero leaves it to the OS to decide when.
+    std::size_t writeback_interval = std::size_t{16} << 20;
+};
+
+// An append-only file which writers fill in place, through a shared mapping
+// of it, rather than copying into a buffer and then calling write().
+//
+// A writer reserves space at the end of the log, fills it in, and then
+// commits it. Reserving advances an atomic tail with compare-and-swap, so
+// any number of threads can reserve at once without a lock, except that
+// the one which first needs space beyond the end of the file grows it by a
+// whole extent, with fallocate() where available, under a mutex.
+//
+// The committed watermark is the end of the data which has been written:
+// everything before it has been committed. Committing never waits for other
+// writers. A reservation committed before an earlier one is set aside, and
+// the watermark passes over it when the earlier one is committed, so a
+// reservation must always be committed, even if the writer has nothing to
+// put in it, or the watermark stops.
+//
+// When the log is destroyed, the file is truncated to the committed
+// watermark, removing the unused part of the last extent. If the process
+// dies instead, the file keeps its zero-filled tail.
+class mapped_log {
+private:
+    alignas(detail::cache_line_size) std::atomic<std::uint64_t> tail_;
+    alignas(detail::cache_line_size) std::atomic<std::uint64_t> committed_;
+    alignas(detail::cache_line_size) std::atomic<std::uint64_t> allocated_;
+
+    alignas(detail::cache_line_size) std::byte* base_ = nullptr;
+    int fd_;
+    std::size_t capacity_;
+    std::size_t extent_;
+    std::size_t writeback_interval_;
+    std::size_t page_size_;
+    std::mutex grow_mutex_;
+    std::mutex sync_mutex_;
+    std::uint64_t synced_ = 0;
+
+    // Reservations committed before an earlier one, by start offset
+    alignas(detail::cache_line_size) std::atomic<std::size_t> pending_count_{0};
+    std::mutex pending_mutex_;
+    std::map<std::uint64_t, std::uint64_t> pending_;
+
+    static auto round_up(std::uint64_t n, std::uint64_t multiple) -> std::uint64_t
+    {
+        return (n + multiple - 1) / multiple * multiple;
+    }
+
+    static void throw_errno(char const* what)
+    {
+        TCB_PTR_THROW(std::system_error(errno, std::generic_category(), what));
+    }
+
+    // Makes the file at least end bytes long, with its blocks allocated if
+    // the platform allows it
+    void grow_to(std::uint64_t end)
+    {
+        std::lock_guard lock(grow_mutex_);
+        std::uint64_t const have = allocated_.load(std::memory_order_relaxed);
+        if (end <= have) {
+            return;
+        }
+        std::uint64_t want = round_up(end, extent_);
+        if (want > capacity_) {
+            want = capacity_;
+        }
+        auto const off = static_cast<::off_t>(have);
+        auto const len = static_cast<::off_t>(want - have);
+#    if defined(__linux__)
+        // Falls back to a sparse file on filesystems which can't preallocate
+        if (::fallocate(fd_, 0, off, len) != 0 && errno != EOPNOTSUPP) {
+            throw_errno("fallocate");
+        }
+#    elif defined(_POSIX_ADVISORY_INFO) && _POSIX_ADVISORY_INFO > 0
+        if (int const err = ::posix_fallocate(fd_, off, len); err != 0 && err != EINVAL) {
+            TCB_PTR_THROW(std::system_error(err, std::generic_category(), "posix_fallocate"));
+        }
+#    endif
+        struct ::stat st {};
+        if (::fstat(fd_, &st) != 0) {
+            throw_errno("fstat");
+        }
+        if (static_cast<std::uint64_t>(st.st_size) < want
+            && ::ftruncate(fd_, static_cast<::off_t>(want)) != 0) {
+            throw_errno("ftruncate");
+        }
+        allocated_.store(want, std::memory_order_release);
+    }
+
+    // Starts writing back [from, to) without waiting for it. Errors are left
+    // for sync() to report.
+    void start_writeback(std::uint64_t from, std::uint64_t to)
+    {
+        from = from / page_size_ * page_size_;
+#    if defined(__linux__)
+        // msync(MS_ASYNC) does nothing on Linux, where dirty pages of a
+        // shared mapping are written back like any others
+        (void)::sync_file_range(fd_, static_cast<::off_t>(from),
+                                static_cast<::off_t>(to - from), SYNC_FILE_RANGE_WRITE);
+#    else
+        (void)::msync(base_ + from, static_cast<std::size_t>(to - from), MS_ASYNC);
+#    endif
+    }
+
+    // Moves the watermark from begin to end if it is at begin
+    auto advance(std::uint64_t begin, std::uint64_t end) -> bool
+    {
+        std::uint64_t expected = begin;
+        if (!committed_.compare_exchange_strong(expected, end)) {
+            return false;
+        }
+        // The advances which cross each interval boundary write back the
+        // intervals they complete, so the intervals are each written back
+        // once, in order
+        if (writeback_interval_ != 0) {
+            std::uint64_t const done = end / writeback_interval_ * writeback_interval_;
+            if (done > begin) {
+                start_writeback(begin / writeback_interval_ * writeback_interval_, done);
+            }
+        }
+        return true;
+    }
+
+    // Moves the watermark over the pending commits which it has reached.
+    // Only the earliest can be next, as they are all beyond the watermark.
+    void drain_pending()
+    {
+        std::lock_guard lock(pending_mutex_);
+        while (!pending_.empty()) {
+            auto const next = pending_.begin();
+            if (!advance(next->first, next->second)) {
+                break;
+            }
+            pending_.erase(next);
+            pending_count_.fetch_sub(1);
+        }
+    }
+
+public:
+    // Opens a log which appends to fd, a regular file opened for reading and
+    // writing, starting at its current end. fd must stay open until the log
+    // is destroyed.
+    explicit mapped_log(int fd, mapped_log_options options = {})
+        : fd_(fd),
+          capacity_(options.capacity),
+          extent_(options.extent),
+          writeback_interval_(options.writeback_interval),
+          page_size_(static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)))
+    {
+        if (capacity_ == 0 || extent_ == 0) {
+            TCB_PTR_RUNTIME_ERROR("Zero capacity or extent passed to mapped_log()");
+        }
+        // Keeping these whole pages means that the ranges we write back are
+        // too
+        capacity_ = static_cast<std::size_t>(round_up(capacity_, page_size_));
+        extent_ = static_cast<std::size_t>(round_up(extent_, page_size_));
+        writeback_interval_ = static_cast<std::size_t>(round_up(writeback_interval_, page_size_));
+
+        struct ::stat st {};
+        if (::fstat(fd, &st) != 0) {
+            throw_errno("fstat");
+        }
+        auto const size = static_cast<std::uint64_t>(st.st_size);
+        if (size > capacity_) {
+            TCB_PTR_THROW(std::length_error("File larger than capacity passed to mapped_log()"));
+        }
+        tail_.store(size, std::memory_order_relaxed);
+        committed_.store(size, std::memory_order_relaxed);
+        allocated_.store(size, std::memory_order_relaxed);
+        synced_ = size;
+
+        int flags = MAP_SHARED;
+#    if defined(MAP_NORESERVE)
+        flags |= MAP_NORESERVE;
+#    endif
+        void* const addr = ::mmap(nullptr, capacity_, PROT_READ | PROT_WRITE, flags, fd, 0);
+        if (addr == MAP_FAILED) {
+            throw_errno("mmap");
+        }
+        base_ = static_cast<std::byte*>(addr);
+    }
+
+    mapped_log(mapped_log const&) = delete;
+    auto operator=(mapped_log const&) -> mapped_log& = delete;
+
+    // Every reservation must have been committed. Errors are ignored: call
+    // sync() first to hear about them.
+    ~mapped_log()
+    {
+        ::munmap(base_, capacity_);
+        (void)::ftruncate(fd_, static_cast<::off_t>(committed_.load(std::memory_order_acquire)));
+    }
+
+    // Reserves the next n bytes of the log, growing the file if needed, and
+    // returns them to be filled in and committed. The bytes may hold
+    // anything until they are written. Throws std::length_error, having
+    // reserved nothing, if the log doesn't have room, so that the caller can
+    // move on to a new one.
+    auto reserve(std::size_t n) -> pointer<std::byte[]>
+    {
+        if (n == 0) {
+            TCB_PTR_RUNTIME_ERROR("Zero size passed to mapped_log::reserve()");
+        }
+        std::uint64_t pos = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            if (n > capacity_ - pos) {
+                TCB_PTR_THROW(std::length_error("Log full in mapped_log::reserve()"));
+            }
+            // Grow before claiming the space, so that if growing throws, no
+            // space has been claimed which would never be committed
+            if (pos + n > allocated_.load(std::memory_order_acquire)) {
+                grow_to(pos + n);
+            }
+            if (tail_.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+                return pointer<std::byte[]>::from_address_with_size(base_ + pos, n);
+            }
+        }
+    }
+
+    // Marks a reservation as written. Every byte of it must have been
+    // written, and it must be exactly as returned by reserve().
+    void commit(pointer<std::byte[]> reservation)
+    {
+        // Compared as integers, as the reservation may not point into the
+        // mapping at all
+        auto const addr = reinterpret_cast<std::uintptr_t>(reservation->data());
+        auto const base = reinterpret_cast<std::uintptr_t>(base_);
+        std::uint64_t const tail = tail_.load(std::memory_order_relaxed);
+        if (addr < base || addr - base >= tail || reservation->size() > tail - (addr - base)) {
+            TCB_PTR_RUNTIME_ERROR("Invalid reservation passed to mapped_log::commit()");
+        }
+        std::uint64_t const begin = addr - base;
+        std::uint64_t const end = begin + reservation->size();
+
+        if (begin < committed_.load(std::memory_order_relaxed)) {
+            TCB_PTR_RUNTIME_ERROR("Reservation committed twice in mapped_log::commit()");
+        }
+
+        // Only the owner of the range starting at the watermark can advance
+        // it, so this fails only if an earlier reservation is uncommitted
+        if (advance(begin, end)) {
+            // Seeing no pending commits here means that anything set aside
+            // concurrently will see our advance when it drains
+            if (pending_count_.load() != 0) {
+                drain_pending();
+            }
+            return;
+        }
+        {
+            std::lock_guard lock(pending_mutex_);
+            pending_.emplace(begin, end);
+            pending_count_.fetch_add(1);
+        }
+        drain_pending();
+    }
+
+    // Reserves, fills and commits space for bytes. Returns the offset in the
+    // file at which they were written.
+    auto append(pointer<std::byte const[]> bytes) -> std::uint64_t
+    {
+        pointer<std::byte[]> const space = reserve(bytes->size());
+        std::memcpy(space->data(), bytes->data(), bytes->size());
+        commit(space);
+        return static_cast<std::uint64_t>(space->data() - base_);
+    }
+
+    // Waits until everything committed so far is on disk
+    void sync()
+    {
+        std::lock_guard lock(sync_mutex_);
+        std::uint64_t const end = committed_.load(std::memory_order_acquire);
+        std::uint64_t const from = synced_ / page_size_ * page_size_;
+        if (end > from) {
+            if (::msync(base_ + from, static_cast<std::size_t>(end - from), MS_SYNC) != 0) {
+                throw_errno("msync");
+            }
+        }
+        synced_ = end;
+    }
+
+    // The size of the log, up to the committed watermark
+    auto committed() const -> std::uint64_t { return committed_.load(std::memory_order_acquire); }
+
+    // The size of the log including space which has been reserved but not
+    // yet committed
+    auto reserved() const -> std::uint64_t { return tail_.load(std::memory_order_relaxed); }
+
+    // The size the file has been grown to
+    auto allocated() const -> std::uint64_t { return allocated_.load(std::memory_order_acquire); }
+
+    // The committed data, which stays valid while the log exists, so that
+    // it can be read while it is being appended to
+    auto committed_data() const -> pointer<std::byte const[]>
+    {
+        return pointer<std::byte const[]>::from_address_with_size(
+            base_, static_cast<std::size_t>(committed()));
+    }
+};
+
+} // namespace tcb
+
+#endif // TCB_PTR_HAVE_MAPPED_LOG
+
+#endif
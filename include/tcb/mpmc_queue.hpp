@@ -0,0 +1,224 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_MPMC_QUEUE_HPP_INCLUDED
+#define TCB_MPMC_QUEUE_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+#include <tcb/cpu_dispatch.hpp> // for detail::cache_line_size
+#include <tcb/parallel.hpp> // for detail::spin_backoff
+
+#include <atomic>
+#include <cstddef>
+#include <memory> // for std::unique_ptr
+#include <optional>
+#include <type_traits>
+#include <utility> // for std::pair
+
+namespace tcb {
+
+// A bounded queue of pointer<T>s, for any number of producer and consumer
+// threads.
+//
+// Each slot is a single word: an empty slot holds the null bit pattern,
+// which is never a valid pointer<T>, and is how std::optional<pointer<T>>
+// represents nullopt. So unlike the usual bounded MPMC queue, which stores a
+// sequence number alongside each element, there is only one atomic per slot.
+//
+// Producers and consumers claim positions by advancing the tail and head
+// counters. A producer then waits for its slot to be empty before filling
+// it, and a consumer waits for its slot to be full before emptying it. This
+// means that a thread which is descheduled between claiming a position and
+// using it holds up the thread which next claims the same slot, one lap of
+// the queue later. Because slots don't record which lap they belong to, if
+// such a stall happens while the queue wraps around, the two elements
+// involved can come out in the opposite order to the one they went in;
+// each is still popped exactly once.
+template <typename T>
+    requires(!std::is_array_v<T>)
+class mpmc_queue {
+private:
+    using slot_type = std::atomic<std::optional<pointer<T>>>;
+
+    static_assert(slot_type::is_always_lock_free);
+    static_assert(sizeof(slot_type) == sizeof(T*));
+
+    // Each on its own cache line, so that producers and consumers don't
+    // contend on the same line
+    alignas(detail::cache_line_size) std::atomic<std::size_t> head_{0};
+    alignas(detail::cache_line_size) std::atomic<std::size_t> tail_{0};
+
+    alignas(detail::cache_line_size) std::size_t mask_;
+    std::unique_ptr<slot_type[]> slots_;
+
+    static auto round_up_capacity(std::size_t capacity) -> std::size_t
+    {
+        if (capacity == 0 || capacity > (std::size_t{1} << (sizeof(std::size_t) * 8 - 2))) {
+            TCB_PTR_RUNTIME_ERROR("Invalid capacity passed to mpmc_queue()");
+        }
+        std::size_t rounded = 1;
+        while (rounded < capacity) {
+            rounded *= 2;
+        }
+        return rounded;
+    }
+
+    // tail - head, or zero if we have a stale copy of tail which is behind
+    // head
+    static auto distance(std::size_t head, std::size_t tail) -> std::size_t
+    {
+        auto const diff = static_cast<std::ptrdiff_t>(tail - head);
+        return diff > 0 ? static_cast<std::size_t>(diff) : 0;
+    }
+
+    // Advances counter by up to n positions, as long as no more than
+    // available(counter, other) are free. Returns the first position
+    // claimed, and the number claimed.
+    template <typename Available>
+    static auto claim(std::atomic<std::size_t>& counter, std::atomic<std::size_t> const& other,
+                      std::size_t n, Available available) -> std::pair<std::size_t, std::size_t>
+    {
+        std::size_t pos = counter.load(std::memory_order_relaxed);
+        while (true) {
+            std::size_t const avail = available(pos, other.load(std::memory_order_acquire));
+            std::size_t const count = n < avail ? n : avail;
+            if (count == 0) {
+                // Only give up if our copy of counter wasn't stale
+                std::size_t const current = counter.load(std::memory_order_relaxed);
+                if (current == pos) {
+                    return {pos, 0};
+                }
+                pos = current;
+                continue;
+            }
+            // If counter has moved on since we loaded other, this fails, so
+            // we never claim positions based on an out-of-date limit
+            if (counter.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+                return {pos, count};
+            }
+        }
+    }
+
+    auto claim_push(std::size_t n) -> std::pair<std::size_t, std::size_t>
+    {
+        std::size_t const cap = capacity();
+        return claim(tail_, head_, n, [cap](std::size_t tail, std::size_t head) {
+            std::size_t const used = distance(head, tail);
+            return used < cap ? cap - used : 0;
+        });
+    }
+
+    auto claim_pop(std::size_t n) -> std::pair<std::size_t, std::size_t>
+    {
+        return claim(head_, tail_, n, [](std::size_t head, std::size_t tail) {
+            return distance(head, tail);
+        });
+    }
+
+    void fill_slot(std::size_t pos, pointer<T> value)
+    {
+        slot_type& slot = slots_[pos & mask_];
+        std::optional<pointer<T>> expected;
+        detail::spin_backoff backoff;
+        while (!slot.compare_exchange_weak(expected, value, std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+            // Wait for the consumer from the previous lap to empty the slot
+            expected = std::nullopt;
+            backoff();
+        }
+    }
+
+    auto empty_slot(std::size_t pos) -> pointer<T>
+    {
+        slot_type& slot = slots_[pos & mask_];
+        detail::spin_backoff backoff;
+        while (true) {
+            // Wait for the producer to fill the slot. If another consumer
+            // takes the value first, keep waiting for the next one.
+            if (slot.load(std::memory_order_relaxed).has_value()) {
+                std::optional<pointer<T>> value
+                    = slot.exchange(std::nullopt, std::memory_order_acquire);
+                if (value.has_value()) {
+                    return *value;
+                }
+            }
+            backoff();
+        }
+    }
+
+public:
+    // Creates an empty queue with room for at least capacity elements. The
+    // capacity is rounded up to a power of two.
+    explicit mpmc_queue(std::size_t capacity)
+        : mask_(round_up_capacity(capacity) - 1), slots_(new slot_type[mask_ + 1])
+    {
+    }
+
+    mpmc_queue(mpmc_queue const&) = delete;
+    auto operator=(mpmc_queue const&) -> mpmc_queue& = delete;
+
+    // The maximum number of elements the queue can hold
+    auto capacity() const -> std::size_t { return mask_ + 1; }
+
+    // The number of elements in the queue. Only a snapshot: it may be out of
+    // date by the time it is returned.
+    auto size_approx() const -> std::size_t
+    {
+        std::size_t const head = head_.load(std::memory_order_relaxed);
+        return distance(head, tail_.load(std::memory_order_relaxed));
+    }
+
+    // Adds value to the back of the queue and returns true, or returns false
+    // if the queue is full
+    auto try_push(pointer<T> value) -> bool
+    {
+        auto const [pos, count] = claim_push(1);
+        if (count == 0) {
+            return false;
+        }
+        fill_slot(pos, value);
+        return true;
+    }
+
+    // Adds as many of values to the back of the queue as there is room for,
+    // in order, and returns how many were added. The elements of a batch
+    // are claimed with a single atomic operation, so they are contiguous in
+    // the queue.
+    auto try_push(pointer<pointer<T> const[]> values) -> std::size_t
+    {
+        pointer<T> const* first = values->data();
+        auto const [pos, count] = claim_push(values->size());
+        for (std::size_t i = 0; i < count; ++i) {
+            fill_slot(pos + i, first[i]);
+        }
+        return count;
+    }
+
+    // Removes and returns the element at the front of the queue, or returns
+    // nullopt if the queue is empty
+    auto try_pop() -> std::optional<pointer<T>>
+    {
+        auto const [pos, count] = claim_pop(1);
+        if (count == 0) {
+            return std::nullopt;
+        }
+        return empty_slot(pos);
+    }
+
+    // Removes up to out->size() elements from the front of the queue, writes
+    // them to the start of out in order, and returns how many were removed
+    auto try_pop(pointer<pointer<T>[]> out) -> std::size_t
+    {
+        pointer<T>* first = out->data();
+        auto const [pos, count] = claim_pop(out->size());
+        for (std::size_t i = 0; i < count; ++i) {
+            first[i] = empty_slot(pos + i);
+        }
+        return count;
+    }
+};
+
+} // namespace tcb
+
+#endif
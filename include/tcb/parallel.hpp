@@ -0,0 +1,114 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_PARALLEL_HPP_INCLUDED
+#define TCB_PARALLEL_HPP_INCLUDED
+
+#include <cstddef>
+#include <exception> // for std::exception_ptr
+#include <thread>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#    include <intrin.h> // for _mm_pause
+#endif
+
+namespace tcb {
+
+// Passed as the first argument to an algorithm to request its parallel
+// version. Work is split across short-lived threads, one per task; there is
+// no global thread pool.
+struct parallel_t {
+    // The maximum number of threads to use, or zero for one per hardware
+    // thread
+    std::size_t threads = 0;
+};
+
+inline constexpr parallel_t parallel{};
+
+namespace detail {
+
+// Tells the CPU we are in a spin-wait loop, which saves power and gives the
+// core to the other hyperthread
+inline void cpu_relax() noexcept
+{
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_ia32_pause();
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_pause();
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+    asm volatile("yield");
+#endif
+}
+
+// For spin-wait loops on another thread, which might have been descheduled:
+// spins on cpu_relax() for a while, then starts yielding the core instead
+class spin_backoff {
+private:
+    static constexpr unsigned max_spins = 64;
+    unsigned spins_ = 0;
+
+public:
+    void operator()() noexcept
+    {
+        if (spins_ < max_spins) {
+            ++spins_;
+            cpu_relax();
+        } else {
+            std::this_thread::yield();
+        }
+    }
+};
+
+// The number of tasks to split n items into, so that each task gets at
+// least min_grain items
+inline auto task_count(parallel_t policy, std::size_t n, std::size_t min_grain) -> std::size_t
+{
+    std::size_t threads = policy.threads;
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    std::size_t const useful = n / (min_grain > 0 ? min_grain : 1);
+    threads = threads < useful ? threads : useful;
+    return threads > 0 ? threads : 1;
+}
+
+// Calls fn(i) for each i in [0, num_tasks), each on its own thread, except
+// for task 0 which runs on the calling thread. If any task throws, the
+// exception from the lowest-numbered one is rethrown once all have finished.
+template <typename F>
+void parallel_for(std::size_t num_tasks, F const& fn)
+{
+    std::vector<std::exception_ptr> errors(num_tasks);
+    auto run = [&](std::size_t task) {
+        try {
+            fn(task);
+        } catch (...) {
+            errors[task] = std::current_exception();
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(num_tasks > 0 ? num_tasks - 1 : 0);
+        for (std::size_t task = 1; task < num_tasks; ++task) {
+            threads.emplace_back(run, task);
+        }
+        if (num_tasks > 0) {
+            run(0);
+        }
+    }
+
+    for (auto const& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+} // namespace detail
+
+} // namespace tcb
+
+#endif
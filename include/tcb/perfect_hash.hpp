@@ -0,0 +1,233 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_PERFECT_HASH_HPP_INCLUDED
+#define TCB_PERFECT_HASH_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+
+#include <algorithm> // for std::sort
+#include <array>
+#include <bit> // for std::bit_ceil, std::countr_zero, std::endian, std::rotl
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // for std::memcpy
+#include <numeric> // for std::iota
+#include <optional>
+#include <string_view>
+
+// A lookup table from a fixed set of strings, such as keywords or header
+// names, to their indices, built at compile time:
+//
+//     constexpr tcb::perfect_hash methods("GET", "HEAD", "POST", "PUT");
+//     methods.find(token); // std::optional<std::size_t>
+//
+// The table is a perfect hash, built by "hash and displace": the hash of a
+// key picks a bucket, and each bucket has a seed, chosen when the table is
+// built, which sends its keys to slots no other key uses. A lookup is one
+// hash of the string, two table reads, and one comparison with the only key
+// it can be.
+
+namespace tcb {
+
+namespace detail {
+
+inline constexpr std::uint64_t perfect_hash_multiplier = 0x9E3779B97F4A7C15;
+
+// Reads Size bytes from str as a little-endian integer: with memcpy() at run
+// time on little-endian targets, which gives the same words as the shifts do
+// in constant expressions
+template <std::size_t Size>
+constexpr auto load_le(char const* str) noexcept -> std::uint64_t
+{
+    std::uint64_t word = 0;
+    if (std::endian::native == std::endian::little && !std::is_constant_evaluated()) {
+        std::memcpy(&word, str, Size);
+        return word;
+    }
+    for (std::size_t i = 0; i < Size; ++i) {
+        word |= std::uint64_t{static_cast<unsigned char>(str[i])} << (8 * i);
+    }
+    return word;
+}
+
+// A 64-bit hash of a string, usable in constant expressions. Every byte
+// takes part, but the final word overlaps the one before, and shorter
+// strings are read with two overlapping loads, so there are no loops of
+// single bytes.
+constexpr auto keyword_hash(char const* str, std::size_t size) noexcept -> std::uint64_t
+{
+    auto mix = [](std::uint64_t h, std::uint64_t word) {
+        return std::rotl((h ^ word) * perfect_hash_multiplier, 29);
+    };
+    std::uint64_t h = size * perfect_hash_multiplier;
+    if (size >= 8) {
+        for (std::size_t i = 0; i + 8 < size; i += 8) {
+            h = mix(h, load_le<8>(str + i));
+        }
+        h = mix(h, load_le<8>(str + size - 8));
+    } else if (size >= 4) {
+        h = mix(h, load_le<4>(str) | load_le<4>(str + size - 4) << 32);
+    } else if (size > 0) {
+        h = mix(h, load_le<1>(str) | load_le<1>(str + size / 2) << 8
+                       | load_le<1>(str + size - 1) << 16);
+    }
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCD;
+    h ^= h >> 33;
+    return h;
+}
+
+} // namespace detail
+
+template <std::size_t N>
+class perfect_hash {
+private:
+    static constexpr std::size_t num_buckets = std::bit_ceil(N > 0 ? N : 1);
+    // Twice as many slots as buckets keeps the seed search short
+    static constexpr std::size_t num_slots = 2 * num_buckets;
+    static constexpr int slot_shift = 64 - std::countr_zero(num_slots);
+    static constexpr std::uint32_t empty_slot = ~std::uint32_t{0};
+    static constexpr std::uint32_t max_seed = 1 << 20;
+
+    // Not pointer<char const[]>s, as GCC (as of version 12) won't read their
+    // mutable members in constant expressions
+    std::array<char const*, N> key_data_;
+    std::array<std::size_t, N> key_sizes_;
+    std::array<std::uint32_t, num_buckets> seeds_{};
+    std::array<std::uint32_t, num_slots> slots_{};
+
+    static constexpr auto bucket_of(std::uint64_t hash) -> std::size_t
+    {
+        return hash & (num_buckets - 1);
+    }
+
+    static constexpr auto slot_of(std::uint64_t hash, std::uint32_t seed) -> std::size_t
+    {
+        return static_cast<std::size_t>(((hash ^ seed) * detail::perfect_hash_multiplier)
+                                        >> slot_shift);
+    }
+
+    constexpr auto key_view(std::size_t i) const -> std::string_view
+    {
+        return std::string_view(key_data_[i], key_sizes_[i]);
+    }
+
+    // Places the keys of each bucket, largest buckets first, by trying seeds
+    // until one sends all of them to empty slots
+    constexpr void build()
+    {
+        for (std::size_t i = 0; i < N; ++i) {
+            for (std::size_t j = 0; j < i; ++j) {
+                if (key_view(i) == key_view(j)) {
+                    TCB_PTR_RUNTIME_ERROR("Duplicate keys passed to perfect_hash");
+                }
+            }
+        }
+
+        std::array<std::uint64_t, N> hashes{};
+        std::array<std::size_t, num_buckets> sizes{};
+        for (std::size_t i = 0; i < N; ++i) {
+            hashes[i] = detail::keyword_hash(key_data_[i], key_sizes_[i]);
+            ++sizes[bucket_of(hashes[i])];
+        }
+        std::array<std::size_t, num_buckets> order{};
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::sort(order.begin(), order.end(),
+                  [&sizes](std::size_t a, std::size_t b) { return sizes[a] > sizes[b]; });
+
+        slots_.fill(empty_slot);
+        for (std::size_t const bucket : order) {
+            if (sizes[bucket] == 0) {
+                break;
+            }
+            for (std::uint32_t seed = 0;; ++seed) {
+                if (seed == max_seed) {
+                    TCB_PTR_RUNTIME_ERROR("Failed to build a perfect_hash");
+                }
+                if (try_seed(hashes, bucket, seed)) {
+                    seeds_[bucket] = seed;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Places the keys in bucket with seed, or leaves the slots unchanged and
+    // returns false if two of them collide, with each other or an earlier
+    // bucket's key
+    constexpr auto try_seed(std::array<std::uint64_t, N> const& hashes, std::size_t bucket,
+                            std::uint32_t seed) -> bool
+    {
+        for (std::size_t i = 0; i < N; ++i) {
+            if (bucket_of(hashes[i]) != bucket) {
+                continue;
+            }
+            std::size_t const slot = slot_of(hashes[i], seed);
+            if (slots_[slot] != empty_slot) {
+                for (std::size_t j = 0; j < i; ++j) {
+                    if (bucket_of(hashes[j]) == bucket) {
+                        slots_[slot_of(hashes[j], seed)] = empty_slot;
+                    }
+                }
+                return false;
+            }
+            slots_[slot] = static_cast<std::uint32_t>(i);
+        }
+        return true;
+    }
+
+public:
+    // The keys are string literals, whose terminators aren't part of the key
+    template <std::size_t... Sizes>
+        requires(sizeof...(Sizes) == N)
+    consteval explicit perfect_hash(char const (&... keys)[Sizes])
+        : key_data_{keys...}, key_sizes_{(Sizes - 1)...}
+    {
+        build();
+    }
+
+    // The index of key in the list passed to the constructor, if it is one
+    // of them
+    constexpr auto find(pointer<char const[]> const& key) const -> std::optional<std::size_t>
+    {
+        return find(std::string_view(key->data(), key->size()));
+    }
+
+    // For lookups in constant expressions
+    constexpr auto find(std::string_view key) const -> std::optional<std::size_t>
+    {
+        std::uint64_t const hash = detail::keyword_hash(key.data(), key.size());
+        std::uint32_t const index = slots_[slot_of(hash, seeds_[bucket_of(hash)])];
+        if (index == empty_slot || key_view(index) != key) {
+            return std::nullopt;
+        }
+        return index;
+    }
+
+    constexpr auto contains(pointer<char const[]> const& key) const -> bool
+    {
+        return find(key).has_value();
+    }
+
+    constexpr auto contains(std::string_view key) const -> bool { return find(key).has_value(); }
+
+    // The key with index i
+    constexpr auto key(std::size_t i) const -> pointer<char const[]>
+    {
+        if (i >= N) {
+            TCB_PTR_RUNTIME_ERROR("Index out of range in perfect_hash::key()");
+        }
+        return pointer<char const[]>::from_address_with_size(key_data_[i], key_sizes_[i]);
+    }
+
+    static constexpr auto size() -> std::size_t { return N; }
+};
+
+template <std::size_t... Sizes>
+perfect_hash(char const (&... keys)[Sizes]) -> perfect_hash<sizeof...(Sizes)>;
+
+} // namespace tcb
+
+#endif
@@ -38,10 +38,13 @@ DEALINGS IN THE SOFTWARE.
 #    define TCB_PTR_EXPORT export
 #else
 #    define TCB_PTR_EXPORT
-#    include <algorithm> // for std::ranges::equal, std::lexicographical_compare_three_way
+#    include <algorithm> // for std::equal, std::lexicographical_compare_three_way
+#    include <atomic> // for std::atomic_ref
 #    include <compare> // for std::strong_ordering
 #    include <concepts>
 #    include <cstddef>
+#    include <cstdint> // for std::uintptr_t
+#    include <cstring> // for std::memcmp
 #    include <functional> // for std::invoke
 #    include <memory> // for std::addressof
 #    include <optional> // for std::optional<pointer>
@@ -452,8 +455,49 @@ constexpr auto make_end_iterator(T* addr, std::size_t size) -> contiguous_iterat
 #endif
 }
 
+// Types whose order is that of their object representations, so that
+// ranges of them can be compared by memcmp()
+template <typename T>
+concept memcmp_ordered = std::same_as<std::remove_cv_t<T>, unsigned char>
+    || std::same_as<std::remove_cv_t<T>, char8_t> || std::same_as<std::remove_cv_t<T>, std::byte>;
+
 } // namespace detail
 
+// MARK: Atomic slice
+
+// A view of the elements of a slice as atomic objects, returned by
+// slice::atomic_view(). The elements must not be accessed non-atomically
+// while any atomic_slice referring to them exists.
+TCB_PTR_EXPORT template <typename T>
+    requires(std::is_trivially_copyable_v<T> && !std::is_const_v<T>)
+struct TCB_PTR_GSL_POINTER(T) atomic_slice {
+private:
+    T* addr_;
+    std::size_t sz_;
+
+    template <typename U>
+        requires(std::is_object_v<U> && !std::is_const_v<U>)
+    friend struct slice;
+
+    explicit atomic_slice(T* addr, std::size_t sz) : addr_(addr), sz_(sz) { }
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = std::atomic_ref<T>;
+
+    auto operator[](size_type idx) const -> reference
+    {
+        if (idx >= sz_) {
+            TCB_PTR_RUNTIME_ERROR("Index out of bounds in atomic_slice access");
+        }
+        return reference(addr_[idx]);
+    }
+
+    auto size() const -> size_type { return sz_; }
+    auto empty() const -> bool { return sz_ == 0; }
+};
+
 // MARK: Slice
 
 TCB_PTR_EXPORT template <typename T>
@@ -554,6 +598,68 @@ public:
     constexpr auto data() -> pointer { return addr_; }
     constexpr auto data() const -> const_pointer { return addr_; }
 
+    constexpr auto first(size_type count) -> tcb::pointer<T[]>
+    {
+        if (count > sz_) {
+            TCB_PTR_RUNTIME_ERROR("Count out of bounds in slice::first()");
+        }
+        return tcb::pointer<T[]>(addr_, count);
+    }
+
+    constexpr auto first(size_type count) const -> tcb::pointer<T const[]>
+    {
+        if (count > sz_) {
+            TCB_PTR_RUNTIME_ERROR("Count out of bounds in slice::first()");
+        }
+        return tcb::pointer<T const[]>(addr_, count);
+    }
+
+    constexpr auto last(size_type count) -> tcb::pointer<T[]>
+    {
+        if (count > sz_) {
+            TCB_PTR_RUNTIME_ERROR("Count out of bounds in slice::last()");
+        }
+        return tcb::pointer<T[]>(addr_ + (sz_ - count), count);
+    }
+
+    constexpr auto last(size_type count) const -> tcb::pointer<T const[]>
+    {
+        if (count > sz_) {
+            TCB_PTR_RUNTIME_ERROR("Count out of bounds in slice::last()");
+        }
+        return tcb::pointer<T const[]>(addr_ + (sz_ - count), count);
+    }
+
+    constexpr auto subslice(size_type offset, size_type count) -> tcb::pointer<T[]>
+    {
+        if (offset > sz_ || count > sz_ - offset) {
+            TCB_PTR_RUNTIME_ERROR("Offset or count out of bounds in slice::subslice()");
+        }
+        return tcb::pointer<T[]>(addr_ + offset, count);
+    }
+
+    constexpr auto subslice(size_type offset, size_type count) const -> tcb::pointer<T const[]>
+    {
+        if (offset > sz_ || count > sz_ - offset) {
+            TCB_PTR_RUNTIME_ERROR("Offset or count out of bounds in slice::subslice()");
+        }
+        return tcb::pointer<T const[]>(addr_ + offset, count);
+    }
+
+    // Returns a view for concurrent access to the elements. The alignment
+    // required by std::atomic_ref is checked here, once for all elements.
+    auto atomic_view()
+        requires std::is_trivially_copyable_v<T>
+    {
+        constexpr std::size_t align = std::atomic_ref<T>::required_alignment;
+        if constexpr (align > alignof(T)) {
+            if (reinterpret_cast<std::uintptr_t>(addr_) % align != 0) {
+                TCB_PTR_RUNTIME_ERROR("Misaligned slice in slice::atomic_view()");
+            }
+        }
+        return atomic_slice<T>(addr_, sz_);
+    }
+
     constexpr auto begin() -> iterator { return detail::make_begin_iterator(addr_, sz_); }
     constexpr auto begin() const -> const_iterator
     {
@@ -579,15 +685,27 @@ public:
     }
     constexpr auto crend() const -> const_reverse_iterator { return rend(); }
 
+    // Comparisons use raw pointers rather than (checked) iterators: both
+    // ranges are known to be in bounds, and this allows the standard library
+    // to use its memcmp() fast paths where possible. Its three-way compare
+    // only does so without a custom comparator, so <=> calls memcmp() itself
+    // for unsigned byte types.
     friend constexpr auto operator==(slice const& lhs, slice const& rhs) -> bool
         requires std::equality_comparable<T>
     {
-        return std::ranges::equal(lhs, rhs);
+        return std::equal(lhs.addr_, lhs.addr_ + lhs.sz_, rhs.addr_, rhs.addr_ + rhs.sz_);
     }
 
     friend constexpr auto operator<=>(slice const& lhs, slice const& rhs)
         requires std::totally_ordered<T>
     {
+        if constexpr (detail::memcmp_ordered<T>) {
+            if (!std::is_constant_evaluated()) {
+                std::size_t const n = std::min(lhs.sz_, rhs.sz_);
+                int const c = n != 0 ? std::memcmp(lhs.addr_, rhs.addr_, n) : 0;
+                return c != 0 ? c <=> 0 : lhs.sz_ <=> rhs.sz_;
+            }
+        }
         auto cmp = [](const_reference lhs, const_reference rhs) {
             if constexpr (std::three_way_comparable<T>) {
                 return lhs <=> rhs;
@@ -601,8 +719,8 @@ public:
                 }
             }
         };
-        return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(),
-                                                      rhs.end(), cmp);
+        return std::lexicographical_compare_three_way(lhs.addr_, lhs.addr_ + lhs.sz_, rhs.addr_,
+                                                      rhs.addr_ + rhs.sz_, cmp);
     }
 };
 
@@ -624,6 +742,7 @@ private:
     mutable slice_type slice_ = slice_type(nullptr, 0);
 
     friend class std::optional<pointer<T[]>>;
+    friend struct slice<std::remove_const_t<T>>;
 
     // Secret nullptr constructor for use by optional
     constexpr pointer(std::nullptr_t) noexcept { }
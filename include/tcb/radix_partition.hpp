@@ -0,0 +1,299 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_RADIX_PARTITION_HPP_INCLUDED
+#define TCB_RADIX_PARTITION_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+#include <tcb/cpu_dispatch.hpp> // for detail::cache_line_size
+#include <tcb/parallel.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint> // for std::uintptr_t
+#include <cstring> // for std::memcpy
+#include <functional> // for std::invoke
+#include <memory> // for std::unique_ptr
+#include <type_traits>
+#include <utility> // for std::move
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define TCB_PTR_STREAMING_STORES 1
+#    include <emmintrin.h> // for _mm_stream_si128, _mm_sfence
+#else
+#    define TCB_PTR_STREAMING_STORES 0
+#endif
+
+// Radix partitioning: a stable scatter of an array into 2^bits contiguous
+// partitions of an output array, according to the low bits of a key.
+//
+// A histogram pass sizes the partitions, then a scatter pass moves each
+// element to its place. Scattering directly to 2^bits destinations touches
+// that many cache lines (and TLB entries) at once, so for small elements
+// the scatter instead gathers each partition's output into a cache-line
+// sized buffer, and only writes whole aligned lines to the output, using
+// non-temporal stores which bypass the cache. The buffers take 64 bytes per
+// partition, so they stay cache-resident for up to 10 or 11 bits; beyond
+// that, it is better to partition in several passes.
+
+namespace tcb {
+
+namespace detail {
+
+inline constexpr unsigned max_radix_bits = 16;
+inline constexpr std::size_t min_buffered_partitions = 64;
+
+template <typename F, typename T>
+concept radix_key_fn = std::invocable<F const&, T const&>
+    && std::integral<std::remove_cvref_t<std::invoke_result_t<F const&, T const&>>>;
+
+struct alignas(cache_line_size) line_buffer {
+    unsigned char bytes[cache_line_size];
+};
+
+// Copies a buffer to a cache-line-aligned destination, bypassing the cache
+// where possible
+inline void stream_line(void* dst, line_buffer const& src) noexcept
+{
+#if TCB_PTR_STREAMING_STORES
+    auto* d = static_cast<__m128i*>(dst);
+    auto const* s = reinterpret_cast<__m128i const*>(src.bytes);
+    for (std::size_t i = 0; i < cache_line_size / sizeof(__m128i); ++i) {
+        _mm_stream_si128(d + i, _mm_load_si128(s + i));
+    }
+#else
+    std::memcpy(dst, src.bytes, cache_line_size);
+#endif
+}
+
+// Non-temporal stores are weakly ordered, so must be fenced before the
+// data is handed to anyone else
+inline void stream_fence() noexcept
+{
+#if TCB_PTR_STREAMING_STORES
+    _mm_sfence();
+#endif
+}
+
+template <typename T, typename KeyFn>
+auto partition_of(KeyFn const& key_fn, T const& elem, std::size_t mask) -> std::size_t
+{
+    return static_cast<std::size_t>(std::invoke(key_fn, elem)) & mask;
+}
+
+template <typename T, typename KeyFn>
+void radix_histogram(T const* in, std::size_t n, KeyFn const& key_fn, std::size_t mask,
+                     std::size_t* counts)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        ++counts[partition_of(key_fn, in[i], mask)];
+    }
+}
+
+// Partitions whose elements fill exact cache lines can be write-combined
+template <typename T>
+inline constexpr bool write_combinable
+    = sizeof(T) <= cache_line_size && cache_line_size % sizeof(T) == 0;
+
+// Scatters in[0, n) to the output, where partition p's region is
+// out[start[p], ...) and its next free slot is out[cursor[p]]
+template <typename T, typename KeyFn>
+void scatter_direct(T const* in, std::size_t n, KeyFn const& key_fn, std::size_t mask,
+                    std::size_t* cursor, T* out)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        out[cursor[partition_of(key_fn, in[i], mask)]++] = in[i];
+    }
+}
+
+// As above, but through write-combining buffers. Element g of the output
+// lives in slot (g + base) % per_line of its partition's buffer, where base
+// aligns the slots with the output's cache lines. Lines which lie entirely
+// within the region are streamed out whole as soon as they are full; the
+// partial lines at either end of the region (which may be shared with
+// other regions) are copied with ordinary stores.
+template <typename T, typename KeyFn>
+void scatter_buffered(T const* in, std::size_t n, KeyFn const& key_fn, std::size_t mask,
+                      std::size_t const* start, std::size_t* cursor, T* out)
+{
+    constexpr std::size_t per_line = cache_line_size / sizeof(T);
+
+    auto const base
+        = (reinterpret_cast<std::uintptr_t>(out) % cache_line_size) / sizeof(T);
+    auto buffers = std::make_unique<line_buffer[]>(mask + 1);
+
+    auto slot_of = [&](std::size_t g) { return (g + base) % per_line; };
+    auto copy_out = [&](std::size_t p, std::size_t from, std::size_t to) {
+        std::memcpy(out + from, buffers[p].bytes + slot_of(from) * sizeof(T),
+                    (to - from) * sizeof(T));
+    };
+
+    for (std::size_t i = 0; i < n; ++i) {
+        std::size_t const p = partition_of(key_fn, in[i], mask);
+        std::size_t const g = cursor[p]++;
+        std::size_t const slot = slot_of(g);
+        std::memcpy(buffers[p].bytes + slot * sizeof(T), in + i, sizeof(T));
+
+        if (slot == per_line - 1) {
+            if (g + 1 - start[p] >= per_line) {
+                stream_line(out + (g + 1 - per_line), buffers[p]);
+            } else {
+                copy_out(p, start[p], g + 1);
+            }
+        }
+    }
+
+    for (std::size_t p = 0; p <= mask; ++p) {
+        std::size_t const in_line = slot_of(cursor[p]);
+        std::size_t const in_region = cursor[p] - start[p];
+        copy_out(p, cursor[p] - (in_line < in_region ? in_line : in_region), cursor[p]);
+    }
+
+    stream_fence();
+}
+
+template <typename T, typename KeyFn>
+void radix_scatter(T const* in, std::size_t n, KeyFn const& key_fn, std::size_t mask,
+                   std::size_t const* start, std::size_t* cursor, T* out)
+{
+    if constexpr (write_combinable<T>) {
+        // Buffering only pays off when there are too many partitions for
+        // their output lines to stay in L1, and most lines are written whole
+        bool const aligned = reinterpret_cast<std::uintptr_t>(out) % sizeof(T) == 0;
+        if (aligned && mask + 1 >= min_buffered_partitions
+            && n >= (mask + 1) * (cache_line_size / sizeof(T))) {
+            return scatter_buffered(in, n, key_fn, mask, start, cursor, out);
+        }
+    }
+    scatter_direct(in, n, key_fn, mask, cursor, out);
+}
+
+template <typename T>
+auto make_partitions(pointer<T[]> const& out, std::size_t const* counts, std::size_t num)
+    -> std::vector<pointer<T[]>>
+{
+    std::vector<pointer<T[]>> result;
+    result.reserve(num);
+    std::size_t offset = 0;
+    for (std::size_t p = 0; p < num; ++p) {
+        result.push_back(out->subslice(offset, counts[p]));
+        offset += counts[p];
+    }
+    return result;
+}
+
+} // namespace detail
+
+struct radix_partition_t {
+private:
+    // Each parallel task handles at least this many elements
+    static constexpr std::size_t min_grain = 1 << 16;
+
+    template <typename T>
+    static void check_args(T const* in, std::size_t n, unsigned bits, pointer<T[]> const& out)
+    {
+        if (bits > detail::max_radix_bits) {
+            TCB_PTR_RUNTIME_ERROR("Too many bits in radix_partition()");
+        }
+        if (out->size() != n) {
+            TCB_PTR_RUNTIME_ERROR("Size mismatch in radix_partition()");
+        }
+        auto const in_addr = reinterpret_cast<std::uintptr_t>(in);
+        auto const out_addr = reinterpret_cast<std::uintptr_t>(out->data());
+        if (n > 0 && in_addr < out_addr + n * sizeof(T) && out_addr < in_addr + n * sizeof(T)) {
+            TCB_PTR_RUNTIME_ERROR("Input and output overlap in radix_partition()");
+        }
+    }
+
+public:
+    // Partitions in into out, by the low bits of key_fn(elem). Returns the
+    // 2^bits partitions, as consecutive sub-arrays of out. Elements keep
+    // their relative order within each partition.
+    template <typename U, typename T, typename KeyFn>
+        requires std::same_as<std::remove_const_t<U>, T> && std::is_trivially_copyable_v<T>
+        && detail::radix_key_fn<KeyFn, T>
+    auto operator()(pointer<U[]> in, KeyFn const& key_fn, unsigned bits, pointer<T[]> out) const
+        -> std::vector<pointer<T[]>>
+    {
+        T const* first = in->data();
+        std::size_t const n = in->size();
+        check_args(first, n, bits, out);
+
+        std::size_t const num = std::size_t{1} << bits;
+        std::size_t const mask = num - 1;
+
+        std::vector<std::size_t> counts(num);
+        detail::radix_histogram(first, n, key_fn, mask, counts.data());
+
+        std::vector<std::size_t> start(num);
+        for (std::size_t p = 1; p < num; ++p) {
+            start[p] = start[p - 1] + counts[p - 1];
+        }
+        std::vector<std::size_t> cursor = start;
+        detail::radix_scatter(first, n, key_fn, mask, start.data(), cursor.data(), out->data());
+
+        return detail::make_partitions(out, counts.data(), num);
+    }
+
+    // Parallel version. The input is split into one chunk per task; each
+    // task histograms its chunk, and then scatters it to its own region
+    // within each partition, so the result is the same as the sequential
+    // version.
+    template <typename U, typename T, typename KeyFn>
+        requires std::same_as<std::remove_const_t<U>, T> && std::is_trivially_copyable_v<T>
+        && detail::radix_key_fn<KeyFn, T>
+    auto operator()(parallel_t policy, pointer<U[]> in, KeyFn const& key_fn, unsigned bits,
+                    pointer<T[]> out) const -> std::vector<pointer<T[]>>
+    {
+        T const* first = in->data();
+        std::size_t const n = in->size();
+        check_args(first, n, bits, out);
+
+        std::size_t const tasks = detail::task_count(policy, n, min_grain);
+        if (tasks == 1) {
+            return (*this)(std::move(in), key_fn, bits, std::move(out));
+        }
+
+        std::size_t const num = std::size_t{1} << bits;
+        std::size_t const mask = num - 1;
+        auto chunk_begin = [&](std::size_t task) { return n / tasks * task; };
+        auto chunk_end = [&](std::size_t task) {
+            return task + 1 == tasks ? n : chunk_begin(task + 1);
+        };
+
+        // Row t holds task t's counts, and then its starting positions
+        std::vector<std::size_t> counts(tasks * num);
+        detail::parallel_for(tasks, [&](std::size_t t) {
+            detail::radix_histogram(first + chunk_begin(t), chunk_end(t) - chunk_begin(t), key_fn,
+                                    mask, counts.data() + t * num);
+        });
+
+        std::vector<std::size_t> start(tasks * num);
+        std::vector<std::size_t> totals(num);
+        std::size_t offset = 0;
+        for (std::size_t p = 0; p < num; ++p) {
+            for (std::size_t t = 0; t < tasks; ++t) {
+                start[t * num + p] = offset;
+                offset += counts[t * num + p];
+                totals[p] += counts[t * num + p];
+            }
+        }
+
+        std::vector<std::size_t> cursor = start;
+        T* dest = out->data();
+        detail::parallel_for(tasks, [&](std::size_t t) {
+            detail::radix_scatter(first + chunk_begin(t), chunk_end(t) - chunk_begin(t), key_fn,
+                                  mask, start.data() + t * num, cursor.data() + t * num, dest);
+        });
+
+        return detail::make_partitions(out, totals.data(), num);
+    }
+};
+
+inline constexpr auto radix_partition = radix_partition_t{};
+
+} // namespace tcb
+
+#endif
@@ -0,0 +1,242 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_RECORD_BATCH_HPP_INCLUDED
+#define TCB_RECORD_BATCH_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+
+#include <algorithm> // for std::copy_n
+#include <bit> // for std::countr_zero
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// A batch of rows for vectorised query execution: typed columns of equal
+// length, borrowed as pointer<T const[]>s, and an optional selection vector
+// of the indices of the rows still in play.
+//
+// Everything is checked once per batch, when it is made: the columns'
+// lengths, and that the selection's indices are in range. The operators
+// then loop over raw column data. Filtering writes a new selection vector
+// into a buffer the caller provides (which can be the old selection, to
+// filter in place), and projecting picks columns, so neither copies any
+// column data; gather() is the one operator which does, when a dense copy
+// of a column is needed.
+
+namespace tcb {
+
+template <typename... Ts>
+    requires(sizeof...(Ts) > 0)
+class record_batch {
+private:
+    template <typename... Us>
+        requires(sizeof...(Us) > 0)
+    friend class record_batch;
+
+    std::tuple<pointer<Ts const[]>...> columns_;
+    std::size_t num_rows_;
+    std::optional<pointer<std::uint32_t const[]>> selection_;
+
+    template <std::size_t I>
+    using field_t = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    record_batch(std::tuple<pointer<Ts const[]>...> const& columns, std::size_t num_rows,
+                 std::optional<pointer<std::uint32_t const[]>> const& selection)
+        : columns_(columns), num_rows_(num_rows), selection_(selection)
+    {
+    }
+
+    // The batch with the first count entries of out as its selection
+    auto selected(pointer<std::uint32_t[]> const& out, std::size_t count) const -> record_batch
+    {
+        return record_batch(columns_, num_rows_,
+                            pointer<std::uint32_t const[]>(out->first(count)));
+    }
+
+public:
+    // The columns must all have the same length, which must fit in a
+    // selection vector's 32-bit indices
+    explicit record_batch(pointer<Ts const[]>... columns)
+        : columns_(columns...), num_rows_(std::get<0>(columns_)->size())
+    {
+        if (((columns->size() != num_rows_) || ...)) {
+            TCB_PTR_RUNTIME_ERROR("Columns of different lengths passed to record_batch");
+        }
+        if (num_rows_ > UINT32_MAX) {
+            TCB_PTR_RUNTIME_ERROR("Too many rows passed to record_batch");
+        }
+    }
+
+    // The number of rows in the columns
+    auto num_rows() const -> std::size_t { return num_rows_; }
+
+    // The number of selected rows, which is every row if there is no
+    // selection vector
+    auto size() const -> std::size_t { return selection_ ? (*selection_)->size() : num_rows_; }
+
+    auto empty() const -> bool { return size() == 0; }
+
+    static constexpr auto num_columns() -> std::size_t { return sizeof...(Ts); }
+
+    // The whole of column I, including the rows which aren't selected
+    template <std::size_t I>
+        requires(I < sizeof...(Ts))
+    auto column() const -> pointer<field_t<I> const[]>
+    {
+        return std::get<I>(columns_);
+    }
+
+    auto selection() const -> std::optional<pointer<std::uint32_t const[]>> { return selection_; }
+
+    // The same columns with the given selection vector, whose indices are
+    // checked here, once
+    auto with_selection(pointer<std::uint32_t const[]> selection) const -> record_batch
+    {
+        std::uint32_t const* const indices = selection->data();
+        for (std::size_t i = 0; i < selection->size(); ++i) {
+            if (indices[i] >= num_rows_) {
+                TCB_PTR_RUNTIME_ERROR("Out of range index in record_batch selection");
+            }
+        }
+        return record_batch(columns_, num_rows_, selection);
+    }
+
+    // The same columns, with all rows selected
+    auto without_selection() const -> record_batch
+    {
+        return record_batch(columns_, num_rows_, std::nullopt);
+    }
+
+    // The selected rows whose bit is set in bitmap, which has bit i % 64 of
+    // word i / 64 for row i, as a selection vector written to out
+    auto select(pointer<std::uint64_t const[]> bitmap, pointer<std::uint32_t[]> out) const
+        -> record_batch
+    {
+        if (bitmap->size() < (num_rows_ + 63) / 64) {
+            TCB_PTR_RUNTIME_ERROR("Bitmap too small in record_batch::select()");
+        }
+        if (out->size() < size()) {
+            TCB_PTR_RUNTIME_ERROR("Selection buffer too small in record_batch::select()");
+        }
+        std::uint64_t const* const bits = bitmap->data();
+        std::uint32_t* const dest = out->data();
+        std::size_t count = 0;
+        if (selection_) {
+            std::uint32_t const* const indices = (*selection_)->data();
+            std::size_t const n = (*selection_)->size();
+            for (std::size_t i = 0; i < n; ++i) {
+                std::uint32_t const index = indices[i];
+                dest[count] = index;
+                count += (bits[index / 64] >> (index % 64)) & 1;
+            }
+        } else {
+            for (std::size_t word = 0; word * 64 < num_rows_; ++word) {
+                std::uint64_t w = bits[word];
+                if (num_rows_ - word * 64 < 64) {
+                    w &= (std::uint64_t{1} << (num_rows_ - word * 64)) - 1;
+                }
+                for (; w != 0; w &= w - 1) {
+                    dest[count++] = static_cast<std::uint32_t>(
+                        word * 64 + static_cast<std::size_t>(std::countr_zero(w)));
+                }
+            }
+        }
+        return selected(out, count);
+    }
+
+    // The selected rows whose value in column I satisfies pred, as a
+    // selection vector written to out, which may be this batch's own
+    // selection vector
+    template <std::size_t I, typename Pred>
+        requires(I < sizeof...(Ts))
+    auto filter(Pred pred, pointer<std::uint32_t[]> out) const -> record_batch
+    {
+        if (out->size() < size()) {
+            TCB_PTR_RUNTIME_ERROR("Selection buffer too small in record_batch::filter()");
+        }
+        field_t<I> const* const values = std::get<I>(columns_)->data();
+        std::uint32_t* const dest = out->data();
+        std::size_t count = 0;
+        // Branch-free: every row is written, and the count only advances
+        // past those which pass
+        if (selection_) {
+            std::uint32_t const* const indices = (*selection_)->data();
+            std::size_t const n = (*selection_)->size();
+            for (std::size_t i = 0; i < n; ++i) {
+                std::uint32_t const index = indices[i];
+                dest[count] = index;
+                count += static_cast<bool>(pred(values[index]));
+            }
+        } else {
+            for (std::size_t i = 0; i < num_rows_; ++i) {
+                dest[count] = static_cast<std::uint32_t>(i);
+                count += static_cast<bool>(pred(values[i]));
+            }
+        }
+        return selected(out, count);
+    }
+
+    // A batch of columns Is of this one, with the same selection
+    template <std::size_t... Is>
+        requires((Is < sizeof...(Ts)) && ...)
+    auto project() const -> record_batch<field_t<Is>...>
+    {
+        return record_batch<field_t<Is>...>(std::tuple(std::get<Is>(columns_)...), num_rows_,
+                                            selection_);
+    }
+
+    // Copies the selected values of column I to the start of out, and
+    // returns the part of out written
+    template <std::size_t I>
+        requires(I < sizeof...(Ts))
+    auto gather(pointer<field_t<I>[]> out) const -> pointer<field_t<I>[]>
+    {
+        if (out->size() < size()) {
+            TCB_PTR_RUNTIME_ERROR("Output too small in record_batch::gather()");
+        }
+        field_t<I> const* const values = std::get<I>(columns_)->data();
+        field_t<I>* const dest = out->data();
+        std::size_t const n = size();
+        if (selection_) {
+            std::uint32_t const* const indices = (*selection_)->data();
+            for (std::size_t i = 0; i < n; ++i) {
+                dest[i] = values[indices[i]];
+            }
+        } else {
+            std::copy_n(values, n, dest);
+        }
+        return out->first(n);
+    }
+
+    // Calls fn with the values of each selected row, in order
+    template <typename Fn>
+    void for_each_row(Fn fn) const
+    {
+        auto call = [&]<std::size_t... Is>(std::size_t row, std::index_sequence<Is...>) {
+            fn(std::get<Is>(columns_)->data()[row]...);
+        };
+        if (selection_) {
+            std::uint32_t const* const indices = (*selection_)->data();
+            std::size_t const n = (*selection_)->size();
+            for (std::size_t i = 0; i < n; ++i) {
+                call(indices[i], std::index_sequence_for<Ts...>{});
+            }
+        } else {
+            for (std::size_t i = 0; i < num_rows_; ++i) {
+                call(i, std::index_sequence_for<Ts...>{});
+            }
+        }
+    }
+};
+
+template <typename... Ts>
+record_batch(pointer<Ts const[]>...) -> record_batch<Ts...>;
+
+} // namespace tcb
+
+#endif
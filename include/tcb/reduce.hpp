@@ -0,0 +1,486 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_REDUCE_HPP_INCLUDED
+#define TCB_REDUCE_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+#include <tcb/cpu_dispatch.hpp>
+
+#include <algorithm> // for std::ranges::minmax_result
+#include <cmath> // for std::fma
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+
+namespace tcb {
+
+// MARK: Floating-point mode
+
+// Controls whether a floating-point reduction may be reordered.
+//
+// In strict mode elements are combined left-to-right, exactly as
+// std::accumulate() would, so results are reproducible bit-for-bit.
+// In fast mode the work is split across independent accumulators (and dot
+// products may use fused multiply-add), which lets the compiler vectorise
+// the loop at the cost of different rounding.
+//
+// Integer reductions always use the fast path, as reordering them cannot
+// change the result.
+enum class fp_mode { strict, fast };
+
+namespace detail {
+
+template <typename T>
+concept reducible = std::is_arithmetic_v<T> && !std::same_as<T, bool>;
+
+// Reordering a signed sum may overflow where the sequential sum would not,
+// so integers are accumulated in (at least int-width) unsigned arithmetic,
+// which wraps around to the same final result
+template <typename T>
+struct accumulator {
+    using type = T;
+};
+
+template <std::integral T>
+struct accumulator<T> {
+    using type = std::make_unsigned_t<std::common_type_t<T, int>>;
+};
+
+template <typename T>
+using accumulator_t = typename accumulator<T>::type;
+
+// One cache line's worth of independent accumulators: a full register even
+// with AVX-512, and enough of them to hide the latency of each add
+template <typename T>
+inline constexpr std::size_t reduction_lanes = sizeof(T) >= 16 ? 4 : 64 / sizeof(T);
+
+// Fused multiply-add is only used when we know the hardware has it, as the
+// software fallback is very slow
+template <simd_level Level, typename A>
+constexpr auto multiply_add(A acc, A x, A y) -> A
+{
+#ifdef __FMA__
+    constexpr bool has_fma = true;
+#else
+    constexpr bool has_fma = Level != simd_level::baseline;
+#endif
+    if constexpr (std::is_floating_point_v<A> && has_fma) {
+        if (!std::is_constant_evaluated()) {
+            return std::fma(x, y, acc);
+        }
+    }
+    return static_cast<A>(acc + x * y);
+}
+
+struct less_op {
+    template <typename T>
+    constexpr auto operator()(T x, T y) const -> bool
+    {
+        return x < y;
+    }
+};
+
+struct greater_op {
+    template <typename T>
+    constexpr auto operator()(T x, T y) const -> bool
+    {
+        return y < x;
+    }
+};
+
+// MARK: Kernels
+
+template <typename T, typename A>
+constexpr auto sum_sequential(T const* first, std::size_t n, A init) -> A
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        init = static_cast<A>(init + static_cast<A>(first[i]));
+    }
+    return init;
+}
+
+struct sum_kernel {
+    template <typename T, typename A>
+    constexpr auto operator()(T const* first, std::size_t n, A init) const -> A
+    {
+        constexpr std::size_t lanes = reduction_lanes<A>;
+
+        A acc[lanes] = {};
+        std::size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            for (std::size_t j = 0; j < lanes; ++j) {
+                acc[j] = static_cast<A>(acc[j] + static_cast<A>(first[i + j]));
+            }
+        }
+        for (std::size_t j = 0; j < lanes; ++j) {
+            init = static_cast<A>(init + acc[j]);
+        }
+        return sum_sequential(first + i, n - i, init);
+    }
+};
+
+template <typename T, typename A>
+constexpr auto dot_sequential(T const* a, T const* b, std::size_t n, A init) -> A
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        init = static_cast<A>(init + static_cast<A>(a[i]) * static_cast<A>(b[i]));
+    }
+    return init;
+}
+
+struct dot_kernel {
+    template <simd_level Level, typename T, typename A>
+    constexpr auto operator()(simd_level_constant<Level>, T const* a, T const* b, std::size_t n,
+                              A init) const -> A
+    {
+        constexpr std::size_t lanes = reduction_lanes<A>;
+
+        A acc[lanes] = {};
+        std::size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            for (std::size_t j = 0; j < lanes; ++j) {
+                acc[j] = multiply_add<Level>(acc[j], static_cast<A>(a[i + j]),
+                                             static_cast<A>(b[i + j]));
+            }
+        }
+        for (std::size_t j = 0; j < lanes; ++j) {
+            init = static_cast<A>(init + acc[j]);
+        }
+        for (; i < n; ++i) {
+            init = multiply_add<Level>(init, static_cast<A>(a[i]), static_cast<A>(b[i]));
+        }
+        return init;
+    }
+};
+
+// Precondition: n > 0
+template <typename Better, typename T>
+constexpr auto extremum_sequential(T const* first, std::size_t n) -> T
+{
+    T result = first[0];
+    for (std::size_t i = 1; i < n; ++i) {
+        result = Better{}(first[i], result) ? first[i] : result;
+    }
+    return result;
+}
+
+// Precondition: n > 0
+//
+// The select is written so that it maps directly onto min/max instructions
+template <typename Better>
+struct extremum_kernel {
+    template <typename T>
+    constexpr auto operator()(T const* first, std::size_t n) const -> T
+    {
+        constexpr std::size_t lanes = reduction_lanes<T>;
+
+        if (n < lanes) {
+            return extremum_sequential<Better>(first, n);
+        }
+
+        T acc[lanes] = {};
+        for (std::size_t j = 0; j < lanes; ++j) {
+            acc[j] = first[j];
+        }
+        std::size_t i = lanes;
+        for (; i + lanes <= n; i += lanes) {
+            for (std::size_t j = 0; j < lanes; ++j) {
+                acc[j] = Better{}(first[i + j], acc[j]) ? first[i + j] : acc[j];
+            }
+        }
+        T result = extremum_sequential<Better>(acc, lanes);
+        for (; i < n; ++i) {
+            result = Better{}(first[i], result) ? first[i] : result;
+        }
+        return result;
+    }
+};
+
+// Precondition: n > 0
+struct minmax_kernel {
+    template <typename T>
+    constexpr auto operator()(T const* first, std::size_t n) const
+        -> std::ranges::minmax_result<T>
+    {
+        constexpr std::size_t lanes = reduction_lanes<T>;
+
+        if (n < lanes) {
+            return {extremum_sequential<less_op>(first, n),
+                    extremum_sequential<greater_op>(first, n)};
+        }
+
+        T lo[lanes] = {};
+        T hi[lanes] = {};
+        for (std::size_t j = 0; j < lanes; ++j) {
+            lo[j] = hi[j] = first[j];
+        }
+        std::size_t i = lanes;
+        for (; i + lanes <= n; i += lanes) {
+            for (std::size_t j = 0; j < lanes; ++j) {
+                lo[j] = first[i + j] < lo[j] ? first[i + j] : lo[j];
+                hi[j] = hi[j] < first[i + j] ? first[i + j] : hi[j];
+            }
+        }
+        T min = extremum_sequential<less_op>(lo, lanes);
+        T max = extremum_sequential<greater_op>(hi, lanes);
+        for (; i < n; ++i) {
+            min = first[i] < min ? first[i] : min;
+            max = max < first[i] ? first[i] : max;
+        }
+        return {min, max};
+    }
+};
+
+// Precondition: n > 0
+template <typename Better, typename T>
+constexpr auto arg_extremum_sequential(T const* first, std::size_t n) -> std::size_t
+{
+    std::size_t idx = 0;
+    for (std::size_t i = 1; i < n; ++i) {
+        if (Better{}(first[i], first[idx])) {
+            idx = i;
+        }
+    }
+    return idx;
+}
+
+// Precondition: n > 0
+//
+// Finding the index directly needs a loop-carried dependency on the index
+// which defeats vectorisation, so instead we find the value with the
+// (vectorised) extremum kernel, then locate its first occurrence a block at
+// a time. The only way the search can fail is if the input contains NaNs,
+// in which case we fall back to the sequential version.
+template <typename Better>
+struct arg_extremum_kernel {
+    template <typename T>
+    constexpr auto operator()(T const* first, std::size_t n) const -> std::size_t
+    {
+        constexpr std::size_t lanes = reduction_lanes<T>;
+
+        T const value = extremum_kernel<Better>{}(first, n);
+
+        std::size_t i = 0;
+        for (; i + lanes <= n; i += lanes) {
+            bool found = false;
+            for (std::size_t j = 0; j < lanes; ++j) {
+                found |= (first[i + j] == value);
+            }
+            if (found) {
+                break;
+            }
+        }
+        for (; i < n; ++i) {
+            if (first[i] == value) {
+                return i;
+            }
+        }
+        return arg_extremum_sequential<Better>(first, n);
+    }
+};
+
+} // namespace detail
+
+// MARK: Reductions
+
+struct sum_t {
+    template <typename T>
+        requires detail::reducible<T>
+    constexpr auto operator()(slice<T> const& s, fp_mode mode = fp_mode::strict) const -> T
+    {
+        return (*this)(s, T{}, mode);
+    }
+
+    // The type of init is used as the accumulator type, as with std::accumulate
+    template <typename T, typename U>
+        requires detail::reducible<T> && detail::reducible<U>
+        && (std::is_integral_v<T> || std::is_floating_point_v<U>)
+    constexpr auto operator()(slice<T> const& s, U init, fp_mode mode = fp_mode::strict) const
+        -> U
+    {
+        if (std::is_floating_point_v<U> && mode == fp_mode::strict) {
+            return detail::sum_sequential(s.data(), s.size(), init);
+        }
+        using A = detail::accumulator_t<U>;
+        return static_cast<U>(
+            detail::run_kernel<detail::sum_kernel>(s.data(), s.size(), static_cast<A>(init)));
+    }
+
+    template <typename T, typename... Args>
+        requires std::invocable<sum_t const&, slice<std::remove_const_t<T>> const&, Args...>
+    constexpr auto operator()(pointer<T[]> ptr, Args... args) const
+    {
+        return (*this)(*ptr, args...);
+    }
+};
+
+struct dot_t {
+    template <typename T>
+        requires detail::reducible<T>
+    constexpr auto operator()(slice<T> const& a, slice<T> const& b,
+                              fp_mode mode = fp_mode::strict) const -> T
+    {
+        return (*this)(a, b, T{}, mode);
+    }
+
+    template <typename T, typename U>
+        requires detail::reducible<T> && detail::reducible<U>
+        && (std::is_integral_v<T> || std::is_floating_point_v<U>)
+    constexpr auto operator()(slice<T> const& a, slice<T> const& b, U init,
+                              fp_mode mode = fp_mode::strict) const -> U
+    {
+        if (a.size() != b.size()) {
+            TCB_PTR_RUNTIME_ERROR("Slice size mismatch in dot()");
+        }
+        if (std::is_floating_point_v<U> && mode == fp_mode::strict) {
+            return detail::dot_sequential(a.data(), b.data(), a.size(), init);
+        }
+        using A = detail::accumulator_t<U>;
+        return static_cast<U>(detail::run_kernel<detail::dot_kernel>(a.data(), b.data(), a.size(),
+                                                                     static_cast<A>(init)));
+    }
+
+    template <typename T, typename U, typename... Args>
+        requires std::invocable<dot_t const&, slice<std::remove_const_t<T>> const&,
+                                slice<std::remove_const_t<U>> const&, Args...>
+    constexpr auto operator()(pointer<T[]> a, pointer<U[]> b, Args... args) const
+    {
+        return (*this)(*a, *b, args...);
+    }
+};
+
+// In strict mode min() and max() return the same value as std::ranges::min()
+// and std::ranges::max(). In fast mode, the result for a floating-point slice
+// containing NaNs is unspecified.
+struct min_t {
+    template <typename T>
+        requires detail::reducible<T>
+    constexpr auto operator()(slice<T> const& s, fp_mode mode = fp_mode::strict) const -> T
+    {
+        if (s.empty()) {
+            TCB_PTR_RUNTIME_ERROR("min() of empty slice");
+        }
+        if (std::is_floating_point_v<T> && mode == fp_mode::strict) {
+            return detail::extremum_sequential<detail::less_op>(s.data(), s.size());
+        }
+        return detail::run_kernel<detail::extremum_kernel<detail::less_op>>(s.data(), s.size());
+    }
+
+    template <typename T, typename... Args>
+        requires std::invocable<min_t const&, slice<std::remove_const_t<T>> const&, Args...>
+    constexpr auto operator()(pointer<T[]> ptr, Args... args) const
+    {
+        return (*this)(*ptr, args...);
+    }
+};
+
+struct max_t {
+    template <typename T>
+        requires detail::reducible<T>
+    constexpr auto operator()(slice<T> const& s, fp_mode mode = fp_mode::strict) const -> T
+    {
+        if (s.empty()) {
+            TCB_PTR_RUNTIME_ERROR("max() of empty slice");
+        }
+        if (std::is_floating_point_v<T> && mode == fp_mode::strict) {
+            return detail::extremum_sequential<detail::greater_op>(s.data(), s.size());
+        }
+        return detail::run_kernel<detail::extremum_kernel<detail::greater_op>>(s.data(),
+                                                                               s.size());
+    }
+
+    template <typename T, typename... Args>
+        requires std::invocable<max_t const&, slice<std::remove_const_t<T>> const&, Args...>
+    constexpr auto operator()(pointer<T[]> ptr, Args... args) const
+    {
+        return (*this)(*ptr, args...);
+    }
+};
+
+struct minmax_t {
+    template <typename T>
+        requires detail::reducible<T>
+    constexpr auto operator()(slice<T> const& s, fp_mode mode = fp_mode::strict) const
+        -> std::ranges::minmax_result<T>
+    {
+        if (s.empty()) {
+            TCB_PTR_RUNTIME_ERROR("minmax() of empty slice");
+        }
+        if (std::is_floating_point_v<T> && mode == fp_mode::strict) {
+            return {detail::extremum_sequential<detail::less_op>(s.data(), s.size()),
+                    detail::extremum_sequential<detail::greater_op>(s.data(), s.size())};
+        }
+        return detail::run_kernel<detail::minmax_kernel>(s.data(), s.size());
+    }
+
+    template <typename T, typename... Args>
+        requires std::invocable<minmax_t const&, slice<std::remove_const_t<T>> const&, Args...>
+    constexpr auto operator()(pointer<T[]> ptr, Args... args) const
+    {
+        return (*this)(*ptr, args...);
+    }
+};
+
+// argmin() and argmax() return the index of the first smallest (respectively
+// largest) element, matching std::ranges::min_element() and max_element()
+struct argmin_t {
+    template <typename T>
+        requires detail::reducible<T>
+    constexpr auto operator()(slice<T> const& s, fp_mode mode = fp_mode::strict) const
+        -> std::size_t
+    {
+        if (s.empty()) {
+            TCB_PTR_RUNTIME_ERROR("argmin() of empty slice");
+        }
+        if (std::is_floating_point_v<T> && mode == fp_mode::strict) {
+            return detail::arg_extremum_sequential<detail::less_op>(s.data(), s.size());
+        }
+        return detail::run_kernel<detail::arg_extremum_kernel<detail::less_op>>(s.data(),
+                                                                                  s.size());
+    }
+
+    template <typename T, typename... Args>
+        requires std::invocable<argmin_t const&, slice<std::remove_const_t<T>> const&, Args...>
+    constexpr auto operator()(pointer<T[]> ptr, Args... args) const
+    {
+        return (*this)(*ptr, args...);
+    }
+};
+
+struct argmax_t {
+    template <typename T>
+        requires detail::reducible<T>
+    constexpr auto operator()(slice<T> const& s, fp_mode mode = fp_mode::strict) const
+        -> std::size_t
+    {
+        if (s.empty()) {
+            TCB_PTR_RUNTIME_ERROR("argmax() of empty slice");
+        }
+        if (std::is_floating_point_v<T> && mode == fp_mode::strict) {
+            return detail::arg_extremum_sequential<detail::greater_op>(s.data(), s.size());
+        }
+        return detail::run_kernel<detail::arg_extremum_kernel<detail::greater_op>>(s.data(),
+                                                                                     s.size());
+    }
+
+    template <typename T, typename... Args>
+        requires std::invocable<argmax_t const&, slice<std::remove_const_t<T>> const&, Args...>
+    constexpr auto operator()(pointer<T[]> ptr, Args... args) const
+    {
+        return (*this)(*ptr, args...);
+    }
+};
+
+inline constexpr auto sum = sum_t{};
+inline constexpr auto dot = dot_t{};
+inline constexpr auto min = min_t{};
+inline constexpr auto max = max_t{};
+inline constexpr auto minmax = minmax_t{};
+inline constexpr auto argmin = argmin_t{};
+inline constexpr auto argmax = argmax_t{};
+
+} // namespace tcb
+
+#endif
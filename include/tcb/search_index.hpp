@@ -0,0 +1,184 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_SEARCH_INDEX_HPP_INCLUDED
+#define TCB_SEARCH_INDEX_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+#include <tcb/cpu_dispatch.hpp> // for detail::cache_line_size
+
+#include <algorithm> // for std::is_sorted
+#include <bit> // for std::bit_floor, std::bit_width, std::countr_one
+#include <concepts>
+#include <cstddef>
+#include <cstdint> // for std::uintptr_t
+#include <memory> // for std::unique_ptr, std::construct_at
+#include <new> // for std::align_val_t
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#    include <xmmintrin.h> // for _mm_prefetch
+#endif
+
+namespace tcb {
+
+namespace detail {
+
+// Prefetching is only a hint, so the address need not be valid
+inline void prefetch(std::uintptr_t addr) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(reinterpret_cast<void const*>(addr));
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(reinterpret_cast<char const*>(addr), _MM_HINT_T0);
+#else
+    (void)addr;
+#endif
+}
+
+} // namespace detail
+
+// A read-only index over a sorted array, laid out for fast searching.
+//
+// The elements are copied into Eytzinger (breadth-first binary heap) order,
+// so that the first few levels of every search share the same few cache
+// lines, and the descendants of a node several levels down are contiguous
+// and can be prefetched with a single instruction. Searches are branchless
+// apart from the loop condition.
+//
+// Results are positions in the original sorted array, so the index can be
+// used alongside it (or alongside other arrays sorted in the same order).
+template <typename T>
+    requires std::totally_ordered<T> && std::is_trivially_copyable_v<T>
+class search_index {
+private:
+    struct aligned_delete {
+        void operator()(T* ptr) const
+        {
+            ::operator delete(ptr, std::align_val_t{detail::cache_line_size});
+        }
+    };
+
+    // Elements of one cache line, which are the descendants of a node
+    // log2(block) levels further down the tree
+    static constexpr std::size_t block = std::bit_floor(
+        sizeof(T) < detail::cache_line_size ? detail::cache_line_size / sizeof(T) : 1);
+
+    // Searches are interleaved in groups this size in the batched API, so
+    // that their cache misses overlap
+    static constexpr std::size_t batch_size = 16;
+
+    // One-based. Element 0 is a dummy, read by finished searches in the
+    // batched lookup.
+    std::unique_ptr<T[], aligned_delete> tree_;
+    std::vector<std::size_t> rank_;
+    std::size_t size_ = 0;
+
+    void build(T const* sorted, std::size_t& i, std::size_t k)
+    {
+        if (k <= size_) {
+            build(sorted, i, 2 * k);
+            std::construct_at(tree_.get() + k, sorted[i]);
+            rank_[k] = i++;
+            build(sorted, i, 2 * k + 1);
+        }
+    }
+
+    void prefetch_descendants(std::size_t k) const
+    {
+        detail::prefetch(reinterpret_cast<std::uintptr_t>(tree_.get()) + k * block * sizeof(T));
+    }
+
+    // Converts the final node reached by a search into a position
+    auto position(std::size_t k) const -> std::size_t
+    {
+        // The answer is the last node at which we went left
+        k >>= std::countr_one(k) + 1;
+        return k == 0 ? size_ : rank_[k];
+    }
+
+public:
+    explicit search_index(pointer<T const[]> sorted)
+        : rank_(sorted->size() + 1), size_(sorted->size())
+    {
+        T const* first = sorted->data();
+        if (!std::is_sorted(first, first + size_)) {
+            TCB_PTR_RUNTIME_ERROR("Input to search_index is not sorted");
+        }
+
+        std::size_t const bytes = (size_ + 1) * sizeof(T);
+        tree_.reset(
+            static_cast<T*>(::operator new(bytes, std::align_val_t{detail::cache_line_size})));
+        if (size_ > 0) {
+            std::construct_at(tree_.get(), first[0]);
+            std::size_t i = 0;
+            build(first, i, 1);
+        }
+    }
+
+    // The number of elements in the indexed array
+    auto size() const -> std::size_t { return size_; }
+
+    // Returns the position of the first element which is not less than key,
+    // or size() if there is no such element
+    auto lower_bound(T const& key) const -> std::size_t
+    {
+        std::size_t k = 1;
+        while (k <= size_) {
+            prefetch_descendants(k);
+            k = 2 * k + static_cast<std::size_t>(tree_[k] < key);
+        }
+        return position(k);
+    }
+
+    // Batched form of lower_bound(): out[i] receives the position for keys[i]
+    void lower_bound(pointer<T const[]> keys, pointer<std::size_t[]> out) const
+    {
+        if (keys->size() != out->size()) {
+            TCB_PTR_RUNTIME_ERROR("Size mismatch in batched search_index::lower_bound()");
+        }
+
+        T const* key = keys->data();
+        std::size_t* result = out->data();
+        std::size_t remaining = keys->size();
+        int const depth = static_cast<int>(std::bit_width(size_));
+
+        while (remaining > 0) {
+            std::size_t const n = remaining < batch_size ? remaining : batch_size;
+            std::size_t k[batch_size];
+            for (std::size_t j = 0; j < n; ++j) {
+                k[j] = 1;
+            }
+
+            // Every search finishes within depth steps. Those which finish
+            // early stay where they are, re-reading the unused element 0.
+            for (int level = 0; level < depth; ++level) {
+                for (std::size_t j = 0; j < n; ++j) {
+                    bool const active = k[j] <= size_;
+                    std::size_t const node = active ? k[j] : 0;
+                    prefetch_descendants(node);
+                    std::size_t const next
+                        = 2 * node + static_cast<std::size_t>(tree_[node] < key[j]);
+                    k[j] = active ? next : k[j];
+                }
+            }
+
+            for (std::size_t j = 0; j < n; ++j) {
+                result[j] = position(k[j]);
+            }
+
+            key += n;
+            result += n;
+            remaining -= n;
+        }
+    }
+};
+
+template <typename T>
+search_index(pointer<T[]>) -> search_index<std::remove_const_t<T>>;
+
+} // namespace tcb
+
+#endif
@@ -0,0 +1,257 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_SEQLOCK_HPP_INCLUDED
+#define TCB_SEQLOCK_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+#include <tcb/cpu_dispatch.hpp> // for detail::cache_line_size
+#include <tcb/parallel.hpp> // for detail::spin_backoff
+
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // for std::memcpy
+#include <exception> // for std::uncaught_exceptions
+#include <functional> // for std::invoke
+#include <memory> // for std::unique_ptr
+#include <mutex>
+#include <new> // for std::align_val_t
+#include <optional>
+#include <type_traits>
+
+namespace tcb {
+
+// A shared array which is read often and written rarely, protected by a
+// sequence lock.
+//
+// Readers never block writers or each other, and never write to shared
+// memory: they read a sequence number, read the data, and then check that
+// the sequence number hasn't changed (and wasn't odd, meaning that a write
+// was in progress), retrying if it has. Writers are serialised by a mutex.
+//
+// So that a reader racing with a writer is not undefined behaviour, the
+// shared copy of the data is only ever accessed word-by-word with relaxed
+// atomic operations. Writers modify a private staging copy, which is
+// published when they finish.
+template <typename T>
+    requires std::is_trivially_copyable_v<T>
+class seqlock_buffer {
+private:
+    using word = std::uintptr_t;
+
+    static constexpr std::size_t alignment
+        = alignof(T) > detail::cache_line_size ? alignof(T) : detail::cache_line_size;
+
+    struct aligned_delete {
+        void operator()(unsigned char* ptr) const
+        {
+            ::operator delete(ptr, std::align_val_t{alignment});
+        }
+    };
+
+    using storage_ptr = std::unique_ptr<unsigned char[], aligned_delete>;
+
+    // On its own cache line, as it is the only thing readers and writers share
+    alignas(detail::cache_line_size) std::atomic<std::uint64_t> seq_{0};
+
+    alignas(detail::cache_line_size) std::size_t size_;
+    std::size_t words_;
+    storage_ptr shared_;
+    storage_ptr staging_;
+    std::mutex write_mutex_;
+
+    static auto allocate(std::size_t words) -> storage_ptr
+    {
+        return storage_ptr(static_cast<unsigned char*>(
+            ::operator new(words * sizeof(word), std::align_val_t{alignment})));
+    }
+
+    auto shared_word(std::size_t i) const -> std::atomic_ref<word>
+    {
+        return std::atomic_ref<word>(*reinterpret_cast<word*>(shared_.get() + i * sizeof(word)));
+    }
+
+    // Copies the shared data into dest, which has room for size_ elements.
+    // The result may be torn, so must be validated afterwards.
+    void copy_shared(unsigned char* dest) const
+    {
+        std::size_t const bytes = size_ * sizeof(T);
+        std::size_t const whole_words = bytes / sizeof(word);
+        for (std::size_t i = 0; i < whole_words; ++i) {
+            word const w = shared_word(i).load(std::memory_order_relaxed);
+            std::memcpy(dest + i * sizeof(word), &w, sizeof(word));
+        }
+        if (whole_words < words_) {
+            word const w = shared_word(whole_words).load(std::memory_order_relaxed);
+            std::memcpy(dest + whole_words * sizeof(word), &w, bytes % sizeof(word));
+        }
+    }
+
+    // Returns an even sequence number, once no write is in progress
+    auto begin_read() const -> std::uint64_t
+    {
+        std::uint64_t seq = seq_.load(std::memory_order_acquire);
+        detail::spin_backoff backoff;
+        while (seq % 2 != 0) {
+            backoff();
+            seq = seq_.load(std::memory_order_acquire);
+        }
+        return seq;
+    }
+
+    // Whether the data read since begin_read() returned seq is consistent
+    auto validate_read(std::uint64_t seq) const -> bool
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return seq_.load(std::memory_order_relaxed) == seq;
+    }
+
+    // Called with the write mutex held
+    void publish()
+    {
+        std::uint64_t const seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < words_; ++i) {
+            word w;
+            std::memcpy(&w, staging_.get() + i * sizeof(word), sizeof(word));
+            shared_word(i).store(w, std::memory_order_relaxed);
+        }
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Called with the write mutex held, so no-one else can modify the
+    // shared copy
+    void reset_staging() { copy_shared(staging_.get()); }
+
+public:
+    // Exclusive write access to the buffer, returned by writer(). Changes
+    // made through data() become visible to readers, all at once, when the
+    // guard is destroyed, unless it is destroyed by an exception.
+    class write_guard {
+    private:
+        seqlock_buffer* owner_;
+        std::unique_lock<std::mutex> lock_;
+        int exceptions_ = std::uncaught_exceptions();
+
+        friend class seqlock_buffer;
+
+        explicit write_guard(seqlock_buffer& owner) : owner_(&owner), lock_(owner.write_mutex_)
+        {
+            owner_->reset_staging();
+        }
+
+    public:
+        write_guard(write_guard const&) = delete;
+        auto operator=(write_guard const&) -> write_guard& = delete;
+
+        ~write_guard()
+        {
+            if (std::uncaught_exceptions() == exceptions_) {
+                owner_->publish();
+            }
+        }
+
+        // The staging copy, which starts out holding the current contents
+        auto data() const -> pointer<T[]>
+        {
+            return pointer<T[]>::from_address_with_size(
+                reinterpret_cast<T*>(owner_->staging_.get()), owner_->size_);
+        }
+    };
+
+    // Creates a buffer holding a copy of initial
+    explicit seqlock_buffer(pointer<T const[]> initial)
+        : size_(initial->size()),
+          words_((size_ * sizeof(T) + sizeof(word) - 1) / sizeof(word)),
+          shared_(allocate(words_)),
+          staging_(allocate(words_))
+    {
+        if (words_ > 0) {
+            // Zero the padding at the end of the last word
+            std::memset(staging_.get() + (words_ - 1) * sizeof(word), 0, sizeof(word));
+            std::memcpy(staging_.get(), initial->data(), size_ * sizeof(T));
+            std::memcpy(shared_.get(), staging_.get(), words_ * sizeof(word));
+        }
+    }
+
+    seqlock_buffer(seqlock_buffer const&) = delete;
+    auto operator=(seqlock_buffer const&) -> seqlock_buffer& = delete;
+
+    // The number of elements
+    auto size() const -> std::size_t { return size_; }
+
+    // Returns a guard giving write access. Blocks while another writer
+    // holds a guard.
+    [[nodiscard]] auto writer() -> write_guard { return write_guard(*this); }
+
+    // Calls fn with write access to the buffer, and publishes the changes
+    // when it returns
+    template <typename F>
+        requires std::invocable<F&, pointer<T[]>>
+    auto write(F&& fn) -> std::invoke_result_t<F&, pointer<T[]>>
+    {
+        auto guard = writer();
+        return std::invoke(fn, guard.data());
+    }
+
+    // Copies a consistent snapshot of the buffer into out, which must be
+    // the same size
+    void read(pointer<T[]> out) const
+    {
+        if (out->size() != size_) {
+            TCB_PTR_RUNTIME_ERROR("Size mismatch in seqlock_buffer::read()");
+        }
+        auto* dest = reinterpret_cast<unsigned char*>(out->data());
+        while (true) {
+            std::uint64_t const seq = begin_read();
+            copy_shared(dest);
+            if (validate_read(seq)) {
+                return;
+            }
+        }
+    }
+
+    // Calls fn on the shared data in place, without copying it, retrying
+    // until it has seen a consistent snapshot, and returns its result from
+    // that call.
+    //
+    // As fn may run while a write is in progress, it may see a mixture of
+    // old and new values. It must only read the data, must tolerate
+    // inconsistent values (for example, it must not use them to index an
+    // array without checking), and should be short. Unlike read(), this
+    // relies on the same benign data race as every in-place seqlock reader.
+    template <typename F>
+        requires std::invocable<F&, pointer<T const[]>>
+    auto read(F&& fn) const -> std::invoke_result_t<F&, pointer<T const[]>>
+    {
+        using R = std::invoke_result_t<F&, pointer<T const[]>>;
+        auto const data = pointer<T const[]>::from_address_with_size(
+            reinterpret_cast<T const*>(shared_.get()), size_);
+
+        while (true) {
+            std::uint64_t const seq = begin_read();
+            if constexpr (std::is_void_v<R>) {
+                std::invoke(fn, data);
+                if (validate_read(seq)) {
+                    return;
+                }
+            } else {
+                std::optional<R> result(std::invoke(fn, data));
+                if (validate_read(seq)) {
+                    return std::move(*result);
+                }
+            }
+        }
+    }
+};
+
+template <typename T>
+seqlock_buffer(pointer<T[]>) -> seqlock_buffer<std::remove_const_t<T>>;
+
+} // namespace tcb
+
+#endif
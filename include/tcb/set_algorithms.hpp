@@ -0,0 +1,349 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_SET_ALGORITHMS_HPP_INCLUDED
+#define TCB_SET_ALGORITHMS_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+#include <tcb/cpu_dispatch.hpp>
+
+#include <algorithm> // for std::copy, std::lower_bound
+#include <bit> // for std::bit_ceil
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include <utility> // for std::swap
+#include <vector>
+
+// Algorithms on sorted arrays, writing into caller-provided output arrays.
+//
+// Each algorithm checks once, up front, that the output is large enough for
+// the worst case, and returns a pointer to the prefix of the output which
+// was actually written. Inputs must be sorted (and for set_union(), free
+// of duplicates); this is not checked. set_intersection() takes inputs with
+// duplicates, but is fastest without them.
+
+namespace tcb {
+
+namespace detail {
+
+template <typename T>
+concept set_element = std::totally_ordered<T> && std::copyable<T>;
+
+template <typename In, typename Out>
+concept set_input = std::same_as<std::remove_const_t<In>, Out> && !std::is_const_v<Out>;
+
+// When one input is this many times longer than the other, we gallop
+// through the longer one rather than scanning it
+inline constexpr std::size_t gallop_ratio = 32;
+
+// Branchless merge-style intersection. Writing to out[k] before we know
+// whether the elements match is safe, as k never exceeds the number of
+// elements consumed from either input.
+template <typename T>
+constexpr auto intersect_scalar(T const* a, std::size_t na, T const* b, std::size_t nb, T* out)
+    -> std::size_t
+{
+    std::size_t i = 0;
+    std::size_t j = 0;
+    std::size_t k = 0;
+    while (i < na && j < nb) {
+        T const& x = a[i];
+        T const& y = b[j];
+        out[k] = x;
+        k += static_cast<std::size_t>(x == y);
+        i += static_cast<std::size_t>(!(y < x));
+        j += static_cast<std::size_t>(!(x < y));
+    }
+    return k;
+}
+
+// Block-wise intersection. Each block of a is compared against each block
+// of b all-pairs, which vectorises as a broadcast and compare per element
+// of b, and then the matching elements are packed into the output. Blocks
+// are advanced by comparing their last elements.
+//
+// A repeated element would match in every block it was compared against,
+// and could be written more times than the output has room for. So each
+// block is first checked for elements equal to their predecessors, and if
+// there are any, the whole intersection is redone by the scalar loop,
+// which handles duplicates as std::set_intersection() does.
+struct intersect_kernel {
+    template <typename T>
+    constexpr auto operator()(T const* a, std::size_t na, T const* b, std::size_t nb,
+                              T* out) const -> std::size_t
+    {
+        constexpr std::size_t width = 8;
+
+        std::size_t i = 0;
+        std::size_t j = 0;
+        std::size_t k = 0;
+        while (i + width <= na && j + width <= nb) {
+            bool repeated = (i > 0 && a[i - 1] == a[i]) || (j > 0 && b[j - 1] == b[j]);
+            for (std::size_t p = 1; p < width; ++p) {
+                repeated |= (a[i + p - 1] == a[i + p]) | (b[j + p - 1] == b[j + p]);
+            }
+            if (repeated) {
+                return intersect_scalar(a, na, b, nb, out);
+            }
+
+            bool match[width] = {};
+            for (std::size_t q = 0; q < width; ++q) {
+                for (std::size_t p = 0; p < width; ++p) {
+                    match[p] |= (a[i + p] == b[j + q]);
+                }
+            }
+
+            T packed[width] = {};
+            std::size_t count = 0;
+            for (std::size_t p = 0; p < width; ++p) {
+                packed[count] = a[i + p];
+                count += static_cast<std::size_t>(match[p]);
+            }
+            for (std::size_t p = 0; p < count; ++p) {
+                out[k + p] = packed[p];
+            }
+            k += count;
+
+            T const a_last = a[i + width - 1];
+            T const b_last = b[j + width - 1];
+            i += static_cast<std::size_t>(!(b_last < a_last)) * width;
+            j += static_cast<std::size_t>(!(a_last < b_last)) * width;
+        }
+
+        return k + intersect_scalar(a + i, na - i, b + j, nb - j, out + k);
+    }
+};
+
+// Intersection for very different input sizes: for each element of the
+// short input, find its position in the long one with an exponential
+// search starting from where the last one was found.
+template <typename T>
+constexpr auto intersect_galloping(T const* small, std::size_t ns, T const* large,
+                                   std::size_t nl, T* out) -> std::size_t
+{
+    std::size_t j = 0;
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < ns && j < nl; ++i) {
+        T const& x = small[i];
+
+        std::size_t bound = 1;
+        while (j + bound < nl && large[j + bound] < x) {
+            bound *= 2;
+        }
+        std::size_t const last = j + bound < nl ? j + bound + 1 : nl;
+        j = static_cast<std::size_t>(std::lower_bound(large + j + bound / 2, large + last, x)
+                                     - large);
+
+        if (j < nl && !(x < large[j])) {
+            out[k++] = x;
+            ++j;
+        }
+    }
+    return k;
+}
+
+template <typename T>
+constexpr auto merge_scalar(T const* a, std::size_t na, T const* b, std::size_t nb, T* out)
+    -> std::size_t
+{
+    std::size_t i = 0;
+    std::size_t j = 0;
+    std::size_t k = 0;
+    while (i < na && j < nb) {
+        bool const take_b = b[j] < a[i];
+        out[k++] = take_b ? b[j] : a[i];
+        j += static_cast<std::size_t>(take_b);
+        i += static_cast<std::size_t>(!take_b);
+    }
+    T* end = std::copy(a + i, a + na, out + k);
+    end = std::copy(b + j, b + nb, end);
+    return static_cast<std::size_t>(end - out);
+}
+
+template <typename T>
+constexpr auto union_scalar(T const* a, std::size_t na, T const* b, std::size_t nb, T* out)
+    -> std::size_t
+{
+    std::size_t i = 0;
+    std::size_t j = 0;
+    std::size_t k = 0;
+    while (i < na && j < nb) {
+        bool const a_less = a[i] < b[j];
+        bool const b_less = b[j] < a[i];
+        out[k++] = b_less ? b[j] : a[i];
+        i += static_cast<std::size_t>(!b_less);
+        j += static_cast<std::size_t>(!a_less);
+    }
+    T* end = std::copy(a + i, a + na, out + k);
+    end = std::copy(b + j, b + nb, end);
+    return static_cast<std::size_t>(end - out);
+}
+
+// A tournament tree for k-way merging. Each internal node holds the loser
+// of the match played there, so replacing the overall winner only needs
+// one match per level, against the stored losers on the path to the root.
+template <typename T>
+class loser_tree {
+private:
+    // The unconsumed part of each input, including the padding leaves
+    // beyond the real inputs, which start out empty
+    std::vector<T const*> next_;
+    std::vector<T const*> end_;
+    std::vector<std::size_t> tree_;
+
+    // Exhausted inputs lose every match, and ties go to the earlier input,
+    // so the merge is stable
+    auto beats(std::size_t i, std::size_t j) const -> bool
+    {
+        bool const i_done = next_[i] == end_[i];
+        bool const j_done = next_[j] == end_[j];
+        if (i_done || j_done) {
+            return !i_done;
+        }
+        T const& x = *next_[i];
+        T const& y = *next_[j];
+        return x < y || (!(y < x) && i < j);
+    }
+
+public:
+    loser_tree(pointer<T const[]> const* inputs, std::size_t num_inputs)
+        : next_(std::bit_ceil(num_inputs)), end_(next_.size()), tree_(next_.size())
+    {
+        std::size_t const leaves = tree_.size();
+        for (std::size_t i = 0; i < num_inputs; ++i) {
+            next_[i] = inputs[i]->data();
+            end_[i] = next_[i] + inputs[i]->size();
+        }
+
+        // Play the initial tournament bottom-up
+        std::vector<std::size_t> winners(2 * leaves);
+        for (std::size_t i = 0; i < leaves; ++i) {
+            winners[leaves + i] = i;
+        }
+        for (std::size_t node = leaves - 1; node >= 1; --node) {
+            std::size_t const l = winners[2 * node];
+            std::size_t const r = winners[2 * node + 1];
+            bool const l_wins = beats(l, r);
+            winners[node] = l_wins ? l : r;
+            tree_[node] = l_wins ? r : l;
+        }
+        tree_[0] = winners[1];
+    }
+
+    // Precondition: at least one input is not exhausted
+    auto pop() -> T const&
+    {
+        std::size_t winner = tree_[0];
+        T const& value = *next_[winner]++;
+
+        for (std::size_t node = (winner + tree_.size()) / 2; node >= 1; node /= 2) {
+            if (beats(tree_[node], winner)) {
+                std::swap(tree_[node], winner);
+            }
+        }
+        tree_[0] = winner;
+        return value;
+    }
+};
+
+} // namespace detail
+
+struct set_intersection_t {
+    // The output must have room for the shorter of the two inputs
+    template <typename A, typename B, typename T>
+        requires detail::set_input<A, T> && detail::set_input<B, T> && detail::set_element<T>
+    auto operator()(pointer<A[]> a, pointer<B[]> b, pointer<T[]> out) const -> pointer<T[]>
+    {
+        std::size_t const na = a->size();
+        std::size_t const nb = b->size();
+        if (out->size() < (na < nb ? na : nb)) {
+            TCB_PTR_RUNTIME_ERROR("Output too small in set_intersection()");
+        }
+
+        std::size_t count = 0;
+        if (na * detail::gallop_ratio < nb) {
+            count = detail::intersect_galloping(a->data(), na, b->data(), nb, out->data());
+        } else if (nb * detail::gallop_ratio < na) {
+            count = detail::intersect_galloping(b->data(), nb, a->data(), na, out->data());
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            count = detail::run_kernel<detail::intersect_kernel>(
+                static_cast<T const*>(a->data()), na, static_cast<T const*>(b->data()), nb,
+                out->data());
+        } else {
+            count = detail::intersect_scalar(a->data(), na, b->data(), nb, out->data());
+        }
+        return out->first(count);
+    }
+};
+
+struct set_union_t {
+    // The output must have room for both inputs
+    template <typename A, typename B, typename T>
+        requires detail::set_input<A, T> && detail::set_input<B, T> && detail::set_element<T>
+    auto operator()(pointer<A[]> a, pointer<B[]> b, pointer<T[]> out) const -> pointer<T[]>
+    {
+        if (out->size() < a->size() + b->size()) {
+            TCB_PTR_RUNTIME_ERROR("Output too small in set_union()");
+        }
+        return out->first(
+            detail::union_scalar(a->data(), a->size(), b->data(), b->size(), out->data()));
+    }
+};
+
+struct merge_t {
+    // Two-way merge. The output must have room for both inputs. Equal
+    // elements from a precede those from b.
+    template <typename A, typename B, typename T>
+        requires detail::set_input<A, T> && detail::set_input<B, T> && detail::set_element<T>
+    auto operator()(pointer<A[]> a, pointer<B[]> b, pointer<T[]> out) const -> pointer<T[]>
+    {
+        if (out->size() < a->size() + b->size()) {
+            TCB_PTR_RUNTIME_ERROR("Output too small in merge()");
+        }
+        return out->first(
+            detail::merge_scalar(a->data(), a->size(), b->data(), b->size(), out->data()));
+    }
+
+    // k-way merge using a loser tree. The output must have room for all the
+    // inputs. Equal elements keep the order of the inputs they came from.
+    template <typename T>
+        requires detail::set_element<T> && (!std::is_const_v<T>)
+    auto operator()(pointer<pointer<T const[]> const[]> inputs, pointer<T[]> out) const
+        -> pointer<T[]>
+    {
+        std::size_t total = 0;
+        for (auto const& input : *inputs) {
+            total += input->size();
+        }
+        if (out->size() < total) {
+            TCB_PTR_RUNTIME_ERROR("Output too small in merge()");
+        }
+
+        pointer<T const[]> const* first = inputs->data();
+        switch (inputs->size()) {
+        case 0: return out->first(0);
+        case 1:
+            std::copy(first[0]->data(), first[0]->data() + total, out->data());
+            return out->first(total);
+        case 2: return (*this)(first[0], first[1], out);
+        default: break;
+        }
+
+        auto tree = detail::loser_tree<T>(first, inputs->size());
+        T* dest = out->data();
+        for (std::size_t k = 0; k < total; ++k) {
+            dest[k] = tree.pop();
+        }
+        return out->first(total);
+    }
+};
+
+inline constexpr auto set_intersection = set_intersection_t{};
+inline constexpr auto set_union = set_union_t{};
+inline constexpr auto merge = merge_t{};
+
+} // namespace tcb
+
+#endif
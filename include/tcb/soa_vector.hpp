@@ -0,0 +1,391 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_SOA_VECTOR_HPP_INCLUDED
+#define TCB_SOA_VECTOR_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+#include <tcb/cpu_dispatch.hpp> // for detail::cache_line_size
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new> // for std::align_val_t
+#include <stdexcept> // for std::out_of_range
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// A growable array of records stored "struct of arrays": each field has its
+// own contiguous buffer, so a loop over one or two fields reads only their
+// cache lines, not every field's. column<I>() is the whole of field I as a
+// pointer<F[]>, which the slice algorithms and SIMD kernels take directly.
+//
+// Rows are std::tuples of references to the fields, so they can be
+// unpacked with structured bindings:
+//
+//     tcb::soa_vector<float, float, int> particles;
+//     for (auto [x, v, id] : particles) { x += v; }
+
+namespace tcb {
+
+namespace detail {
+
+// Columns start on cache lines, so vector loads of them are aligned
+template <typename T>
+inline constexpr std::size_t column_alignment
+    = alignof(T) > cache_line_size ? alignof(T) : cache_line_size;
+
+// Frees a column's storage, without destroying its elements
+template <typename T>
+struct column_delete {
+    void operator()(T* ptr) const
+    {
+        ::operator delete(ptr, std::align_val_t{column_alignment<T>});
+    }
+};
+
+template <typename T>
+using column_storage = std::unique_ptr<T, column_delete<T>>;
+
+template <typename T>
+auto allocate_column(std::size_t capacity) -> column_storage<T>
+{
+    return column_storage<T>(static_cast<T*>(
+        ::operator new(capacity * sizeof(T), std::align_val_t{column_alignment<T>})));
+}
+
+// The address of the columns of a vector without storage. Nothing is read
+// from it, as they have no elements either.
+template <typename T>
+auto empty_column() -> T*
+{
+    alignas(column_alignment<T>) static std::byte storage[sizeof(T)];
+    return reinterpret_cast<T*>(storage);
+}
+
+} // namespace detail
+
+template <typename... Ts>
+    requires(sizeof...(Ts) > 0 && (std::is_object_v<Ts> && ...)
+             && (std::is_nothrow_move_constructible_v<Ts> && ...))
+class soa_vector {
+private:
+    static constexpr std::size_t min_capacity = 16;
+
+    std::tuple<detail::column_storage<Ts>...> columns_;
+    std::size_t size_ = 0;
+    std::size_t capacity_ = 0;
+
+    template <std::size_t I>
+    using field_t = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    template <std::size_t I>
+    auto column_data() const -> field_t<I>*
+    {
+        field_t<I>* const data = std::get<I>(columns_).get();
+        return data != nullptr ? data : detail::empty_column<field_t<I>>();
+    }
+
+    template <std::size_t... Is>
+    auto row_at(std::size_t i, std::index_sequence<Is...>) const -> std::tuple<Ts&...>
+    {
+        return std::tuple<Ts&...>(std::get<Is>(columns_).get()[i]...);
+    }
+
+    // Moves the elements to new columns of the given capacity. Allocating
+    // may throw, but moving can't, so on failure nothing has changed.
+    template <std::size_t... Is>
+    void reallocate(std::size_t capacity, std::index_sequence<Is...>)
+    {
+        std::tuple<detail::column_storage<Ts>...> columns(
+            detail::allocate_column<Ts>(capacity)...);
+        (relocate(std::get<Is>(columns_).get(), std::get<Is>(columns).get()), ...);
+        columns_ = std::move(columns);
+        capacity_ = capacity;
+    }
+
+    template <typename T>
+    void relocate(T* from, T* to) const noexcept
+    {
+        if (from == nullptr) {
+            return;
+        }
+        std::uninitialized_move_n(from, size_, to);
+        std::destroy_n(from, size_);
+    }
+
+    void grow(std::size_t needed)
+    {
+        std::size_t capacity = capacity_ >= min_capacity ? capacity_ * 2 : min_capacity;
+        reallocate(capacity > needed ? capacity : needed, std::index_sequence_for<Ts...>{});
+    }
+
+    template <std::size_t... Is>
+    void destroy_from(std::size_t first, std::index_sequence<Is...>) noexcept
+    {
+        (std::destroy(std::get<Is>(columns_).get() + first, std::get<Is>(columns_).get() + size_),
+         ...);
+        size_ = first;
+    }
+
+    // Constructs a row from a tuple of fields, which can't throw
+    template <std::size_t... Is>
+    void move_in(std::tuple<Ts...>& fields, std::index_sequence<Is...>) noexcept
+    {
+        (std::construct_at(std::get<Is>(columns_).get() + size_, std::move(std::get<Is>(fields))),
+         ...);
+        ++size_;
+    }
+
+    template <bool Const>
+    class iterator_t {
+    private:
+        using owner = std::conditional_t<Const, soa_vector const, soa_vector>;
+        owner* vec_ = nullptr;
+        std::size_t index_ = 0;
+
+        friend class soa_vector;
+        friend class iterator_t<!Const>;
+
+        iterator_t(owner* vec, std::size_t index) : vec_(vec), index_(index) {}
+
+    public:
+        // Rows are proxies, so the values are too
+        using value_type = std::conditional_t<Const, std::tuple<Ts const&...>, std::tuple<Ts&...>>;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+
+        iterator_t() = default;
+
+        iterator_t(iterator_t<!Const> const& other)
+            requires Const
+            : vec_(other.vec_), index_(other.index_)
+        {
+        }
+
+        // Iterators are checked against the vector's current size, so they
+        // can't be used to read past the end even after elements have been
+        // removed
+        auto operator*() const -> value_type
+        {
+            if (vec_ == nullptr || index_ >= vec_->size_) {
+                TCB_PTR_RUNTIME_ERROR("Dereferenced an out-of-range soa_vector iterator");
+            }
+            return vec_->row_at(index_, std::index_sequence_for<Ts...>{});
+        }
+
+        auto operator[](difference_type n) const -> value_type { return *(*this + n); }
+
+        auto operator++() -> iterator_t&
+        {
+            ++index_;
+            return *this;
+        }
+
+        auto operator++(int) -> iterator_t
+        {
+            auto old = *this;
+            ++index_;
+            return old;
+        }
+
+        auto operator--() -> iterator_t&
+        {
+            --index_;
+            return *this;
+        }
+
+        auto operator--(int) -> iterator_t
+        {
+            auto old = *this;
+            --index_;
+            return old;
+        }
+
+        auto operator+=(difference_type n) -> iterator_t&
+        {
+            index_ += static_cast<std::size_t>(n);
+            return *this;
+        }
+
+        auto operator-=(difference_type n) -> iterator_t&
+        {
+            index_ -= static_cast<std::size_t>(n);
+            return *this;
+        }
+
+        friend auto operator+(iterator_t it, difference_type n) -> iterator_t { return it += n; }
+
+        friend auto operator+(difference_type n, iterator_t it) -> iterator_t { return it += n; }
+
+        friend auto operator-(iterator_t it, difference_type n) -> iterator_t { return it -= n; }
+
+        friend auto operator-(iterator_t const& lhs, iterator_t const& rhs) -> difference_type
+        {
+            return static_cast<difference_type>(lhs.index_ - rhs.index_);
+        }
+
+        friend auto operator==(iterator_t const& lhs, iterator_t const& rhs) -> bool
+        {
+            return lhs.index_ == rhs.index_;
+        }
+
+        friend auto operator<=>(iterator_t const& lhs, iterator_t const& rhs)
+            -> std::strong_ordering
+        {
+            return lhs.index_ <=> rhs.index_;
+        }
+    };
+
+public:
+    using row = std::tuple<Ts&...>;
+    using const_row = std::tuple<Ts const&...>;
+    using iterator = iterator_t<false>;
+    using const_iterator = iterator_t<true>;
+
+    // Allocates nothing until the first row is added or reserve() is called,
+    // as std::vector does
+    soa_vector() noexcept = default;
+
+    // n value-initialised rows
+    explicit soa_vector(std::size_t n) : soa_vector() { resize(n); }
+
+    soa_vector(soa_vector const& other) : soa_vector()
+    {
+        reserve(other.size_);
+        for (auto const& r : other) {
+            std::apply([this](auto const&... fields) { emplace_back(fields...); }, r);
+        }
+    }
+
+    // The moved-from vector is left empty, without storage until it is
+    // next grown, and its columns are empty pointers
+    soa_vector(soa_vector&& other) noexcept
+        : columns_(std::move(other.columns_)),
+          size_(std::exchange(other.size_, 0)),
+          capacity_(std::exchange(other.capacity_, 0))
+    {
+    }
+
+    auto operator=(soa_vector const& other) -> soa_vector&
+    {
+        if (this != &other) {
+            *this = soa_vector(other);
+        }
+        return *this;
+    }
+
+    auto operator=(soa_vector&& other) noexcept -> soa_vector&
+    {
+        if (this != &other) {
+            clear();
+            columns_ = std::move(other.columns_);
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, 0);
+        }
+        return *this;
+    }
+
+    ~soa_vector() { clear(); }
+
+    auto size() const -> std::size_t { return size_; }
+
+    auto capacity() const -> std::size_t { return capacity_; }
+
+    auto empty() const -> bool { return size_ == 0; }
+
+    void reserve(std::size_t capacity)
+    {
+        if (capacity > capacity_) {
+            reallocate(capacity, std::index_sequence_for<Ts...>{});
+        }
+    }
+
+    // Appends a row, constructing each field from the corresponding
+    // argument. If constructing a field throws, the vector is unchanged.
+    template <typename... Us>
+        requires(sizeof...(Us) == sizeof...(Ts) && (std::constructible_from<Ts, Us> && ...))
+    auto emplace_back(Us&&... fields) -> row
+    {
+        // The fields are constructed before they are moved into the
+        // columns, so that a throwing constructor leaves no partial row
+        std::tuple<Ts...> values(std::forward<Us>(fields)...);
+        if (size_ == capacity_) {
+            grow(size_ + 1);
+        }
+        move_in(values, std::index_sequence_for<Ts...>{});
+        return row_at(size_ - 1, std::index_sequence_for<Ts...>{});
+    }
+
+    void push_back(Ts const&... fields) { emplace_back(fields...); }
+
+    void pop_back()
+    {
+        if (size_ == 0) {
+            TCB_PTR_RUNTIME_ERROR("pop_back() called on an empty soa_vector");
+        }
+        destroy_from(size_ - 1, std::index_sequence_for<Ts...>{});
+    }
+
+    // Removes rows from the end, or appends value-initialised ones
+    void resize(std::size_t n)
+        requires(std::default_initializable<Ts> && ...)
+    {
+        if (n < size_) {
+            destroy_from(n, std::index_sequence_for<Ts...>{});
+            return;
+        }
+        reserve(n);
+        while (size_ < n) {
+            emplace_back(Ts()...);
+        }
+    }
+
+    void clear() noexcept { destroy_from(0, std::index_sequence_for<Ts...>{}); }
+
+    // The whole of field I, as an array pointer. Pushing rows may move the
+    // columns, as with std::vector's data().
+    template <std::size_t I>
+        requires(I < sizeof...(Ts))
+    auto column() -> pointer<field_t<I>[]>
+    {
+        return pointer<field_t<I>[]>::from_address_with_size(column_data<I>(), size_);
+    }
+
+    template <std::size_t I>
+        requires(I < sizeof...(Ts))
+    auto column() const -> pointer<field_t<I> const[]>
+    {
+        return pointer<field_t<I> const[]>::from_address_with_size(column_data<I>(), size_);
+    }
+
+    auto operator[](std::size_t i) -> row
+    {
+        if (i >= size_) {
+            TCB_PTR_THROW(std::out_of_range("Index out of bounds in soa_vector access"));
+        }
+        return row_at(i, std::index_sequence_for<Ts...>{});
+    }
+
+    auto operator[](std::size_t i) const -> const_row
+    {
+        if (i >= size_) {
+            TCB_PTR_THROW(std::out_of_range("Index out of bounds in soa_vector access"));
+        }
+        return row_at(i, std::index_sequence_for<Ts...>{});
+    }
+
+    auto begin() -> iterator { return iterator(this, 0); }
+    auto end() -> iterator { return iterator(this, size_); }
+    auto begin() const -> const_iterator { return const_iterator(this, 0); }
+    auto end() const -> const_iterator { return const_iterator(this, size_); }
+};
+
+} // namespace tcb
+
+#endif
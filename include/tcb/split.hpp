@@ -0,0 +1,321 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_SPLIT_HPP_INCLUDED
+#define TCB_SPLIT_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+#include <tcb/cpu_dispatch.hpp>
+#include <tcb/split_records.hpp> // for detail::match_mask
+
+#include <bit> // for std::countr_zero
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+
+#if TCB_PTR_MULTIVERSIONING
+#    include <immintrin.h>
+#endif
+
+// A lazy view of the tokens of a text, separated by any of a set of up to 16
+// delimiter characters.
+//
+// Delimiters are found a 64-byte block at a time, as a bitmask, using the
+// nibble-table character class test: two byte shuffles of the low nibble
+// of each input byte fetch a bitset of the high nibbles which, with it,
+// make a delimiter, and a third shuffle of the high nibble picks the bit to
+// test. This costs the same for any number of delimiters. The iterator
+// keeps the mask of the current block, so the tokens in a block are read
+// off it a set bit at a time.
+
+namespace tcb {
+
+// Whether split() yields the empty tokens between adjacent delimiters, and
+// before a delimiter at the start of the text or after one at the end
+enum class empty_tokens { keep, skip };
+
+namespace detail {
+
+inline constexpr std::size_t max_split_delimiters = 16;
+
+struct char_class {
+    // For each low nibble, the high nibbles which complete a delimiter, in
+    // two tables for high nibbles 0-7 and 8-15
+    alignas(16) std::uint8_t low_tables[2][16] = {};
+    char delimiters[max_split_delimiters] = {};
+    std::size_t count = 0;
+    // The mask of delimiters in a block of match_block_size bytes
+    std::uint64_t (*block_mask)(char const*, char_class const*) = nullptr;
+
+    auto contains(char c) const -> bool
+    {
+        auto const byte = static_cast<unsigned char>(c);
+        return (low_tables[byte >> 7][byte & 0xF] >> ((byte >> 4) & 7)) & 1;
+    }
+};
+
+#if TCB_PTR_MULTIVERSIONING
+TCB_PTR_TARGET_AVX512 inline auto class_mask_avx512(char const* src, char_class const* cls)
+    -> std::uint64_t
+{
+    // The maskz form, as GCC warns that the plain one's (undefined) source
+    // is uninitialised
+    __m512i const table0 = _mm512_maskz_broadcast_i32x4(
+        0xFFFF, _mm_load_si128(reinterpret_cast<__m128i const*>(cls->low_tables[0])));
+    __m512i const table1 = _mm512_maskz_broadcast_i32x4(
+        0xFFFF, _mm_load_si128(reinterpret_cast<__m128i const*>(cls->low_tables[1])));
+    __m512i const bits = _mm512_maskz_broadcast_i32x4(
+        0xFFFF, _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128));
+    __m512i const nibble = _mm512_set1_epi8(0xF);
+
+    __m512i const input = _mm512_loadu_si512(src);
+    __m512i const low = _mm512_and_si512(input, nibble);
+    __m512i const high = _mm512_and_si512(_mm512_srli_epi16(input, 4), nibble);
+    __m512i const row = _mm512_mask_blend_epi8(_mm512_movepi8_mask(input),
+                                               _mm512_shuffle_epi8(table0, low),
+                                               _mm512_shuffle_epi8(table1, low));
+    return _mm512_test_epi8_mask(row, _mm512_shuffle_epi8(bits, high));
+}
+
+TCB_PTR_TARGET_AVX2 inline auto class_mask_avx2_half(__m256i input, __m256i table0,
+                                                     __m256i table1, __m256i bits)
+    -> std::uint32_t
+{
+    __m256i const nibble = _mm256_set1_epi8(0xF);
+    __m256i const low = _mm256_and_si256(input, nibble);
+    __m256i const high = _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble);
+    // blendv picks from table1 where the top bit of the input is set
+    __m256i const row = _mm256_blendv_epi8(_mm256_shuffle_epi8(table0, low),
+                                           _mm256_shuffle_epi8(table1, low), input);
+    __m256i const bit = _mm256_shuffle_epi8(bits, high);
+    __m256i const hit = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(hit));
+}
+
+TCB_PTR_TARGET_AVX2 inline auto class_mask_avx2(char const* src, char_class const* cls)
+    -> std::uint64_t
+{
+    __m256i const table0 = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<__m128i const*>(cls->low_tables[0])));
+    __m256i const table1 = _mm256_broadcastsi128_si256(
+        _mm_load_si128(reinterpret_cast<__m128i const*>(cls->low_tables[1])));
+    __m256i const bits = _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128));
+    __m256i const lo = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src));
+    __m256i const hi = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + 32));
+    return class_mask_avx2_half(lo, table0, table1, bits)
+        | (static_cast<std::uint64_t>(class_mask_avx2_half(hi, table0, table1, bits)) << 32);
+}
+#endif
+
+struct class_mask_kernel {
+    template <simd_level Level>
+    auto operator()(simd_level_constant<Level>, char const* src, char_class const* cls) const
+        -> std::uint64_t
+    {
+        if (cls->count == 1) {
+            return match_mask<Level>(src, cls->delimiters[0]);
+        }
+#if TCB_PTR_MULTIVERSIONING
+        if constexpr (Level == simd_level::avx512) {
+            return class_mask_avx512(src, cls);
+        } else if constexpr (Level == simd_level::avx2) {
+            return class_mask_avx2(src, cls);
+        }
+#endif
+        // A few SWAR comparisons per word beat a table lookup per byte
+        std::uint64_t mask = 0;
+        if (cls->count <= 4) {
+            for (std::size_t i = 0; i < match_block_size; i += 8) {
+                std::uint64_t word = 0;
+                for (std::size_t d = 0; d < cls->count; ++d) {
+                    word |= match_mask_8(src + i, cls->delimiters[d]);
+                }
+                mask |= word << i;
+            }
+        } else {
+            for (std::size_t i = 0; i < match_block_size; ++i) {
+                mask |= static_cast<std::uint64_t>(cls->contains(src[i])) << i;
+            }
+        }
+        return mask;
+    }
+};
+
+} // namespace detail
+
+class split_view : public std::ranges::view_interface<split_view> {
+private:
+    pointer<char const[]> text_;
+    detail::char_class cls_;
+    empty_tokens empty_;
+
+public:
+    class iterator {
+    private:
+        char const* first_ = nullptr;
+        std::size_t size_ = 0;
+        detail::char_class const* cls_ = nullptr;
+        // The current token is [begin_, end_), where end_ is the position
+        // of the delimiter after it, or size_
+        std::size_t begin_ = 0;
+        std::size_t end_ = 0;
+        // The delimiters after end_ in the block starting at block_
+        std::size_t block_ = 0;
+        std::uint64_t mask_ = 0;
+        bool skip_empty_ = false;
+        bool done_ = true;
+
+        friend class split_view;
+
+        explicit iterator(split_view const& view)
+            : first_(view.text_->data()),
+              size_(view.text_->size()),
+              cls_(&view.cls_),
+              skip_empty_(view.empty_ == empty_tokens::skip),
+              done_(size_ == 0)
+        {
+            if (!done_) {
+                load_block();
+                end_ = next_delimiter();
+                skip_empties();
+            }
+        }
+
+        void load_block()
+        {
+            if (block_ + detail::match_block_size <= size_) {
+                mask_ = cls_->block_mask(first_ + block_, cls_);
+            } else {
+                mask_ = 0;
+                for (std::size_t i = block_; i < size_; ++i) {
+                    mask_ |= static_cast<std::uint64_t>(cls_->contains(first_[i])) << (i - block_);
+                }
+            }
+        }
+
+        auto next_delimiter() -> std::size_t
+        {
+            while (mask_ == 0) {
+                block_ += detail::match_block_size;
+                if (block_ >= size_) {
+                    return size_;
+                }
+                load_block();
+            }
+            std::size_t const pos = block_ + static_cast<std::size_t>(std::countr_zero(mask_));
+            mask_ &= mask_ - 1;
+            return pos;
+        }
+
+        void advance()
+        {
+            if (end_ == size_) {
+                done_ = true;
+            } else {
+                begin_ = end_ + 1;
+                end_ = next_delimiter();
+            }
+        }
+
+        void skip_empties()
+        {
+            while (skip_empty_ && !done_ && begin_ == end_) {
+                advance();
+            }
+        }
+
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = pointer<char const[]>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        // The token's position in the text is known to be in bounds, so it
+        // isn't checked again
+        auto operator*() const -> pointer<char const[]>
+        {
+            if (done_) {
+                TCB_PTR_RUNTIME_ERROR("Dereferenced the end iterator of a split_view");
+            }
+            return pointer<char const[]>::from_address_with_size(first_ + begin_, end_ - begin_);
+        }
+
+        auto operator++() -> iterator&
+        {
+            if (done_) {
+                TCB_PTR_RUNTIME_ERROR("Incremented past the end of a split_view");
+            }
+            advance();
+            skip_empties();
+            return *this;
+        }
+
+        auto operator++(int) -> iterator
+        {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        friend auto operator==(iterator const& lhs, iterator const& rhs) -> bool
+        {
+            return lhs.done_ == rhs.done_ && (lhs.done_ || lhs.begin_ == rhs.begin_);
+        }
+
+        friend auto operator==(iterator const& it, std::default_sentinel_t) -> bool
+        {
+            return it.done_;
+        }
+    };
+
+    split_view(pointer<char const[]> text, std::string_view delimiters, empty_tokens empty)
+        : text_(text), empty_(empty)
+    {
+        if (delimiters.empty() || delimiters.size() > detail::max_split_delimiters) {
+            TCB_PTR_RUNTIME_ERROR("Between 1 and 16 delimiters must be passed to split()");
+        }
+        for (char const c : delimiters) {
+            auto const byte = static_cast<unsigned char>(c);
+            auto const bit = static_cast<std::uint8_t>(1 << ((byte >> 4) & 7));
+            cls_.low_tables[byte >> 7][byte & 0xF] |= bit;
+            cls_.delimiters[cls_.count++] = c;
+        }
+        cls_.block_mask = detail::kernel_for<detail::class_mask_kernel, char const*,
+                                             detail::char_class const*>(active_simd_level());
+    }
+
+    // Iterators refer to the view, and must not outlive it
+    auto begin() const -> iterator { return iterator(*this); }
+
+    auto end() const -> std::default_sentinel_t { return {}; }
+};
+
+struct split_t {
+    // A view of the tokens of text separated by any of delimiters, of which
+    // there must be between 1 and 16. Like std::views::split, empty text has
+    // no tokens, and otherwise n delimiters separate n + 1 tokens, some of
+    // which may be empty unless empty_tokens::skip is passed.
+    auto operator()(pointer<char const[]> text, std::string_view delimiters,
+                    empty_tokens empty = empty_tokens::keep) const -> split_view
+    {
+        return split_view(text, delimiters, empty);
+    }
+
+    auto operator()(pointer<char const[]> text, char delimiter,
+                    empty_tokens empty = empty_tokens::keep) const -> split_view
+    {
+        return split_view(text, std::string_view(&delimiter, 1), empty);
+    }
+};
+
+inline constexpr auto split = split_t{};
+
+} // namespace tcb
+
+#endif
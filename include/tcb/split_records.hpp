@@ -0,0 +1,219 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_SPLIT_RECORDS_HPP_INCLUDED
+#define TCB_SPLIT_RECORDS_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+#include <tcb/cpu_dispatch.hpp>
+#include <tcb/parallel.hpp>
+
+#include <bit> // for std::countr_zero
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // for std::memchr, std::memcpy
+#include <vector>
+
+#if TCB_PTR_MULTIVERSIONING
+#    include <immintrin.h>
+#endif
+
+// Splitting text into delimited records, such as the lines of a CSV or JSONL
+// file.
+//
+// The text is scanned in blocks of 64 bytes, building a bitmask of the
+// positions of the delimiter in each block: with one AVX-512 comparison, two
+// AVX2 comparisons, or eight 8-byte SWAR comparisons on the baseline. Records
+// are then read off the mask a set bit at a time, so the cost per record is
+// independent of its length.
+//
+// Records don't include their delimiter. A delimiter at the very end of the
+// text doesn't start another record, so "a\nb\n" and "a\nb" both hold the
+// records "a" and "b", while "a\n\nb" holds "a", "" and "b".
+
+namespace tcb {
+
+namespace detail {
+
+inline constexpr std::size_t match_block_size = 64;
+
+inline auto match_mask_8(char const* src, char c) -> std::uint64_t
+{
+    constexpr std::uint64_t low7 = 0x7F7F7F7F7F7F7F7F;
+    std::uint64_t word = 0;
+    std::memcpy(&word, src, 8);
+    // Exact zero-byte detection: the top bit of each byte of found is set
+    // when that byte of word was c
+    std::uint64_t const pattern
+        = 0x0101010101010101 * static_cast<std::uint64_t>(static_cast<unsigned char>(c));
+    std::uint64_t const x = word ^ pattern;
+    std::uint64_t const found = ~(((x & low7) + low7) | x | low7);
+    // Gathers the top bits into the low byte, in memory order on
+    // little-endian targets
+    if constexpr (std::endian::native == std::endian::little) {
+        return ((found >> 7) * 0x0102040810204080) >> 56;
+    } else {
+        std::uint64_t mask = 0;
+        for (std::size_t i = 0; i < 8; ++i) {
+            mask |= static_cast<std::uint64_t>(src[i] == c) << i;
+        }
+        return mask;
+    }
+}
+
+#if TCB_PTR_MULTIVERSIONING
+TCB_PTR_TARGET_AVX512 inline auto match_mask_avx512(char const* src, char c) -> std::uint64_t
+{
+    return _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(src), _mm512_set1_epi8(c));
+}
+
+TCB_PTR_TARGET_AVX2 inline auto match_mask_avx2(char const* src, char c) -> std::uint64_t
+{
+    __m256i const needle = _mm256_set1_epi8(c);
+    __m256i const lo = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src));
+    __m256i const hi = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + 32));
+    auto const lo_mask
+        = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle)));
+    auto const hi_mask
+        = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle)));
+    return lo_mask | (static_cast<std::uint64_t>(hi_mask) << 32);
+}
+#endif
+
+// Bit i of the result is set if src[i] == c, for a block of
+// match_block_size bytes
+template <simd_level Level>
+auto match_mask(char const* src, char c) -> std::uint64_t
+{
+#if TCB_PTR_MULTIVERSIONING
+    if constexpr (Level == simd_level::avx512) {
+        return match_mask_avx512(src, c);
+    } else if constexpr (Level == simd_level::avx2) {
+        return match_mask_avx2(src, c);
+    }
+#endif
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < match_block_size; i += 8) {
+        mask |= match_mask_8(src + i, c) << i;
+    }
+    return mask;
+}
+
+struct split_records_kernel {
+    template <simd_level Level>
+    void operator()(simd_level_constant<Level>, char const* first, std::size_t n, char delimiter,
+                    std::vector<pointer<char const[]>>* out) const
+    {
+        std::size_t start = 0;
+        auto emit = [&](std::size_t end) {
+            out->push_back(
+                pointer<char const[]>::from_address_with_size(first + start, end - start));
+            start = end + 1;
+        };
+
+        std::size_t i = 0;
+        for (; i + match_block_size <= n; i += match_block_size) {
+            for (std::uint64_t mask = match_mask<Level>(first + i, delimiter); mask != 0;
+                 mask &= mask - 1) {
+                emit(i + static_cast<std::size_t>(std::countr_zero(mask)));
+            }
+        }
+        for (; i < n; ++i) {
+            if (first[i] == delimiter) {
+                emit(i);
+            }
+        }
+        if (start < n) {
+            emit(n);
+        }
+    }
+};
+
+} // namespace detail
+
+struct partition_records_t {
+    // Splits text into at most parts pieces of roughly equal size, each of
+    // which ends just after a delimiter, except for the last, which ends with
+    // the text. Every record is in exactly one piece, and no piece is empty,
+    // so there are fewer pieces than asked for if the records are too long
+    // to go round. This is how to divide a large file between threads.
+    auto operator()(pointer<char const[]> text, std::size_t parts, char delimiter = '\n') const
+        -> std::vector<pointer<char const[]>>
+    {
+        if (parts == 0) {
+            TCB_PTR_RUNTIME_ERROR("Zero parts passed to partition_records()");
+        }
+        char const* const first = text->data();
+        std::size_t const n = text->size();
+
+        std::vector<pointer<char const[]>> pieces;
+        pieces.reserve(parts);
+        std::size_t begin = 0;
+        for (std::size_t k = 1; k < parts && begin < n; ++k) {
+            // Snap to just after the first delimiter at or after the
+            // approximate boundary. Looking from one byte before it catches a
+            // boundary which is already just after a delimiter.
+            std::size_t const target = n / parts * k;
+            std::size_t const from = target > begin ? target - 1 : begin;
+            auto const* const found
+                = static_cast<char const*>(std::memchr(first + from, delimiter, n - from));
+            std::size_t const end = found ? static_cast<std::size_t>(found - first) + 1 : n;
+            if (end > begin) {
+                pieces.push_back(text->subslice(begin, end - begin));
+                begin = end;
+            }
+        }
+        if (begin < n) {
+            pieces.push_back(text->subslice(begin, n - begin));
+        }
+        return pieces;
+    }
+};
+
+inline constexpr auto partition_records = partition_records_t{};
+
+struct split_records_t {
+private:
+    // Each parallel task handles at least this many bytes
+    static constexpr std::size_t min_grain = 1 << 20;
+
+public:
+    // Appends the records of text to out, in order
+    void operator()(pointer<char const[]> text, char delimiter,
+                    std::vector<pointer<char const[]>>& out) const
+    {
+        detail::run_kernel<detail::split_records_kernel>(
+            static_cast<char const*>(text->data()), text->size(), delimiter, &out);
+    }
+
+    // The records of text, in order
+    auto operator()(pointer<char const[]> text, char delimiter = '\n') const
+        -> std::vector<pointer<char const[]>>
+    {
+        std::vector<pointer<char const[]>> records;
+        (*this)(text, delimiter, records);
+        return records;
+    }
+
+    // Parallel version. The text is divided with partition_records(), and
+    // each task splits one piece. Returns the records of each piece, in
+    // order, so that the records can be processed by the same tasks without
+    // being gathered into one array.
+    auto operator()(parallel_t policy, pointer<char const[]> text, char delimiter = '\n') const
+        -> std::vector<std::vector<pointer<char const[]>>>
+    {
+        std::size_t const tasks = detail::task_count(policy, text->size(), min_grain);
+        auto const pieces = partition_records(text, tasks, delimiter);
+        std::vector<std::vector<pointer<char const[]>>> records(pieces.size());
+        detail::parallel_for(pieces.size(),
+                             [&](std::size_t t) { (*this)(pieces[t], delimiter, records[t]); });
+        return records;
+    }
+};
+
+inline constexpr auto split_records = split_records_t{};
+
+} // namespace tcb
+
+#endif
@@ -0,0 +1,314 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_STRING_SORT_HPP_INCLUDED
+#define TCB_STRING_SORT_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+#include <tcb/parallel.hpp>
+
+#include <algorithm>
+#include <bit> // for std::bit_width
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility> // for std::swap
+#include <vector>
+
+// Sorting arrays of strings, in the order given by slice's operator<=>.
+//
+// Comparison sorts compare whole strings, so keys which share long prefixes
+// have the prefixes compared again at every level. This uses multikey
+// quicksort instead, which partitions three ways on the character at the
+// current depth and only moves deeper in the equal part, and so looks at
+// each character of the common prefixes once per partitioning step rather
+// than once per comparison.
+//
+// The "character" here is the next eight bytes of the string, packed
+// big-endian into an integer, and cached beside the string so that
+// partitioning compares integers without following the pointers.
+//
+// As in introsort, the less and greater parts are sorted by recursion with
+// a budget of about 2 log2(n) levels, and a range which exhausts it is
+// finished by std::sort, so that bad pivots cost neither quadratic time nor
+// a stack as deep as the input is long.
+//
+// The parallel version sample-sorts: splitters chosen from a sorted sample
+// divide the keys into one bucket per task, and each task then sorts its
+// bucket.
+
+namespace tcb {
+
+namespace detail {
+
+template <typename C, typename U = std::remove_const_t<C>>
+concept string_sort_char = std::same_as<U, char> || std::same_as<U, signed char>
+    || std::same_as<U, unsigned char> || std::same_as<U, char8_t> || std::same_as<U, std::byte>;
+
+// Below this, insertion sort
+inline constexpr std::size_t string_sort_small = 16;
+
+template <typename C>
+struct string_sort_item {
+    // Bytes [depth, depth + 8) of the string, big-endian, zero-padded
+    std::uint64_t cache;
+    pointer<C[]> str;
+};
+
+// Maps a character to a byte which sorts the same way when compared as
+// unsigned
+template <typename C>
+constexpr auto sort_byte(C c) -> std::uint64_t
+{
+    auto const byte = static_cast<unsigned char>(c);
+    if constexpr (std::is_signed_v<C>) {
+        return byte ^ 0x80u;
+    } else {
+        return byte;
+    }
+}
+
+template <typename C>
+auto load_cache(pointer<C[]> const& str, std::size_t depth) -> std::uint64_t
+{
+    std::size_t const size = str->size();
+    if (depth >= size) {
+        return 0;
+    }
+    C const* const s = str->data() + depth;
+    std::size_t const n = size - depth < 8 ? size - depth : 8;
+    std::uint64_t cache = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        cache |= sort_byte(s[i]) << (56 - 8 * i);
+    }
+    return cache;
+}
+
+// The number of bytes of the string covered by the cache at depth
+template <typename C>
+auto cached_length(pointer<C[]> const& str, std::size_t depth) -> std::size_t
+{
+    std::size_t const size = str->size();
+    return depth >= size ? 0 : size - depth < 8 ? size - depth : 8;
+}
+
+// Compares two strings whose first depth characters are equal
+template <typename C>
+auto compare_from(string_sort_item<C> const& a, string_sort_item<C> const& b, std::size_t depth)
+    -> std::weak_ordering
+{
+    if (a.cache != b.cache) {
+        return a.cache < b.cache ? std::weak_ordering::less : std::weak_ordering::greater;
+    }
+    std::size_t const a_len = cached_length(a.str, depth);
+    std::size_t const b_len = cached_length(b.str, depth);
+    if (a_len < 8 || b_len < 8) {
+        // Equal caches, and one ends within them, so it is a prefix of the
+        // other or equal to it
+        return a_len <=> b_len;
+    }
+    C const* const a_first = a.str->data();
+    C const* const b_first = b.str->data();
+    return std::lexicographical_compare_three_way(a_first + depth + 8, a_first + a.str->size(),
+                                                  b_first + depth + 8, b_first + b.str->size());
+}
+
+template <typename C>
+void insertion_sort_from(string_sort_item<C>* items, std::size_t n, std::size_t depth)
+{
+    for (std::size_t i = 1; i < n; ++i) {
+        string_sort_item<C> item = items[i];
+        std::size_t j = i;
+        for (; j > 0 && compare_from(item, items[j - 1], depth) < 0; --j) {
+            items[j] = items[j - 1];
+        }
+        items[j] = item;
+    }
+}
+
+template <typename C>
+auto median_of_three(string_sort_item<C> const* items, std::size_t n) -> std::uint64_t
+{
+    std::uint64_t a = items[0].cache;
+    std::uint64_t b = items[n / 2].cache;
+    std::uint64_t c = items[n - 1].cache;
+    if (a > b) {
+        std::swap(a, b);
+    }
+    if (b > c) {
+        b = c;
+    }
+    return a > b ? a : b;
+}
+
+// Multikey quicksort of items whose first depth characters are equal, and
+// whose caches are loaded for depth. Each recursion into the less or
+// greater part uses up one level of budget.
+template <typename C>
+void multikey_quicksort(string_sort_item<C>* items, std::size_t n, std::size_t depth,
+                        std::size_t budget)
+{
+    while (n > string_sort_small) {
+        if (budget == 0) {
+            std::sort(items, items + n, [depth](auto const& a, auto const& b) {
+                return compare_from(a, b, depth) < 0;
+            });
+            return;
+        }
+        std::uint64_t const pivot = median_of_three(items, n);
+        std::size_t lt = 0;
+        std::size_t i = 0;
+        std::size_t gt = n;
+        while (i < gt) {
+            std::uint64_t const cache = items[i].cache;
+            if (cache < pivot) {
+                std::swap(items[lt++], items[i++]);
+            } else if (cache > pivot) {
+                std::swap(items[i], items[--gt]);
+            } else {
+                ++i;
+            }
+        }
+        multikey_quicksort(items, lt, depth, budget - 1);
+        multikey_quicksort(items + gt, n - gt, depth, budget - 1);
+
+        // The strings which end within the equal caches come first, shortest
+        // first; the rest carry on at the next depth
+        string_sort_item<C>* const equal = items + lt;
+        std::size_t const num_equal = gt - lt;
+        string_sort_item<C>* const rest = std::partition(
+            equal, equal + num_equal, [depth](auto const& item) {
+                return cached_length(item.str, depth) < 8;
+            });
+        std::sort(equal, rest, [depth](auto const& a, auto const& b) {
+            return cached_length(a.str, depth) < cached_length(b.str, depth);
+        });
+
+        items = rest;
+        n = static_cast<std::size_t>(equal + num_equal - rest);
+        depth += 8;
+        for (std::size_t j = 0; j < n; ++j) {
+            items[j].cache = load_cache(items[j].str, depth);
+        }
+    }
+    insertion_sort_from(items, n, depth);
+}
+
+template <typename C>
+void string_sort_range(pointer<C[]>* first, std::size_t n)
+{
+    std::vector<string_sort_item<C>> items;
+    items.reserve(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        items.push_back({load_cache(first[i], 0), first[i]});
+    }
+    multikey_quicksort(items.data(), n, 0, 2 * static_cast<std::size_t>(std::bit_width(n)));
+    for (std::size_t i = 0; i < n; ++i) {
+        first[i] = items[i].str;
+    }
+}
+
+} // namespace detail
+
+struct string_sort_t {
+private:
+    // Each parallel task sorts at least this many strings
+    static constexpr std::size_t min_grain = 1 << 16;
+    // Sample size per task, for choosing splitters
+    static constexpr std::size_t oversampling = 64;
+
+public:
+    // Sorts keys into the order of their elements' operator<=>, that is,
+    // lexicographically by character, with a string before the longer
+    // strings it is a prefix of. The order of equal strings is unspecified.
+    template <detail::string_sort_char C>
+    void operator()(pointer<pointer<C[]>[]> keys) const
+    {
+        detail::string_sort_range(keys->data(), keys->size());
+    }
+
+    // Parallel version. A sorted sample of the keys provides a splitter for
+    // each task, so that each sorts the keys between two splitters. Many
+    // copies of one key all go to the same task.
+    template <detail::string_sort_char C>
+    void operator()(parallel_t policy, pointer<pointer<C[]>[]> keys) const
+    {
+        pointer<C[]>* const first = keys->data();
+        std::size_t const n = keys->size();
+        std::size_t const tasks = detail::task_count(policy, n, min_grain);
+        if (tasks == 1) {
+            detail::string_sort_range(first, n);
+            return;
+        }
+
+        std::vector<pointer<C[]>> sample;
+        std::size_t const sample_size = tasks * oversampling;
+        sample.reserve(sample_size);
+        for (std::size_t i = 0; i < sample_size; ++i) {
+            sample.push_back(first[n / sample_size * i]);
+        }
+        detail::string_sort_range(sample.data(), sample_size);
+        std::vector<pointer<C[]>> splitters;
+        for (std::size_t t = 1; t < tasks; ++t) {
+            splitters.push_back(sample[t * oversampling]);
+        }
+        auto bucket_of = [&](pointer<C[]> const& key) {
+            auto const it = std::upper_bound(
+                splitters.begin(), splitters.end(), key,
+                [](pointer<C[]> const& a, pointer<C[]> const& b) { return *a < *b; });
+            return static_cast<std::size_t>(it - splitters.begin());
+        };
+
+        // Each task counts the keys of its chunk in each bucket, and then
+        // scatters them to its region of each bucket, as radix_partition()
+        // does
+        auto chunk_begin = [&](std::size_t task) { return n / tasks * task; };
+        auto chunk_end = [&](std::size_t task) {
+            return task + 1 == tasks ? n : chunk_begin(task + 1);
+        };
+        std::vector<std::uint32_t> buckets(n);
+        std::vector<std::size_t> counts(tasks * tasks);
+        detail::parallel_for(tasks, [&](std::size_t t) {
+            for (std::size_t i = chunk_begin(t); i < chunk_end(t); ++i) {
+                auto const b = bucket_of(first[i]);
+                buckets[i] = static_cast<std::uint32_t>(b);
+                ++counts[t * tasks + b];
+            }
+        });
+
+        std::vector<std::size_t> cursor(tasks * tasks);
+        std::vector<std::size_t> bucket_start(tasks + 1);
+        std::size_t offset = 0;
+        for (std::size_t b = 0; b < tasks; ++b) {
+            bucket_start[b] = offset;
+            for (std::size_t t = 0; t < tasks; ++t) {
+                cursor[t * tasks + b] = offset;
+                offset += counts[t * tasks + b];
+            }
+        }
+        bucket_start[tasks] = n;
+
+        std::vector<pointer<C[]>> scattered(first, first + n);
+        detail::parallel_for(tasks, [&](std::size_t t) {
+            for (std::size_t i = chunk_begin(t); i < chunk_end(t); ++i) {
+                scattered[cursor[t * tasks + buckets[i]]++] = first[i];
+            }
+        });
+
+        detail::parallel_for(tasks, [&](std::size_t b) {
+            std::size_t const begin = bucket_start[b];
+            std::size_t const size = bucket_start[b + 1] - begin;
+            detail::string_sort_range(scattered.data() + begin, size);
+            std::copy_n(scattered.data() + begin, size, first + begin);
+        });
+    }
+};
+
+inline constexpr auto string_sort = string_sort_t{};
+
+} // namespace tcb
+
+#endif
@@ -0,0 +1,153 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef TCB_ZSTRING_HPP_INCLUDED
+#define TCB_ZSTRING_HPP_INCLUDED
+
+#include <tcb/pointer.hpp>
+
+#include <atomic> // for std::atomic_ref
+#include <cstddef>
+#include <cstring> // for std::strlen
+#include <ranges>
+#include <string> // for std::char_traits
+
+namespace tcb {
+
+// The end of a zstring_ptr: an iterator equals it when it points at the
+// terminator
+struct zstring_sentinel {
+    friend constexpr auto operator==(char const* it, zstring_sentinel) -> bool
+    {
+        return *it == '\0';
+    }
+};
+
+// A non-null pointer to a null-terminated string, such as one from a C API.
+//
+// Unlike converting to pointer<char const[]>, making a zstring_ptr doesn't
+// measure the string. It can be iterated up to the terminator without ever
+// knowing the length. The length is found the first time size() is called,
+// or the pointer is converted to a pointer<char const[]>, and is remembered
+// by that zstring_ptr (and its later copies). It is measured with strlen(),
+// which the C library vectorises, and unlike our own kernels can read
+// whole aligned blocks past the terminator without upsetting the
+// sanitizers.
+class TCB_PTR_GSL_POINTER(char const) zstring_ptr {
+private:
+    static constexpr std::size_t unknown_size = ~std::size_t{0};
+
+    char const* addr_;
+    // Written at most once, possibly by several threads calling size()
+    // together, so accessed atomically
+    alignas(std::atomic_ref<std::size_t>::required_alignment) mutable std::size_t size_;
+
+    constexpr zstring_ptr(char const* addr, std::size_t size) noexcept : addr_(addr), size_(size)
+    {
+    }
+
+    auto load_size() const noexcept -> std::size_t
+    {
+        return std::atomic_ref<std::size_t>(size_).load(std::memory_order_relaxed);
+    }
+
+    auto measure() const -> std::size_t
+    {
+        std::size_t size = load_size();
+        if (size == unknown_size) {
+            size = std::strlen(addr_);
+            std::atomic_ref<std::size_t>(size_).store(size, std::memory_order_relaxed);
+        }
+        return size;
+    }
+
+    // Constant evaluation can't read a mutable member, so measures every
+    // time instead
+    constexpr auto known_size() const noexcept -> std::size_t
+    {
+        if (std::is_constant_evaluated()) {
+            return unknown_size;
+        }
+        return load_size();
+    }
+
+public:
+    using element_type = char const;
+
+    static constexpr auto from_address(char const* str TCB_PTR_LIFETIME_BOUND) -> zstring_ptr
+    {
+        if (!str) {
+            TCB_PTR_RUNTIME_ERROR("Null passed to zstring_ptr::from_address()");
+        }
+        return zstring_ptr(str, unknown_size);
+    }
+
+    // For a string whose length is already known, such as a std::string's
+    // c_str() and size(). str[size] must be the terminator.
+    static constexpr auto from_address_with_size(char const* str TCB_PTR_LIFETIME_BOUND,
+                                                 std::size_t size) -> zstring_ptr
+    {
+        if (!str) {
+            TCB_PTR_RUNTIME_ERROR("Null passed to zstring_ptr::from_address_with_size()");
+        }
+        if (str[size] != '\0') {
+            TCB_PTR_RUNTIME_ERROR("Missing terminator in zstring_ptr::from_address_with_size()");
+        }
+        return zstring_ptr(str, size);
+    }
+
+    constexpr zstring_ptr(zstring_ptr const& other) noexcept
+        : addr_(other.addr_), size_(other.known_size())
+    {
+    }
+
+    constexpr auto operator=(zstring_ptr const& other) noexcept -> zstring_ptr&
+    {
+        addr_ = other.addr_;
+        size_ = other.known_size();
+        return *this;
+    }
+
+    constexpr auto c_str() const noexcept -> char const* { return addr_; }
+
+    constexpr auto data() const noexcept -> char const* { return addr_; }
+
+    constexpr auto begin() const noexcept -> char const* { return addr_; }
+
+    constexpr auto end() const noexcept -> zstring_sentinel { return {}; }
+
+    // Doesn't need the length
+    constexpr auto empty() const noexcept -> bool { return *addr_ == '\0'; }
+
+    // The length, not counting the terminator, measuring it if it isn't yet
+    // known
+    constexpr auto size() const -> std::size_t
+    {
+        if (std::is_constant_evaluated()) {
+            return std::char_traits<char>::length(addr_);
+        }
+        return measure();
+    }
+
+    // Whether size() has been measured already, and so is free
+    constexpr auto size_known() const noexcept -> bool { return known_size() != unknown_size; }
+
+    // The characters, without the terminator
+    constexpr operator pointer<char const[]>() const
+    {
+        return pointer<char const[]>::from_address_with_size(addr_, size());
+    }
+
+    friend constexpr auto operator==(zstring_ptr const& lhs, zstring_ptr const& rhs) -> bool
+    {
+        return lhs.addr_ == rhs.addr_;
+    }
+};
+
+} // namespace tcb
+
+template <>
+inline constexpr bool std::ranges::enable_borrowed_range<tcb::zstring_ptr> = true;
+
+#endif
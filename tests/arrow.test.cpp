@@ -0,0 +1,244 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <tcb/arrow.hpp>
+
+#include "test_machinery.hpp"
+
+/*
+ * MARK: bit_slice tests
+ */
+
+bool test_bit_slice()
+{
+    std::vector<std::uint8_t> bytes(20, 0xFF);
+    bytes[0] = 0b1010'0101;
+    auto const all = tcb::pointer<std::uint8_t const[]>::from_address_with_size(bytes.data(),
+                                                                                bytes.size());
+
+    tcb::bit_slice const head(all, 0, 8);
+    REQUIRE(head[0] && !head[1] && head[2] && !head[3]);
+    REQUIRE(head.count() == 4);
+
+    // Counts across an unaligned head, whole words and a tail
+    tcb::bit_slice const body(all, 3, 150);
+    REQUIRE(body.size() == 150);
+    REQUIRE(body.count() == 150 - 3);
+
+    tcb::bit_slice const none(all, 160, 0);
+    REQUIRE(none.empty());
+    REQUIRE(none.count() == 0);
+
+    REQUIRE_THROWS_AS(std::out_of_range, head[8]);
+    REQUIRE_ERROR(tcb::bit_slice(all, 1, 160));
+
+    return true;
+}
+
+/*
+ * MARK: Export and import tests
+ */
+
+bool test_round_trip()
+{
+    auto const data = std::make_shared<std::vector<double>>(std::vector{1.0, 2.0, 3.0, 4.0});
+    auto const values = tcb::pointer<double const[]>::from_address_with_size(data->data(),
+                                                                             data->size());
+
+    ArrowSchema schema;
+    ArrowArray array;
+    tcb::arrow_export(values, tcb::ptr_to_mut(schema), tcb::ptr_to_mut(array), data);
+    REQUIRE(std::strcmp(schema.format, "g") == 0);
+    REQUIRE(array.length == 4);
+    REQUIRE(array.null_count == 0);
+    REQUIRE(array.buffers[0] == nullptr);
+    REQUIRE(data.use_count() == 2);
+
+    // The imported column points at the exported data
+    auto const column = tcb::arrow_import<double>(tcb::ptr_to(schema), tcb::ptr_to(array));
+    REQUIRE(column.values == values);
+    REQUIRE(!column.validity);
+    REQUIRE(column.null_count == 0);
+    REQUIRE(column.is_valid(3));
+
+    // Importing as another type fails
+    REQUIRE_THROWS_AS(std::invalid_argument,
+                      tcb::arrow_import<float>(tcb::ptr_to(schema), tcb::ptr_to(array)));
+    REQUIRE_THROWS_AS(std::invalid_argument,
+                      tcb::arrow_import<std::int64_t>(tcb::ptr_to(schema), tcb::ptr_to(array)));
+
+    array.release(&array);
+    schema.release(&schema);
+    REQUIRE(array.release == nullptr);
+    REQUIRE(schema.release == nullptr);
+    REQUIRE(data.use_count() == 1);
+
+    // Released structures can't be imported
+    REQUIRE_THROWS_AS(std::invalid_argument,
+                      tcb::arrow_import<double>(tcb::ptr_to(schema), tcb::ptr_to(array)));
+
+    return true;
+}
+
+bool test_nulls()
+{
+    std::vector<std::int32_t> const data{10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+    // Rows 2 and 9 are null
+    std::vector<std::uint8_t> const bits{0b1111'1011, 0b01};
+    auto const values = tcb::pointer<std::int32_t const[]>::from_address_with_size(data.data(),
+                                                                                   data.size());
+    auto const validity = tcb::pointer<std::uint8_t const[]>::from_address_with_size(bits.data(),
+                                                                                     bits.size());
+
+    ArrowSchema schema;
+    ArrowArray array;
+    tcb::arrow_export(values, validity, tcb::ptr_to_mut(schema), tcb::ptr_to_mut(array));
+    REQUIRE(std::strcmp(schema.format, "i") == 0);
+    REQUIRE((schema.flags & ARROW_FLAG_NULLABLE) != 0);
+    REQUIRE(array.null_count == 2);
+
+    auto const column = tcb::arrow_import<std::int32_t>(tcb::ptr_to(schema), tcb::ptr_to(array));
+    REQUIRE(column.validity);
+    REQUIRE(column.null_count == 2);
+    REQUIRE(!column.is_valid(2));
+    REQUIRE(column.is_valid(3));
+    REQUIRE(!column.is_valid(9));
+
+    // An offset applies to both the values and the bitmap, and an unknown
+    // null count is counted
+    array.offset = 2;
+    array.length = 7;
+    array.null_count = -1;
+    auto const sliced = tcb::arrow_import<std::int32_t>(tcb::ptr_to(schema), tcb::ptr_to(array));
+    REQUIRE(sliced.values->size() == 7);
+    REQUIRE(sliced.values->front() == 12);
+    REQUIRE(!sliced.is_valid(0));
+    REQUIRE(sliced.is_valid(6));
+    REQUIRE(sliced.null_count == 1);
+
+    array.release(&array);
+    schema.release(&schema);
+
+    return true;
+}
+
+bool test_empty()
+{
+    // Producers may pass null buffers for empty arrays
+    char const* const format = "L";
+    void const* buffers[2] = {nullptr, nullptr};
+    ArrowSchema schema{};
+    schema.format = format;
+    schema.release = [](ArrowSchema* s) { s->release = nullptr; };
+    ArrowArray array{};
+    array.n_buffers = 2;
+    array.buffers = buffers;
+    array.release = [](ArrowArray* a) { a->release = nullptr; };
+
+    auto const column = tcb::arrow_import<std::uint64_t>(tcb::ptr_to(schema), tcb::ptr_to(array));
+    REQUIRE(column.values->empty());
+    REQUIRE(column.null_count == 0);
+
+    // Even with an offset, which has nothing to skip
+    array.offset = 5;
+    auto const offset = tcb::arrow_import<std::uint64_t>(tcb::ptr_to(schema), tcb::ptr_to(array));
+    REQUIRE(offset.values->empty());
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    alignas(8) std::int16_t data[8] = {};
+    std::uint8_t bits[1] = {0xFF};
+    void const* buffers[2] = {nullptr, data};
+    ArrowSchema schema{};
+    schema.format = "s";
+    schema.release = [](ArrowSchema* s) { s->release = nullptr; };
+    ArrowArray array{};
+    array.length = 8;
+    array.n_buffers = 2;
+    array.buffers = buffers;
+    array.release = [](ArrowArray* a) { a->release = nullptr; };
+
+    auto const import = [&] {
+        return tcb::arrow_import<std::int16_t>(tcb::ptr_to(schema), tcb::ptr_to(array));
+    };
+    auto const column = import();
+    REQUIRE(column.values->size() == 8);
+
+    // Nulls without a bitmap
+    array.null_count = 1;
+    REQUIRE_THROWS_AS(std::invalid_argument, import());
+    buffers[0] = bits;
+    REQUIRE(import().null_count == 1);
+    array.null_count = 0;
+
+    array.length = -1;
+    REQUIRE_THROWS_AS(std::invalid_argument, import());
+    array.length = 8;
+    array.null_count = 9;
+    REQUIRE_THROWS_AS(std::invalid_argument, import());
+    array.null_count = 0;
+    array.offset = -1;
+    REQUIRE_THROWS_AS(std::invalid_argument, import());
+    array.offset = 0;
+
+    array.n_buffers = 3;
+    REQUIRE_THROWS_AS(std::invalid_argument, import());
+    array.n_buffers = 2;
+
+    buffers[1] = reinterpret_cast<char const*>(data) + 1;
+    REQUIRE_THROWS_AS(std::invalid_argument, import());
+    buffers[1] = nullptr;
+    REQUIRE_THROWS_AS(std::invalid_argument, import());
+    buffers[1] = data;
+
+    schema.format = "+l";
+    REQUIRE_THROWS_AS(std::invalid_argument, import());
+
+    // The bitmap must cover every value
+    std::uint64_t const values[9] = {};
+    ArrowArray out;
+    REQUIRE_ERROR(tcb::arrow_export(
+        tcb::pointer<std::uint64_t const[]>::from_address_with_size(values, 9),
+        tcb::pointer<std::uint8_t const[]>::from_address_with_size(bits, 1),
+        tcb::ptr_to_mut(schema), tcb::ptr_to_mut(out)));
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_bit_slice();
+    REQUIRE(b);
+
+    b = test_round_trip();
+    REQUIRE(b);
+
+    b = test_nulls();
+    REQUIRE(b);
+
+    b = test_empty();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+}
@@ -0,0 +1,341 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <coroutine>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <system_error>
+#include <vector>
+
+#include <tcb/async_io.hpp>
+
+#include "test_machinery.hpp"
+
+#if TCB_PTR_HAVE_ASYNC_IO
+
+#    include "temp_file.hpp"
+
+/*
+ * MARK: Test helpers
+ */
+
+// Whether a detached coroutine finished, and what it threw
+struct coro_status {
+    bool done = false;
+    std::exception_ptr error;
+};
+
+// A coroutine which starts straight away and is never awaited. Its first
+// parameter is where it records its status.
+struct detached {
+    struct promise_type {
+        coro_status* status;
+
+        promise_type(coro_status& s, auto const&...) : status(&s) { }
+
+        auto get_return_object() -> detached { return {}; }
+        auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+        auto final_suspend() noexcept -> std::suspend_never { return {}; }
+        void return_void() { status->done = true; }
+        void unhandled_exception() { status->error = std::current_exception(); }
+    };
+};
+
+auto pattern(std::size_t i) -> std::byte { return static_cast<std::byte>(i * 7 + i / 251); }
+
+auto make_file(std::size_t size) -> std::vector<std::byte>
+{
+    std::vector<std::byte> contents(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        contents[i] = pattern(i);
+    }
+    return contents;
+}
+
+constexpr tcb::io_backend backends[] = {tcb::io_backend::io_uring, tcb::io_backend::thread_pool};
+
+/*
+ * MARK: Callback tests
+ */
+
+bool test_callbacks(tcb::io_backend backend)
+{
+    temp_file file;
+    auto contents = make_file(64 * 1024);
+    auto const src = tcb::ptr_to_mut_array(contents);
+
+    // More operations than the queue depth, so that some have to wait
+    tcb::async_io io({.queue_depth = 4, .backend = backend, .threads = 3});
+    if (backend == tcb::io_backend::thread_pool) {
+        REQUIRE(io.backend() == tcb::io_backend::thread_pool);
+    }
+
+    constexpr std::size_t chunk = 1024;
+    std::size_t written = 0;
+    for (std::size_t off = 0; off < contents.size(); off += chunk) {
+        io.write(file.fd, src->subslice(off, chunk), off, [&](std::error_code ec, std::size_t n) {
+            REQUIRE(!ec);
+            written += n;
+        });
+    }
+    REQUIRE(io.in_flight() == contents.size() / chunk);
+    REQUIRE(written == 0);
+    io.run();
+    REQUIRE(io.in_flight() == 0);
+    REQUIRE(written == contents.size());
+
+    std::vector<std::byte> result(contents.size());
+    auto const dest = tcb::ptr_to_mut_array(result);
+    std::size_t read = 0;
+    for (std::size_t off = 0; off < contents.size(); off += chunk) {
+        io.read(file.fd, dest->subslice(off, chunk), off, [&](std::error_code ec, std::size_t n) {
+            REQUIRE(!ec);
+            read += n;
+        });
+    }
+    while (read < contents.size()) {
+        io.wait();
+    }
+    REQUIRE(result == contents);
+
+    // Short read at the end of the file, and reading past it
+    std::size_t short_read = 1;
+    std::size_t past_end = 1;
+    io.read(file.fd, dest->first(chunk), contents.size() - 10,
+            [&](std::error_code, std::size_t n) { short_read = n; });
+    io.read(file.fd, dest->first(chunk), contents.size() + 10,
+            [&](std::error_code, std::size_t n) { past_end = n; });
+    io.run();
+    REQUIRE(short_read == 10);
+    REQUIRE(past_end == 0);
+
+    // Errors are reported to the callback
+    std::error_code error;
+    io.read(-1, dest, 0, [&](std::error_code ec, std::size_t n) {
+        error = ec;
+        REQUIRE(n == 0);
+    });
+    io.run();
+    REQUIRE(error == std::errc::bad_file_descriptor);
+
+    return true;
+}
+
+bool test_chained_callbacks(tcb::io_backend backend)
+{
+    temp_file file;
+    auto contents = make_file(10'000);
+    auto const src = tcb::ptr_to_mut_array(contents);
+    std::vector<std::byte> result(contents.size());
+    auto const dest = tcb::ptr_to_mut_array(result);
+
+    tcb::async_io io({.backend = backend});
+
+    // Each callback starts the next operation, and run() waits for them all
+    std::size_t offset = 0;
+    auto copy_next = [&](auto& self) -> void {
+        std::size_t const n = std::min<std::size_t>(999, contents.size() - offset);
+        auto then = [&, n](std::error_code ec, std::size_t done) {
+            REQUIRE(!ec);
+            REQUIRE(done == n);
+            offset += n;
+            if (offset < contents.size()) {
+                self(self);
+            }
+        };
+        io.write(file.fd, src->subslice(offset, n), offset, then);
+    };
+    copy_next(copy_next);
+    io.run();
+    REQUIRE(offset == contents.size());
+
+    bool done = false;
+    io.read(file.fd, dest, 0, [&](std::error_code, std::size_t n) { done = n == result.size(); });
+    io.run();
+    REQUIRE(done);
+    REQUIRE(result == contents);
+
+    return true;
+}
+
+/*
+ * MARK: Coroutine tests
+ */
+
+detached copy_file(coro_status&, tcb::async_io& io, int from, int to,
+                   tcb::pointer<std::byte[]> buf, std::size_t size)
+{
+    std::uint64_t offset = 0;
+    while (offset < size) {
+        std::size_t const n = co_await io.read(from, buf, offset);
+        auto const chunk = buf->first(n);
+        std::size_t written = 0;
+        while (written < n) {
+            written += co_await io.write(to, chunk->subslice(written, n - written),
+                                         offset + written);
+        }
+        offset += n;
+    }
+}
+
+detached read_bad_fd(coro_status&, tcb::async_io& io, tcb::pointer<std::byte[]> buf)
+{
+    (void)co_await io.read(-1, buf, 0);
+}
+
+bool test_coroutines(tcb::io_backend backend)
+{
+    temp_file from;
+    auto contents = make_file(100'000);
+    auto const src = tcb::ptr_to_array(contents);
+    tcb::async_io io({.backend = backend});
+
+    bool wrote = false;
+    io.write(from.fd, src, 0, [&](std::error_code ec, std::size_t n) {
+        wrote = !ec && n == contents.size();
+    });
+    io.run();
+    REQUIRE(wrote);
+
+    // Several copies at once, sharing the io
+    constexpr std::size_t copies = 4;
+    temp_file to[copies];
+    std::vector<std::byte> buffers[copies];
+    coro_status status[copies];
+    for (std::size_t i = 0; i < copies; ++i) {
+        buffers[i].resize(4096 + i * 1000);
+        copy_file(status[i], io, from.fd, to[i].fd, tcb::ptr_to_mut_array(buffers[i]),
+                  contents.size());
+        REQUIRE(!status[i].done);
+    }
+    REQUIRE(io.in_flight() == copies);
+    io.run();
+
+    for (std::size_t i = 0; i < copies; ++i) {
+        REQUIRE(status[i].done);
+        REQUIRE(!status[i].error);
+        std::vector<std::byte> result(contents.size() + 1);
+        REQUIRE(::pread(to[i].fd, result.data(), result.size(), 0)
+                == static_cast<::ssize_t>(contents.size()));
+        result.pop_back();
+        REQUIRE(result == contents);
+    }
+
+    // Errors are thrown from co_await
+    coro_status bad;
+    read_bad_fd(bad, io, tcb::ptr_to_mut_array(buffers[0]));
+    io.run();
+    REQUIRE(!bad.done);
+    REQUIRE(bad.error);
+    REQUIRE_THROWS_AS(std::system_error, std::rethrow_exception(bad.error));
+
+    return true;
+}
+
+/*
+ * MARK: Registered buffer tests
+ */
+
+bool test_registered_buffers(tcb::io_backend backend)
+{
+    temp_file file;
+    auto contents = make_file(32 * 1024);
+    auto const src = tcb::ptr_to_array(contents);
+
+    tcb::async_io io({.backend = backend});
+    std::vector<std::byte> storage[2];
+    storage[0].resize(16 * 1024);
+    storage[1].resize(16 * 1024);
+    tcb::pointer<std::byte[]> const buffers[] = {tcb::ptr_to_mut_array(storage[0]),
+                                                 tcb::ptr_to_mut_array(storage[1])};
+
+    bool const registered = io.register_buffers(tcb::ptr_to_array(buffers));
+    if (io.backend() == tcb::io_backend::thread_pool) {
+        REQUIRE(!registered);
+    }
+
+    // Writes from and reads into parts of the registered buffers, and an
+    // unregistered one, work the same whether or not registering succeeded
+    std::copy(contents.begin(), contents.begin() + 16 * 1024, storage[0].begin());
+    std::copy(contents.begin() + 16 * 1024, contents.end(), storage[1].begin());
+    std::size_t total = 0;
+    auto count = [&](std::error_code ec, std::size_t n) {
+        REQUIRE(!ec);
+        total += n;
+    };
+    io.write(file.fd, buffers[0], 0, count);
+    io.write(file.fd, buffers[1]->first(8 * 1024), 16 * 1024, count);
+    io.write(file.fd, src->subslice(24 * 1024, 8 * 1024), 24 * 1024, count);
+    io.run();
+    REQUIRE(total == contents.size());
+
+    std::ranges::fill(storage[0], std::byte{0});
+    std::ranges::fill(storage[1], std::byte{0});
+    total = 0;
+    io.read(file.fd, buffers[1], 0, count);
+    io.read(file.fd, buffers[0]->subslice(100, 16 * 1024 - 100), 16 * 1024 + 100, count);
+    io.run();
+    REQUIRE(total == contents.size() - 100);
+    auto const expected_first = src->first(16 * 1024);
+    auto const expected_second = src->subslice(16 * 1024 + 100, 16 * 1024 - 100);
+    auto const got_second = buffers[0]->subslice(100, 16 * 1024 - 100);
+    REQUIRE(std::ranges::equal(storage[1], *expected_first));
+    REQUIRE(std::ranges::equal(*got_second, *expected_second));
+
+    // Registering again replaces the old buffers
+    auto const all = tcb::ptr_to_array(buffers);
+    REQUIRE(io.register_buffers(all->first(1)) == registered);
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    REQUIRE_ERROR(tcb::async_io({.queue_depth = 0}));
+
+    std::vector<std::byte> storage(100);
+    tcb::pointer<std::byte[]> const buffers[] = {tcb::ptr_to_mut_array(storage)};
+    tcb::async_io io;
+    io.read(-1, buffers[0], 0, [](std::error_code, std::size_t) { });
+    REQUIRE_ERROR(io.register_buffers(tcb::ptr_to_array(buffers)));
+    io.run();
+
+    return true;
+}
+
+#endif // TCB_PTR_HAVE_ASYNC_IO
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+#if TCB_PTR_HAVE_ASYNC_IO
+    bool b = true;
+
+    for (auto backend : backends) {
+        b = test_callbacks(backend);
+        REQUIRE(b);
+
+        b = test_chained_callbacks(backend);
+        REQUIRE(b);
+
+        b = test_coroutines(backend);
+        REQUIRE(b);
+
+        b = test_registered_buffers(backend);
+        REQUIRE(b);
+    }
+
+    b = test_errors();
+    REQUIRE(b);
+#endif
+}
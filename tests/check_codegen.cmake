@@ -0,0 +1,44 @@
+# Compiles SOURCE to assembly with optimisation, and fails if any function
+# whose name contains "codegen_" calls, branches or traps, that is, if it
+# is more than loads, stores and a return.
+#
+# Usage: cmake -DCXX=<compiler> -DINCLUDE_DIR=<dir> -DSOURCE=<file>
+#              -DOUTPUT=<file.s> -P check_codegen.cmake
+
+execute_process(
+    COMMAND ${CXX} -std=c++20 -O2 -DNDEBUG -I${INCLUDE_DIR} -S -o ${OUTPUT} ${SOURCE}
+    RESULT_VARIABLE result
+    ERROR_VARIABLE errors
+)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "Compiling ${SOURCE} failed:\n${errors}")
+endif()
+
+# x86-64 and AArch64 calls, branches and traps
+set(forbidden "^[ \t]+(call|j[a-z]+|ud2|int3|bl|blr|br|b|b\\.[a-z]+|cbn?z|tbn?z|brk|udf)([ \t]|$)")
+
+file(STRINGS ${OUTPUT} lines)
+set(function "")
+set(checked 0)
+set(failed "")
+foreach(line IN LISTS lines)
+    if(line MATCHES "^([_A-Za-z0-9$.]*codegen_[_A-Za-z0-9$.]*):")
+        set(function ${CMAKE_MATCH_1})
+        math(EXPR checked "${checked} + 1")
+    elseif(function STREQUAL "")
+        continue()
+    elseif(line MATCHES "^[ \t]*\\.cfi_endproc" OR line MATCHES "^[ \t]*\\.size[ \t]")
+        set(function "")
+    elseif(line MATCHES "${forbidden}")
+        list(APPEND failed "${function}: ${line}")
+    endif()
+endforeach()
+
+if(checked EQUAL 0)
+    message(FATAL_ERROR "No codegen_ functions found in ${OUTPUT}")
+endif()
+if(failed)
+    list(JOIN failed "\n" failed)
+    message(FATAL_ERROR "Conversions which should compile to nothing don't:\n${failed}")
+endif()
+message(STATUS "${checked} functions compile to nothing but moves")
@@ -0,0 +1,323 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <ranges>
+#include <string>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <tcb/chunked_reader.hpp>
+
+#include "test_machinery.hpp"
+
+#if TCB_PTR_HAVE_ASYNC_IO
+
+#    include "temp_file.hpp"
+
+static_assert(std::ranges::input_range<tcb::chunk_generator>);
+
+/*
+ * MARK: Test helpers
+ */
+
+auto make_bytes(std::size_t size) -> std::vector<std::byte>
+{
+    std::vector<std::byte> bytes(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        bytes[i] = static_cast<std::byte>(i * 13 + i / 256);
+    }
+    return bytes;
+}
+
+// Lines of varying lengths, the last one unterminated
+auto make_lines(std::size_t count) -> std::vector<std::byte>
+{
+    std::vector<std::byte> bytes;
+    for (std::size_t i = 0; i < count; ++i) {
+        std::string const line = "line " + std::to_string(i) + std::string(i % 37, 'x');
+        for (char c : line) {
+            bytes.push_back(static_cast<std::byte>(c));
+        }
+        if (i + 1 < count) {
+            bytes.push_back(std::byte{'\n'});
+        }
+    }
+    return bytes;
+}
+
+// Gathers the chunks, checking each with check(chunk)
+template <typename Check>
+auto gather(tcb::chunk_generator chunks, Check check) -> std::vector<std::byte>
+{
+    std::vector<std::byte> out;
+    for (tcb::pointer<std::byte const[]> chunk : chunks) {
+        REQUIRE(!chunk->empty());
+        check(chunk);
+        out.insert(out.end(), chunk->begin(), chunk->end());
+    }
+    return out;
+}
+
+// Writes bytes to a pipe in dribs and drabs, from another thread
+struct pipe_writer {
+    int fds[2];
+    std::jthread thread;
+
+    explicit pipe_writer(std::vector<std::byte> const& bytes)
+    {
+        REQUIRE(::pipe(fds) == 0);
+        thread = std::jthread([this, &bytes] {
+            std::size_t done = 0;
+            std::size_t piece = 1;
+            while (done < bytes.size()) {
+                std::size_t const n = std::min(piece, bytes.size() - done);
+                REQUIRE(::write(fds[1], bytes.data() + done, n) == static_cast<::ssize_t>(n));
+                done += n;
+                piece = piece * 3 % 1000 + 1;
+            }
+            ::close(fds[1]);
+        });
+    }
+
+    auto read_fd() const -> int { return fds[0]; }
+
+    ~pipe_writer()
+    {
+        thread.join();
+        ::close(fds[0]);
+    }
+};
+
+/*
+ * MARK: chunked_reader tests
+ */
+
+bool test_chunked_reader()
+{
+    auto const contents = make_bytes(100'000);
+
+    // Chunk sizes which do and don't divide the file
+    for (std::size_t chunk_size : {4096u, 1000u, 100'000u, 1'000'000u}) {
+        temp_file file(contents);
+        std::size_t count = 0;
+        auto const result = gather(tcb::chunked_reader(file.fd, chunk_size), [&](auto chunk) {
+            REQUIRE(chunk->size() <= chunk_size);
+            ++count;
+        });
+        REQUIRE(result == contents);
+        REQUIRE(count == (contents.size() + chunk_size - 1) / chunk_size);
+    }
+
+    // Reads from the current position
+    temp_file file(contents);
+    REQUIRE(::lseek(file.fd, 500, SEEK_SET) == 500);
+    auto const rest = gather(tcb::chunked_reader(file.fd, 4096), [](auto) { });
+    REQUIRE(std::ranges::equal(rest, contents | std::views::drop(500)));
+
+    // Empty files give no chunks
+    temp_file empty;
+    auto chunks = tcb::chunked_reader(empty.fd, 4096);
+    REQUIRE(chunks.begin() == chunks.end());
+
+    // Pipes give whatever each read returns
+    pipe_writer pipe(contents);
+    auto const piped = gather(tcb::chunked_reader(pipe.read_fd(), 4096), [](auto) { });
+    REQUIRE(piped == contents);
+
+    return true;
+}
+
+bool test_shared_io()
+{
+    auto const contents = make_bytes(50'000);
+    for (auto backend : {tcb::io_backend::io_uring, tcb::io_backend::thread_pool}) {
+        tcb::async_io io({.backend = backend, .threads = 2});
+        temp_file a(contents);
+        temp_file b(contents);
+
+        // Two readers on the same io, interleaved
+        auto chunks_a = tcb::chunked_reader(io, a.fd, 3000);
+        auto chunks_b = tcb::chunked_record_reader(io, b.fd, 3000, std::byte{0});
+        std::vector<std::byte> result_a;
+        std::vector<std::byte> result_b;
+        auto it_a = chunks_a.begin();
+        auto it_b = chunks_b.begin();
+        while (it_a != chunks_a.end() || it_b != chunks_b.end()) {
+            if (it_a != chunks_a.end()) {
+                auto const chunk = *it_a;
+                result_a.insert(result_a.end(), chunk->begin(), chunk->end());
+                ++it_a;
+            }
+            if (it_b != chunks_b.end()) {
+                auto const chunk = *it_b;
+                result_b.insert(result_b.end(), chunk->begin(), chunk->end());
+                ++it_b;
+            }
+        }
+        REQUIRE(result_a == contents);
+        REQUIRE(result_b == contents);
+        REQUIRE(io.in_flight() == 0);
+    }
+
+    return true;
+}
+
+bool test_early_exit()
+{
+    auto const contents = make_bytes(100'000);
+    temp_file file(contents);
+    tcb::async_io io;
+    {
+        // The next read is in flight when we stop
+        auto chunks = tcb::chunked_reader(io, file.fd, 1000);
+        auto it = chunks.begin();
+        REQUIRE(it != chunks.end());
+        REQUIRE(io.in_flight() == 1);
+    }
+    REQUIRE(io.in_flight() == 0);
+
+    // Moving a generator transfers it
+    auto chunks = tcb::chunked_reader(file.fd, 1000);
+    auto other = std::move(chunks);
+    auto it = other.begin();
+    REQUIRE(it != other.end());
+
+    return true;
+}
+
+/*
+ * MARK: chunked_record_reader tests
+ */
+
+bool test_record_reader()
+{
+    auto const lines = make_lines(5000);
+
+    for (std::size_t chunk_size : {64u, 1000u, 4096u, 1'000'000u}) {
+        temp_file file(lines);
+        std::vector<bool> whole_lines;
+        auto const result = gather(tcb::chunked_record_reader(file.fd, chunk_size, std::byte{'\n'}),
+                                   [&](auto chunk) {
+                                       REQUIRE(chunk->size() <= chunk_size);
+                                       whole_lines.push_back(chunk->back() == std::byte{'\n'});
+                                   });
+        REQUIRE(result == lines);
+
+        // Every chunk but the last ends with a whole line
+        whole_lines.pop_back();
+        REQUIRE(std::ranges::all_of(whole_lines, std::identity{}));
+    }
+
+    // A pipe which splits lines everywhere
+    pipe_writer pipe(lines);
+    std::vector<std::byte> result;
+    for (auto chunk : tcb::chunked_record_reader(pipe.read_fd(), 512, std::byte{'\n'})) {
+        result.insert(result.end(), chunk->begin(), chunk->end());
+        REQUIRE((result.size() == lines.size() || chunk->back() == std::byte{'\n'}));
+    }
+    REQUIRE(result == lines);
+
+    return true;
+}
+
+bool test_custom_split()
+{
+    // Length-prefixed records: one byte of length, then that many bytes
+    std::vector<std::byte> records;
+    for (std::size_t i = 0; i < 3000; ++i) {
+        auto const length = static_cast<std::uint8_t>(i % 200);
+        records.push_back(static_cast<std::byte>(length));
+        for (std::uint8_t j = 0; j < length; ++j) {
+            records.push_back(static_cast<std::byte>(j));
+        }
+    }
+    auto split = [](tcb::pointer<std::byte const[]> data) -> std::size_t {
+        std::size_t pos = 0;
+        while (pos < data->size()) {
+            std::size_t const next = pos + 1 + std::to_integer<std::size_t>((*data)[pos]);
+            if (next > data->size()) {
+                break;
+            }
+            pos = next;
+        }
+        return pos;
+    };
+
+    temp_file file(records);
+    auto const result = gather(tcb::chunked_record_reader(file.fd, 1024, split), [&](auto chunk) {
+        REQUIRE(split(chunk) == chunk->size());
+    });
+    REQUIRE(result == records);
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    REQUIRE_ERROR(tcb::chunked_reader(0, 0));
+    REQUIRE_ERROR(tcb::chunked_record_reader(0, 0, std::byte{'\n'}));
+
+    // Read errors are thrown when reading
+    auto bad = tcb::chunked_reader(-1, 4096);
+    REQUIRE_THROWS_AS(std::system_error, bad.begin());
+
+    // Records must fit in a chunk, which depends on the data, so it throws
+    auto lines = make_lines(100);
+    lines.insert(lines.begin(), 300, std::byte{'y'});
+    temp_file file(lines);
+    auto too_long = tcb::chunked_record_reader(file.fd, 256, std::byte{'\n'});
+    REQUIRE_THROWS_AS(std::length_error, too_long.begin());
+
+    temp_file other(lines);
+    auto chunks = tcb::chunked_reader(other.fd, 256);
+    auto it = chunks.begin();
+    REQUIRE_ERROR(chunks.begin());
+    while (it != chunks.end()) {
+        ++it;
+    }
+    REQUIRE_ERROR(++it);
+    REQUIRE_ERROR(*it);
+
+    return true;
+}
+
+#endif // TCB_PTR_HAVE_ASYNC_IO
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+#if TCB_PTR_HAVE_ASYNC_IO
+    bool b = true;
+
+    b = test_chunked_reader();
+    REQUIRE(b);
+
+    b = test_shared_io();
+    REQUIRE(b);
+
+    b = test_early_exit();
+    REQUIRE(b);
+
+    b = test_record_reader();
+    REQUIRE(b);
+
+    b = test_custom_split();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+#endif
+}
@@ -0,0 +1,217 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tcb/compact.hpp>
+
+#include "test_machinery.hpp"
+
+/*
+ * MARK: Test helpers
+ */
+
+// Sizes either side of every block width, at several selectivities
+inline constexpr std::size_t sizes[] = {0, 1, 3, 4, 7, 8, 9, 15, 16, 17, 31, 33, 100, 1000};
+inline constexpr int percentages[] = {0, 10, 50, 90, 100};
+
+template <typename T>
+auto make_data(std::size_t n, std::mt19937& gen) -> std::vector<T>
+{
+    std::uniform_int_distribution<int> dist(0, 99);
+    std::vector<T> vec(n);
+    std::ranges::generate(vec, [&] { return static_cast<T>(dist(gen)); });
+    return vec;
+}
+
+/*
+ * MARK: compact_if() tests
+ */
+
+template <typename T>
+bool test_compact_if()
+{
+    std::mt19937 gen(42);
+
+    for (std::size_t n : sizes) {
+        auto const in = make_data<T>(n, gen);
+        for (int percent : percentages) {
+            auto pred = [percent](T x) { return x < static_cast<T>(percent); };
+
+            std::vector<T> expected;
+            std::ranges::copy_if(in, std::back_inserter(expected), pred);
+
+            std::vector<T> out(n);
+            auto result = tcb::compact_if(tcb::ptr_to_array(in), pred, tcb::ptr_to_mut_array(out));
+            REQUIRE(result->data() == out.data());
+            REQUIRE(std::ranges::equal(*result, expected));
+        }
+    }
+
+    return true;
+}
+
+bool test_compact_if_non_trivial()
+{
+    std::vector<std::string> const in{"apple", "", "banana", "cherry", "", "", "damson"};
+    std::vector<std::string> out(10);
+
+    auto result = tcb::compact_if(tcb::ptr_to_array(in), &std::string::empty,
+                                  tcb::ptr_to_mut_array(out));
+    REQUIRE(result->size() == 3);
+    REQUIRE(std::ranges::all_of(*result, &std::string::empty));
+
+    return true;
+}
+
+/*
+ * MARK: select_if() tests
+ */
+
+template <typename I>
+bool test_select_if()
+{
+    std::mt19937 gen(1729);
+
+    for (std::size_t n : sizes) {
+        auto const in = make_data<double>(n, gen);
+        for (int percent : percentages) {
+            auto pred = [percent](double x) { return x < percent; };
+
+            std::vector<I> expected;
+            for (std::size_t i = 0; i < n; ++i) {
+                if (pred(in[i])) {
+                    expected.push_back(static_cast<I>(i));
+                }
+            }
+
+            std::vector<I> sel(n);
+            auto result = tcb::select_if(tcb::ptr_to_array(in), pred, tcb::ptr_to_mut_array(sel));
+            REQUIRE(std::ranges::equal(*result, expected));
+        }
+    }
+
+    return true;
+}
+
+/*
+ * MARK: strip_nulls() tests
+ */
+
+bool test_strip_nulls()
+{
+    std::mt19937 gen(99);
+    std::vector<int> targets(1000);
+
+    for (std::size_t n : sizes) {
+        for (int percent : percentages) {
+            std::uniform_int_distribution<int> dist(0, 99);
+            std::vector<std::optional<tcb::pointer<int>>> in(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (dist(gen) < percent) {
+                    in[i] = tcb::ptr_to_mut(targets[i]);
+                }
+            }
+
+            std::vector<tcb::pointer<int>> expected;
+            for (auto const& opt : in) {
+                if (opt) {
+                    expected.push_back(*opt);
+                }
+            }
+
+            // The output starts out full of valid pointers, and must stay that way
+            tcb::pointer<int> const sentinel = tcb::ptr_to_mut(targets.back());
+            std::vector<tcb::pointer<int>> out(n, sentinel);
+            auto result = tcb::strip_nulls(tcb::ptr_to_array(in), tcb::ptr_to_mut_array(out));
+            REQUIRE(std::ranges::equal(*result, expected));
+            REQUIRE(std::ranges::all_of(out, [&](tcb::pointer<int> p) {
+                return tcb::to_address(p) >= targets.data()
+                    && tcb::to_address(p) < targets.data() + targets.size();
+            }));
+        }
+    }
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    std::vector<int> in(10);
+    std::vector<int> out_vec(9);
+    auto const out = tcb::ptr_to_mut_array(out_vec);
+    auto pred = [](int) { return true; };
+
+    REQUIRE_ERROR(tcb::compact_if(tcb::ptr_to_array(in), pred, out));
+
+    std::vector<std::uint32_t> sel(9);
+    REQUIRE_ERROR(tcb::select_if(tcb::ptr_to_array(in), pred, tcb::ptr_to_mut_array(sel)));
+
+    // Positions must fit in the index type
+    std::vector<int> big(300);
+    std::vector<std::uint8_t> small_sel(300);
+    REQUIRE_ERROR(tcb::select_if(tcb::ptr_to_array(big), pred, tcb::ptr_to_mut_array(small_sel)));
+    auto const big_ptr = tcb::ptr_to_array(big);
+    std::vector<std::uint8_t> exact_sel(256);
+    auto const exact = tcb::select_if(big_ptr->first(256), pred, tcb::ptr_to_mut_array(exact_sel));
+    REQUIRE(exact->size() == 256);
+
+    std::vector<std::optional<tcb::pointer<int>>> opts(10);
+    int i = 0;
+    std::vector<tcb::pointer<int>> ptrs(9, tcb::ptr_to_mut(i));
+    REQUIRE_ERROR(tcb::strip_nulls(tcb::ptr_to_array(opts), tcb::ptr_to_mut_array(ptrs)));
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_compact_if<std::uint8_t>();
+    REQUIRE(b);
+
+    b = test_compact_if<std::int32_t>();
+    REQUIRE(b);
+
+    b = test_compact_if<float>();
+    REQUIRE(b);
+
+    b = test_compact_if<std::uint64_t>();
+    REQUIRE(b);
+
+    b = test_compact_if<double>();
+    REQUIRE(b);
+
+    b = test_compact_if_non_trivial();
+    REQUIRE(b);
+
+    b = test_select_if<std::uint32_t>();
+    REQUIRE(b);
+
+    b = test_select_if<std::uint64_t>();
+    REQUIRE(b);
+
+    b = test_select_if<std::uint16_t>();
+    REQUIRE(b);
+
+    b = test_strip_nulls();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+}
@@ -0,0 +1,134 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+#include <tcb/cpu_dispatch.hpp>
+
+#include "test_machinery.hpp"
+
+/*
+ * MARK: Test kernels
+ */
+
+// Reports the level it was compiled for
+struct level_kernel {
+    template <tcb::simd_level Level>
+    auto operator()(tcb::detail::simd_level_constant<Level>) const -> tcb::simd_level
+    {
+        return Level;
+    }
+};
+
+// Doesn't care about the level
+struct sum_kernel {
+    auto operator()(int const* first, std::size_t n) const -> int
+    {
+        int total = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            total += first[i];
+        }
+        return total;
+    }
+};
+
+/*
+ * MARK: Dispatch tests
+ */
+
+bool test_parse_simd_level()
+{
+    using tcb::simd_level;
+    using tcb::detail::parse_simd_level;
+
+    REQUIRE(parse_simd_level("baseline") == simd_level::baseline);
+    REQUIRE(parse_simd_level("avx2") == simd_level::avx2);
+    REQUIRE(parse_simd_level("avx512") == simd_level::avx512);
+    REQUIRE(not parse_simd_level("").has_value());
+    REQUIRE(not parse_simd_level("AVX2").has_value());
+    REQUIRE(not parse_simd_level("sse4").has_value());
+
+    return true;
+}
+
+bool test_active_simd_level()
+{
+    auto const supported = tcb::supported_simd_level();
+    auto const active = tcb::active_simd_level();
+
+    // We never select a level the CPU doesn't support
+    REQUIRE(active <= supported);
+
+    // The level is fixed after the first call
+    REQUIRE(tcb::active_simd_level() == active);
+
+#if TCB_PTR_MULTIVERSIONING
+    // The environment override caps the level
+    char const* env = std::getenv("TCB_PTR_SIMD_LEVEL");
+    auto requested = env ? tcb::detail::parse_simd_level(env) : std::nullopt;
+    if (requested) {
+        REQUIRE(active == (*requested < supported ? *requested : supported));
+    } else {
+        REQUIRE(active == supported);
+    }
+#else
+    REQUIRE(active == tcb::simd_level::baseline);
+#endif
+
+    return true;
+}
+
+bool test_dispatch()
+{
+    using tcb::simd_level;
+
+    // The dispatched kernel is the one for the active level
+    REQUIRE(tcb::detail::dispatch_kernel<level_kernel>() == tcb::active_simd_level());
+    REQUIRE(tcb::detail::run_kernel<level_kernel>() == tcb::active_simd_level());
+
+    std::vector<int> vec(1000);
+    std::iota(vec.begin(), vec.end(), 0);
+    int const expected = std::accumulate(vec.begin(), vec.end(), 0);
+
+    // Every supported level can be called directly, and gives the same answer
+    for (auto level : {simd_level::baseline, simd_level::avx2, simd_level::avx512}) {
+        if (level > tcb::supported_simd_level()) {
+            continue;
+        }
+
+#if TCB_PTR_MULTIVERSIONING
+        REQUIRE(tcb::detail::kernel_for<level_kernel>(level)() == level);
+#else
+        REQUIRE(tcb::detail::kernel_for<level_kernel>(level)() == simd_level::baseline);
+#endif
+
+        auto fn = tcb::detail::kernel_for<sum_kernel, int const*, std::size_t>(level);
+        REQUIRE(fn(vec.data(), vec.size()) == expected);
+    }
+
+    REQUIRE(tcb::detail::run_kernel<sum_kernel>(static_cast<int const*>(vec.data()), vec.size())
+            == expected);
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_parse_simd_level();
+    REQUIRE(b);
+
+    b = test_active_simd_level();
+    REQUIRE(b);
+
+    b = test_dispatch();
+    REQUIRE(b);
+}
@@ -0,0 +1,263 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <system_error>
+
+#include <tcb/direct_io.hpp>
+
+#include "test_machinery.hpp"
+
+#if TCB_PTR_HAVE_PREAD
+#    include <csignal>
+#    include <fcntl.h>
+#    include <sys/resource.h>
+
+#    include "temp_file.hpp"
+#endif
+
+/*
+ * MARK: Test helpers
+ */
+
+#if TCB_PTR_HAVE_PREAD
+
+void fill(tcb::pointer<std::byte[]> buf, std::uint8_t seed)
+{
+    std::uint8_t x = seed;
+    for (std::byte& b : *buf) {
+        b = static_cast<std::byte>(x);
+        x = static_cast<std::uint8_t>(x * 5 + 1);
+    }
+}
+
+#endif
+
+/*
+ * MARK: aligned_buffer tests
+ */
+
+bool test_aligned_buffer()
+{
+    tcb::aligned_buffer buf(3 * 4096);
+    REQUIRE(buf.size() == 3 * 4096);
+    REQUIRE(buf.alignment() == tcb::direct_io_alignment);
+
+    auto const data = buf.get();
+    REQUIRE(data->size() == buf.size());
+    REQUIRE(reinterpret_cast<std::uintptr_t>(data->data()) % 4096 == 0);
+    REQUIRE(std::ranges::all_of(*data, [](std::byte b) { return b == std::byte{0}; }));
+
+    tcb::aligned_buffer small(512, 512);
+    auto const small_data = small.get();
+    REQUIRE(reinterpret_cast<std::uintptr_t>(small_data->data()) % 512 == 0);
+
+    tcb::aligned_buffer moved = std::move(buf);
+    auto const moved_data = moved.get();
+    REQUIRE(moved_data->data() == data->data());
+
+    return true;
+}
+
+/*
+ * MARK: aligned_subslice tests
+ */
+
+bool test_aligned_subslice()
+{
+    tcb::aligned_buffer buf(4 * 512, 512);
+    auto const data = buf.get();
+
+    // Rounded out to block boundaries
+    auto sub = tcb::aligned_subslice(data, 700, 100, 512);
+    REQUIRE(sub->data() == data->data() + 512);
+    REQUIRE(sub->size() == 512);
+
+    sub = tcb::aligned_subslice(data, 500, 30, 512);
+    REQUIRE(sub->data() == data->data());
+    REQUIRE(sub->size() == 1024);
+
+    // Already aligned
+    sub = tcb::aligned_subslice(data, 1024, 1024, 512);
+    REQUIRE(sub->data() == data->data() + 1024);
+    REQUIRE(sub->size() == 1024);
+
+    // Empty ranges
+    sub = tcb::aligned_subslice(data, 1024, 0, 512);
+    REQUIRE(sub->size() == 0);
+    sub = tcb::aligned_subslice(data, 2048, 0, 512);
+    REQUIRE(sub->size() == 0);
+
+    // Const buffers give const subslices
+    tcb::pointer<std::byte const[]> const cdata = data;
+    tcb::pointer<std::byte const[]> csub = tcb::aligned_subslice(cdata, 1, 1, 512);
+    REQUIRE(csub->size() == 512);
+
+    return true;
+}
+
+/*
+ * MARK: pread/pwrite tests
+ */
+
+#if TCB_PTR_HAVE_PREAD
+
+bool test_read_write()
+{
+    temp_file file;
+    tcb::aligned_buffer out(4 * 4096);
+    auto const out_data = out.get();
+    fill(out_data, 3);
+
+    tcb::pwrite_aligned(file.fd, out_data, 0);
+    tcb::pwrite_aligned(file.fd, out_data->first(4096), 4 * 4096);
+
+    tcb::aligned_buffer in(4 * 4096);
+    auto const in_data = in.get();
+    REQUIRE(tcb::pread_aligned(file.fd, in_data, 0) == in.size());
+    REQUIRE(std::ranges::equal(*in_data, *out_data));
+
+    // Short read at the end of the file
+    REQUIRE(tcb::pread_aligned(file.fd, in_data, 3 * 4096) == 2 * 4096);
+    REQUIRE(tcb::pread_aligned(file.fd, in_data, 8 * 4096) == 0);
+
+    // Part of a buffer, found with aligned_subslice
+    auto const part = tcb::aligned_subslice(in_data, 5000, 10);
+    REQUIRE(tcb::pread_aligned(file.fd, part, 4096) == 4096);
+
+    return true;
+}
+
+bool test_o_direct()
+{
+#ifdef O_DIRECT
+    // Not every filesystem supports direct I/O (tmpfs doesn't), so just do
+    // what we can
+    char path[] = "/var/tmp/tcb_direct_io_XXXXXX";
+    int const fd = ::mkostemp(path, O_DIRECT);
+    if (fd < 0) {
+        return true;
+    }
+    ::unlink(path);
+
+    tcb::aligned_buffer out(2 * 4096);
+    auto const out_data = out.get();
+    fill(out_data, 7);
+    tcb::aligned_buffer in(2 * 4096);
+    auto const in_data = in.get();
+
+    bool ok = true;
+    try {
+        tcb::pwrite_aligned(fd, out_data, 4096);
+        ok = tcb::pread_aligned(fd, in_data, 4096) == in.size()
+            && std::ranges::equal(*in_data, *out_data);
+    } catch (std::system_error const&) {
+        // EINVAL here means the filesystem wants bigger blocks than 4 KiB,
+        // which is fine
+    }
+    ::close(fd);
+    REQUIRE(ok);
+#endif
+    return true;
+}
+
+bool test_short_write()
+{
+    // A file size limit which ends partway through a block makes pwrite()
+    // write only up to it, which pwrite_aligned() can't continue from
+    temp_file file;
+    tcb::aligned_buffer out(4 * 512, 512);
+    auto const out_data = out.get();
+    fill(out_data, 5);
+
+    ::rlimit old_limit;
+    REQUIRE(::getrlimit(RLIMIT_FSIZE, &old_limit) == 0);
+    ::rlimit limit = old_limit;
+    limit.rlim_cur = 2 * 512 + 100;
+    auto const old_handler = std::signal(SIGXFSZ, SIG_IGN);
+    REQUIRE(::setrlimit(RLIMIT_FSIZE, &limit) == 0);
+
+    // Reported as such, rather than as the next write's failure
+    bool partial = false;
+    try {
+        tcb::pwrite_aligned(file.fd, out_data, 0, 512);
+    } catch (std::system_error const& e) {
+        partial = e.code() == std::errc::io_error;
+    }
+    ::setrlimit(RLIMIT_FSIZE, &old_limit);
+    std::signal(SIGXFSZ, old_handler);
+    REQUIRE(partial);
+
+    return true;
+}
+
+#endif
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    REQUIRE_ERROR(tcb::aligned_buffer(0));
+    REQUIRE_ERROR(tcb::aligned_buffer(1000));
+    REQUIRE_ERROR(tcb::aligned_buffer(4096, 3000));
+
+    tcb::aligned_buffer buf(4 * 512, 512);
+    auto const data = buf.get();
+    auto const misaligned = data->subslice(1, 512);
+    auto const ragged = data->first(700);
+
+    REQUIRE_ERROR(tcb::aligned_subslice(data, 0, 10, 100));
+    REQUIRE_ERROR(tcb::aligned_subslice(misaligned, 0, 10, 512));
+    REQUIRE_ERROR(tcb::aligned_subslice(ragged, 0, 10, 512));
+    REQUIRE_ERROR(tcb::aligned_subslice(data, 2000, 100, 512));
+    REQUIRE_ERROR(tcb::aligned_subslice(data, 3000, 0, 512));
+
+#if TCB_PTR_HAVE_PREAD
+    // Caught before the syscall, so any fd will do
+    REQUIRE_ERROR(tcb::pread_aligned(-1, misaligned, 0, 512));
+    REQUIRE_ERROR(tcb::pread_aligned(-1, ragged, 0, 512));
+    REQUIRE_ERROR(tcb::pread_aligned(-1, data, 100, 512));
+    REQUIRE_ERROR(tcb::pwrite_aligned(-1, misaligned, 0, 512));
+    REQUIRE_ERROR(tcb::pwrite_aligned(-1, data, 100, 512));
+    REQUIRE_ERROR(tcb::pwrite_aligned(-1, data, 0, 0));
+
+    // System errors are reported as such
+    REQUIRE_THROWS_AS(std::system_error, tcb::pread_aligned(-1, data, 0, 512));
+#endif
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_aligned_buffer();
+    REQUIRE(b);
+
+    b = test_aligned_subslice();
+    REQUIRE(b);
+
+#if TCB_PTR_HAVE_PREAD
+    b = test_read_write();
+    REQUIRE(b);
+
+    b = test_o_direct();
+    REQUIRE(b);
+
+    b = test_short_write();
+    REQUIRE(b);
+#endif
+
+    b = test_errors();
+    REQUIRE(b);
+}
@@ -0,0 +1,152 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <tcb/histogram.hpp>
+
+#include "test_machinery.hpp"
+
+/*
+ * MARK: histogram() tests
+ */
+
+template <typename C>
+bool test_histogram()
+{
+    std::mt19937 gen(42);
+
+    for (std::size_t n : {0u, 1u, 100u, 200000u}) {
+        for (std::size_t bins : {1u, 7u, 64u, 1000u}) {
+            std::uniform_int_distribution<std::size_t> dist(0, bins - 1);
+            std::vector<std::uint32_t> in(n);
+            for (auto& x : in) {
+                x = static_cast<std::uint32_t>(dist(gen));
+            }
+            auto bin_fn = [](std::uint32_t x) { return x; };
+
+            std::vector<C> expected(bins, 1);
+            for (auto x : in) {
+                ++expected[x];
+            }
+
+            // Counts are accumulated, starting from one here
+            std::vector<C> seq(bins, 1);
+            tcb::histogram(tcb::ptr_to_array(in), bin_fn, tcb::ptr_to_mut_array(seq));
+            REQUIRE(seq == expected);
+
+            for (std::size_t threads : {1u, 3u, 4u}) {
+                std::vector<C> par(bins, 1);
+                tcb::histogram(tcb::parallel_t{threads}, tcb::ptr_to_array(in), bin_fn,
+                               tcb::ptr_to_mut_array(par));
+                REQUIRE(par == expected);
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+ * MARK: atomic_view() tests
+ */
+
+bool test_concurrent_atomic_view()
+{
+    constexpr std::size_t threads = 4;
+    constexpr std::size_t iterations = 10000;
+
+    // Counters
+    {
+        std::vector<std::uint64_t> counts(3);
+        auto ptr = tcb::ptr_to_mut_array(counts);
+        auto view = ptr->atomic_view();
+
+        std::vector<std::jthread> workers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([view, t] {
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    view[(i + t) % view.size()].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        workers.clear();
+
+        REQUIRE(counts[0] + counts[1] + counts[2] == threads * iterations);
+    }
+
+    // Bitmaps, with each thread setting every fourth bit
+    {
+        std::vector<std::uint64_t> bits(16);
+        auto ptr = tcb::ptr_to_mut_array(bits);
+        auto view = ptr->atomic_view();
+
+        std::vector<std::jthread> workers;
+        for (std::size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([view, t] {
+                for (std::size_t bit = t; bit < 64 * view.size(); bit += threads) {
+                    view[bit / 64].fetch_or(std::uint64_t{1} << (bit % 64),
+                                            std::memory_order_relaxed);
+                }
+            });
+        }
+        workers.clear();
+
+        for (auto word : bits) {
+            REQUIRE(word == ~std::uint64_t{0});
+        }
+    }
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    std::vector<int> in{0, 1, 2, 5, 1};
+    std::vector<std::uint64_t> counts(5);
+    auto const counts_ptr = tcb::ptr_to_mut_array(counts);
+    auto bin_fn = [](int x) { return x; };
+
+    REQUIRE_ERROR(tcb::histogram(tcb::ptr_to_array(in), bin_fn, counts_ptr));
+
+    // The parallel version leaves the counts untouched
+    std::ranges::fill(counts, 0);
+    REQUIRE_ERROR(tcb::histogram(tcb::parallel, tcb::ptr_to_array(in), bin_fn, counts_ptr));
+    REQUIRE(counts == std::vector<std::uint64_t>(5));
+
+    // Negative bins are out of bounds too
+    std::vector<int> negative{-1};
+    REQUIRE_ERROR(tcb::histogram(tcb::ptr_to_array(negative), bin_fn, counts_ptr));
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_histogram<std::uint64_t>();
+    REQUIRE(b);
+
+    b = test_histogram<std::uint32_t>();
+    REQUIRE(b);
+
+    b = test_concurrent_atomic_view();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+}
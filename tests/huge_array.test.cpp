@@ -0,0 +1,120 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+
+#include <tcb/huge_array.hpp>
+
+#include "test_machinery.hpp"
+
+/*
+ * MARK: Test helpers
+ */
+
+template <typename T>
+bool check_array(tcb::huge_array<T> const& arr, std::size_t size)
+{
+    REQUIRE(arr.size() == size);
+    auto const data = arr.get();
+    REQUIRE(data->size() == size);
+
+    // Starts on a page boundary, and starts out zeroed
+    REQUIRE(arr.page_size() > 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(data->data()) % arr.page_size() == 0);
+    REQUIRE(std::ranges::all_of(*data, [](T const& x) { return x == T{}; }));
+
+    // Writable all the way to the end
+    std::iota(data->begin(), data->end(), T{1});
+    REQUIRE(data->back() == static_cast<T>(size));
+
+    return true;
+}
+
+/*
+ * MARK: huge_array tests
+ */
+
+bool test_page_kinds()
+{
+    constexpr std::size_t size = 3 * 1024 * 1024 + 5;
+
+    tcb::huge_array<std::uint32_t> normal(size, tcb::page_kind::normal);
+    REQUIRE(normal.pages() == tcb::page_kind::normal);
+    REQUIRE(check_array(normal, size));
+
+    // What we get depends on the system, but huge pages are bigger than
+    // normal ones
+    for (auto request : {tcb::page_kind::huge, tcb::page_kind::transparent_huge}) {
+        tcb::huge_array<std::uint32_t> arr(size, request);
+        REQUIRE(check_array(arr, size));
+        if (arr.pages() == tcb::page_kind::normal) {
+            REQUIRE(arr.page_size() == normal.page_size());
+        } else {
+            REQUIRE(arr.page_size() > normal.page_size());
+        }
+        if (request == tcb::page_kind::transparent_huge) {
+            REQUIRE(arr.pages() != tcb::page_kind::huge);
+        }
+    }
+
+    // Small arrays are fine too
+    tcb::huge_array<double> small(1);
+    REQUIRE(check_array(small, 1));
+
+    return true;
+}
+
+bool test_move()
+{
+    tcb::huge_array<int> a(100, tcb::page_kind::normal);
+    auto const data = a.get();
+    (*data)[7] = 7;
+
+    tcb::huge_array<int> b = std::move(a);
+    REQUIRE(b.size() == 100);
+    auto const b_data = b.get();
+    REQUIRE(b_data->data() == data->data());
+    REQUIRE(a.size() == 0);
+    REQUIRE_ERROR(a.get());
+
+    tcb::huge_array<int> c(5);
+    c = std::move(b);
+    REQUIRE(c.size() == 100);
+    auto const c_data = c.get();
+    REQUIRE((*c_data)[7] == 7);
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    REQUIRE_ERROR(tcb::huge_array<int>(0));
+    REQUIRE_ERROR(tcb::huge_array<std::uint64_t>(SIZE_MAX / 4));
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_page_kinds();
+    REQUIRE(b);
+
+    b = test_move();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+}
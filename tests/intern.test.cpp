@@ -0,0 +1,213 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <tcb/intern.hpp>
+
+#include "test_machinery.hpp"
+
+/*
+ * MARK: Test helpers
+ */
+
+auto ptr(std::string const& str) -> tcb::pointer<char const[]>
+{
+    return tcb::pointer<char const[]>::from_address_with_size(str.data(), str.size());
+}
+
+auto to_string(tcb::pointer<char const[]> const& slice) -> std::string
+{
+    return std::string(slice->data(), slice->size());
+}
+
+/*
+ * MARK: intern_table tests
+ */
+
+bool test_intern()
+{
+    tcb::intern_table<char> table;
+    REQUIRE(table.size() == 0);
+
+    std::string const a1 = "some/path/to/a/file";
+    std::string const a2 = "some/path/to/a/file";
+    std::string const b = "some/path/to/a/fild";
+
+    auto const ia1 = table.intern(ptr(a1));
+    auto const ia2 = table.intern(ptr(a2));
+    auto const ib = table.intern(ptr(b));
+
+    // Equal contents give the same pointer, which isn't the argument's
+    REQUIRE(ia1 == ia2);
+    REQUIRE(ia1 != ib);
+    REQUIRE(ia1->data() != a1.data());
+    REQUIRE(to_string(ia1) == a1);
+    REQUIRE(to_string(ib) == b);
+    REQUIRE(table.size() == 2);
+    REQUIRE(table.stored_size() == a1.size() + b.size());
+
+    // Interning an interned pointer gives it back
+    REQUIRE(table.intern(ia1) == ia1);
+
+    // Prefixes are distinct strings
+    std::string const prefix = "some/path";
+    auto const iprefix = table.intern(ptr(prefix));
+    REQUIRE(iprefix != ia1);
+    REQUIRE(iprefix->size() == prefix.size());
+
+    // The empty string has a canonical pointer too
+    std::string const empty1;
+    std::string const empty2 = a1.substr(0, 0);
+    auto const ie = table.intern(ptr(empty1));
+    REQUIRE(ie->size() == 0);
+    REQUIRE(table.intern(ptr(empty2)) == ie);
+
+    // find() doesn't insert
+    std::string const missing = "missing";
+    REQUIRE(!table.find(ptr(missing)));
+    REQUIRE(table.find(ptr(a2)) == ia1);
+    REQUIRE(table.size() == 4);
+
+    // Interned pointers can be hashed and compared by address
+    std::unordered_set<tcb::pointer<char const[]>> set{ia1, ia2, ib, ie};
+    REQUIRE(set.size() == 3);
+
+    return true;
+}
+
+bool test_many()
+{
+    // Enough strings to grow every shard several times, with a few long
+    // enough to get arena chunks of their own
+    tcb::intern_table<char> table(4);
+    std::vector<std::string> strs;
+    for (std::size_t i = 0; i < 20'000; ++i) {
+        strs.push_back("key-" + std::to_string(i % 5000));
+    }
+    for (std::size_t i = 0; i < 10; ++i) {
+        strs.push_back(std::string(100'000 + i, 'L'));
+    }
+    std::vector<tcb::pointer<char const[]>> interned;
+    for (auto const& str : strs) {
+        interned.push_back(table.intern(ptr(str)));
+    }
+    REQUIRE(table.size() == 5010);
+    for (std::size_t i = 0; i < 20'000; ++i) {
+        REQUIRE(interned[i] == interned[i % 5000]);
+        REQUIRE(to_string(interned[i]) == strs[i]);
+    }
+    for (std::size_t i = 20'000; i < strs.size(); ++i) {
+        REQUIRE(to_string(interned[i]) == strs[i]);
+    }
+
+    // Other element types
+    tcb::intern_table<std::uint32_t> words(1);
+    std::vector<std::uint32_t> const w1 = {1, 2, 3};
+    std::vector<std::uint32_t> const w2 = {1, 2, 3};
+    auto const iw1 = words.intern(tcb::ptr_to_array(w1));
+    REQUIRE(iw1 == words.intern(tcb::ptr_to_array(w2)));
+    REQUIRE(iw1->size() == 3);
+    REQUIRE(iw1->data()[2] == 3);
+
+    return true;
+}
+
+bool test_content_hash()
+{
+    std::string const a1 = "hello, world";
+    std::string const a2 = "hello, world";
+    REQUIRE(tcb::content_hash(ptr(a1)) == tcb::content_hash(ptr(a2)));
+    REQUIRE(tcb::content_hash(ptr(a1)) != tcb::content_hash(ptr(a1.substr(0, 11))));
+
+    // Lengths which aren't a multiple of the word size
+    std::unordered_set<std::uint64_t> hashes;
+    std::string const str(100, 'x');
+    for (std::size_t len = 0; len <= str.size(); ++len) {
+        hashes.insert(tcb::content_hash(ptr(str.substr(0, len))));
+    }
+    REQUIRE(hashes.size() == 101);
+
+    return true;
+}
+
+bool test_threads()
+{
+    // Threads interning overlapping sets of strings all get the same
+    // canonical pointers
+    tcb::intern_table<char> table;
+    std::vector<std::string> strs;
+    for (std::size_t i = 0; i < 4000; ++i) {
+        strs.push_back("tag:" + std::to_string(i * 7919 % 1000));
+    }
+    std::vector<std::vector<tcb::pointer<char const[]>>> results(4);
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t] {
+                for (std::size_t i = 0; i < strs.size(); ++i) {
+                    results[t].push_back(table.intern(ptr(strs[(i + t * 1000) % strs.size()])));
+                }
+            });
+        }
+    }
+    REQUIRE(table.size() == 1000);
+    for (std::size_t t = 0; t < 4; ++t) {
+        for (std::size_t i = 0; i < strs.size(); ++i) {
+            REQUIRE(results[t][i] == *table.find(ptr(strs[(i + t * 1000) % strs.size()])));
+        }
+    }
+
+    // The parallel batch version
+    std::vector<tcb::pointer<char const[]>> batch;
+    for (std::size_t i = 0; i < 100'000; ++i) {
+        batch.push_back(ptr(strs[i % strs.size()]));
+    }
+    table.intern(tcb::parallel_t{4}, tcb::ptr_to_mut_array(batch));
+    REQUIRE(table.size() == 1000);
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        REQUIRE(batch[i] == *table.find(ptr(strs[i % strs.size()])));
+    }
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    REQUIRE_ERROR(tcb::intern_table<char>(0));
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_intern();
+    REQUIRE(b);
+
+    b = test_many();
+    REQUIRE(b);
+
+    b = test_content_hash();
+    REQUIRE(b);
+
+    b = test_threads();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+}
@@ -0,0 +1,43 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Conversions which check_codegen.cmake compiles to assembly, requiring
+// each function named codegen_* to be nothing but moves: no calls, no
+// branches and no traps. It's built with the default error handling, not
+// the tests' config header, as users would build it.
+
+#include <span>
+#include <string_view>
+
+#include <tcb/interop.hpp>
+
+auto codegen_to_span(tcb::pointer<int[]> const& ptr) -> std::span<int>
+{
+    return tcb::to_span(ptr);
+}
+
+auto codegen_to_const_span(tcb::pointer<double const[]> const& ptr) -> std::span<double const>
+{
+    return tcb::to_span(ptr);
+}
+
+auto codegen_to_string_view(tcb::pointer<char const[]> const& ptr) -> std::string_view
+{
+    return tcb::to_string_view(ptr);
+}
+
+auto codegen_from_static_span(std::span<int, 4> span) -> tcb::pointer<int[]>
+{
+    return tcb::from_span(span);
+}
+
+auto codegen_round_trip(std::span<float const, 16> span) -> std::span<float const>
+{
+    return tcb::to_span(tcb::from_span(span));
+}
+
+auto codegen_const_pointer_span(tcb::pointer<int[]> const& ptr) -> std::span<int const>
+{
+    return tcb::to_span(tcb::pointer<int const[]>(ptr));
+}
@@ -0,0 +1,204 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <array>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tcb/interop.hpp>
+
+#include "test_machinery.hpp"
+
+using namespace std::string_view_literals;
+
+static_assert(std::is_same_v<decltype(tcb::to_span(std::declval<tcb::pointer<int[]>>())),
+                             std::span<int>>);
+static_assert(
+    std::is_same_v<decltype(tcb::to_static_span<3>(std::declval<tcb::pointer<int const[]>>())),
+                   std::span<int const, 3>>);
+static_assert(std::is_same_v<decltype(tcb::from_span(std::declval<std::span<int const, 4>>())),
+                             tcb::pointer<int const[]>>);
+static_assert(
+    std::is_same_v<decltype(tcb::to_string_view(std::declval<tcb::pointer<char16_t const[]>>())),
+                   std::u16string_view>);
+static_assert(std::is_same_v<decltype(tcb::from_string_view(std::declval<std::wstring_view>())),
+                             tcb::pointer<wchar_t const[]>>);
+
+// Only character pointers become string views
+static_assert(!std::is_invocable_v<tcb::to_string_view_t, tcb::pointer<int const[]>>);
+static_assert(std::is_invocable_v<tcb::to_string_view_t, tcb::pointer<char[]>>);
+
+/*
+ * MARK: Constant evaluation tests
+ */
+
+constexpr bool test_constexpr()
+{
+    int arr[] = {1, 2, 3, 4};
+
+    auto ptr = tcb::from_span(std::span(arr));
+    REQUIRE(ptr->size() == 4);
+    REQUIRE(ptr->data() == arr);
+
+    auto dynamic = tcb::to_span(ptr);
+    REQUIRE(dynamic.data() == arr && dynamic.size() == 4);
+
+    auto fixed = tcb::to_static_span<4>(ptr);
+    REQUIRE(fixed[3] == 4);
+
+    auto back = tcb::from_span(std::span<int>(arr).subspan(1));
+    REQUIRE(back->front() == 2);
+
+    auto str = tcb::from_string_view("hello"sv);
+    REQUIRE(tcb::to_string_view(str) == "hello");
+
+    return true;
+}
+// Older GCCs won't read an array pointer's mutable slice during constant
+// evaluation, so there the test only runs at run time
+#if !defined(__GNUC__) || defined(__clang__) || __GNUC__ >= 14
+static_assert(test_constexpr());
+#endif
+
+/*
+ * MARK: span tests
+ */
+
+bool test_span()
+{
+    std::vector<int> vec{1, 2, 3, 4, 5};
+
+    // Round trips keep the address and size
+    std::span<int> const span(vec);
+    auto const ptr = tcb::from_span(span);
+    REQUIRE(ptr->data() == vec.data());
+    REQUIRE(ptr->size() == 5);
+    auto const span2 = tcb::to_span(ptr);
+    REQUIRE(span2.data() == span.data());
+    REQUIRE(span2.size() == span.size());
+
+    // Writes go through
+    tcb::to_span(ptr)[0] = 10;
+    REQUIRE(vec[0] == 10);
+
+    // Mutable pointers become const spans and back
+    std::span<int const> const cspan = tcb::to_span(ptr);
+    tcb::pointer<int const[]> const cptr = tcb::from_span(cspan);
+    REQUIRE(cptr == tcb::pointer<int const[]>(ptr));
+
+    // Static extents
+    std::array<int, 3> arr{7, 8, 9};
+    auto const from_fixed = tcb::from_span(std::span(arr));
+    auto const fixed = tcb::to_static_span<3>(from_fixed);
+    REQUIRE(fixed.data() == arr.data());
+    REQUIRE(tcb::to_static_span<2>(ptr->first(2))[1] == 2);
+
+    // An empty span which has an address is fine
+    auto const empty = tcb::from_span(span.subspan(5));
+    REQUIRE(empty->empty());
+    REQUIRE(tcb::to_static_span<0>(empty).empty());
+
+    return true;
+}
+
+/*
+ * MARK: string_view tests
+ */
+
+bool test_string_view()
+{
+    std::string const str = "key=value";
+    auto const ptr = tcb::from_string_view(std::string_view(str));
+    REQUIRE(ptr->data() == str.data());
+    REQUIRE(ptr->size() == str.size());
+
+    std::string_view const key = tcb::to_string_view(ptr->first(3));
+    REQUIRE(key == "key");
+    REQUIRE(key.data() == str.data());
+
+    // Mutable character pointers give views of const characters
+    std::u32string text = U"abc";
+    auto const mut = tcb::pointer_to_mut_array(text);
+    REQUIRE(tcb::to_string_view(mut) == U"abc");
+
+    return true;
+}
+
+/*
+ * MARK: mdspan tests
+ */
+
+#ifdef __cpp_lib_mdspan
+bool test_mdspan()
+{
+    std::vector<double> data(12);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<double>(i);
+    }
+    auto const ptr = tcb::pointer_to_mut_array(data);
+
+    auto const grid = tcb::to_mdspan(ptr, 3, 4);
+    REQUIRE(grid.extent(0) == 3 && grid.extent(1) == 4);
+    REQUIRE(grid[2, 1] == 9.0);
+
+    auto const fixed = tcb::to_mdspan(ptr, std::extents<int, 2, std::dynamic_extent>(6));
+    REQUIRE(fixed[1, 5] == 11.0);
+
+    auto const back = tcb::from_mdspan(grid);
+    REQUIRE(back == ptr);
+
+    REQUIRE_ERROR(tcb::to_mdspan(ptr, 5, 5));
+
+    return true;
+}
+#endif
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    int arr[4] = {};
+    auto const ptr = tcb::from_span(std::span(arr));
+
+    // A static extent must match the size
+    REQUIRE_ERROR(tcb::to_static_span<3>(ptr));
+    REQUIRE_ERROR(tcb::to_static_span<5>(ptr));
+
+    // Default-constructed views are null
+    REQUIRE_ERROR(tcb::from_span(std::span<int>()));
+    REQUIRE_ERROR(tcb::from_span(std::span<int, 0>()));
+    REQUIRE_ERROR(tcb::from_string_view(std::string_view()));
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_constexpr();
+    REQUIRE(b);
+
+    b = test_span();
+    REQUIRE(b);
+
+    b = test_string_view();
+    REQUIRE(b);
+
+#ifdef __cpp_lib_mdspan
+    b = test_mdspan();
+    REQUIRE(b);
+#endif
+
+    b = test_errors();
+    REQUIRE(b);
+}
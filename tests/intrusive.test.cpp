@@ -0,0 +1,423 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <tcb/intrusive.hpp>
+
+#include "test_machinery.hpp"
+
+/*
+ * MARK: Test helpers
+ */
+
+// An element which can be in two lists, a stack and a tree at once
+struct task {
+    int id = 0;
+    tcb::list_hook<task> run_queue;
+    tcb::list_hook<task> lru;
+    tcb::stack_hook<task> free_list;
+    tcb::rbtree_hook<task> by_id;
+};
+
+using run_queue_t = tcb::intrusive_list<task, &task::run_queue>;
+using lru_t = tcb::intrusive_list<task, &task::lru>;
+using stack_t = tcb::intrusive_stack<task, &task::free_list>;
+using atomic_stack_t = tcb::atomic_intrusive_stack<task, &task::free_list>;
+
+struct id_of {
+    auto operator()(task const& t) const -> int { return t.id; }
+};
+
+using tree_t = tcb::intrusive_rbtree<task, &task::by_id, id_of>;
+
+static_assert(sizeof(tcb::list_hook<task>) == 2 * sizeof(task*));
+static_assert(sizeof(tcb::stack_hook<task>) == sizeof(task*));
+static_assert(std::bidirectional_iterator<run_queue_t::iterator>);
+static_assert(std::forward_iterator<stack_t::iterator>);
+static_assert(std::bidirectional_iterator<tree_t::iterator>);
+static_assert(std::ranges::bidirectional_range<tree_t const>);
+
+auto make_tasks(std::size_t n) -> std::vector<task>
+{
+    std::vector<task> tasks(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        tasks[i].id = static_cast<int>(i);
+    }
+    return tasks;
+}
+
+template <typename Container>
+auto ids(Container const& cont) -> std::vector<int>
+{
+    std::vector<int> result;
+    for (tcb::pointer<task> t : cont) {
+        result.push_back(t->id);
+    }
+    return result;
+}
+
+/*
+ * MARK: intrusive_list tests
+ */
+
+bool test_list()
+{
+    auto tasks = make_tasks(5);
+    auto ptr = [&](std::size_t i) { return tcb::ptr_to_mut(tasks[i]); };
+
+    run_queue_t queue;
+    REQUIRE(queue.empty());
+    REQUIRE(!queue.front().has_value());
+    REQUIRE(queue.begin() == queue.end());
+
+    queue.push_back(ptr(1));
+    queue.push_back(ptr(2));
+    queue.push_front(ptr(0));
+    queue.insert_before(ptr(2), ptr(3));
+    REQUIRE(queue.size() == 4);
+    REQUIRE((ids(queue) == std::vector{0, 1, 3, 2}));
+    REQUIRE(*queue.front() == ptr(0));
+    REQUIRE(*queue.back() == ptr(2));
+
+    // Backwards
+    std::vector<int> rev;
+    for (auto it = queue.end(); it != queue.begin();) {
+        --it;
+        rev.push_back((*it)->id);
+    }
+    REQUIRE((rev == std::vector{2, 3, 1, 0}));
+
+    // O(1) removal from the middle and the ends
+    queue.erase(ptr(3));
+    REQUIRE((ids(queue) == std::vector{0, 1, 2}));
+    REQUIRE(*queue.pop_front() == ptr(0));
+    REQUIRE(*queue.pop_back() == ptr(2));
+    REQUIRE((ids(queue) == std::vector{1}));
+    queue.erase(ptr(1));
+    REQUIRE(queue.empty());
+    REQUIRE(!queue.pop_front().has_value());
+
+    // The same elements in two lists at once
+    lru_t lru;
+    for (std::size_t i = 0; i < 5; ++i) {
+        queue.push_back(ptr(i));
+        lru.push_front(ptr(i));
+    }
+    queue.erase(ptr(2));
+    REQUIRE((ids(queue) == std::vector{0, 1, 3, 4}));
+    REQUIRE((ids(lru) == std::vector{4, 3, 2, 1, 0}));
+
+    // Moving a list moves its elements
+    lru_t moved = std::move(lru);
+    REQUIRE(lru.empty());
+    REQUIRE((ids(moved) == std::vector{4, 3, 2, 1, 0}));
+
+    // Clearing unlinks the elements, so they can be linked again
+    moved.clear();
+    REQUIRE(moved.empty());
+    moved.push_back(ptr(3));
+    REQUIRE((ids(moved) == std::vector{3}));
+
+    // As does destroying the list
+    {
+        run_queue_t temp;
+        temp.push_back(ptr(2));
+    }
+    queue.push_back(ptr(2));
+    REQUIRE((ids(queue) == std::vector{0, 1, 3, 4, 2}));
+
+    // Copying an element doesn't copy its links
+    task copy = tasks[3];
+    run_queue_t other;
+    other.push_back(tcb::ptr_to_mut(copy));
+    REQUIRE(other.size() == 1);
+
+    return true;
+}
+
+/*
+ * MARK: Stack tests
+ */
+
+bool test_stack()
+{
+    auto tasks = make_tasks(4);
+    auto ptr = [&](std::size_t i) { return tcb::ptr_to_mut(tasks[i]); };
+
+    stack_t stack;
+    REQUIRE(stack.empty());
+    REQUIRE(!stack.pop().has_value());
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        stack.push(ptr(i));
+    }
+    REQUIRE(stack.size() == 4);
+    REQUIRE(*stack.top() == ptr(3));
+    REQUIRE((ids(stack) == std::vector{3, 2, 1, 0}));
+
+    REQUIRE(*stack.pop() == ptr(3));
+    REQUIRE(*stack.pop() == ptr(2));
+    REQUIRE(stack.size() == 2);
+
+    stack_t moved = std::move(stack);
+    REQUIRE(stack.empty());
+    REQUIRE((ids(moved) == std::vector{1, 0}));
+
+    return true;
+}
+
+bool test_atomic_stack()
+{
+    auto tasks = make_tasks(4);
+    auto ptr = [&](std::size_t i) { return tcb::ptr_to_mut(tasks[i]); };
+
+    atomic_stack_t stack;
+    REQUIRE(stack.empty());
+    REQUIRE(!stack.pop().has_value());
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        stack.push(ptr(i));
+    }
+    REQUIRE(!stack.empty());
+    REQUIRE(*stack.pop() == ptr(3));
+
+    stack_t all = stack.pop_all();
+    REQUIRE(stack.empty());
+    REQUIRE(all.size() == 3);
+    REQUIRE((ids(all) == std::vector{2, 1, 0}));
+
+    // Popped elements can be pushed again
+    all.clear();
+    stack.push(ptr(1));
+    REQUIRE(*stack.pop() == ptr(1));
+
+    return true;
+}
+
+bool test_atomic_stack_concurrent()
+{
+    // Threads repeatedly pop elements and push them back, as with a free
+    // list. ABA on the head would lose or duplicate elements.
+    constexpr std::size_t num_threads = 4;
+    constexpr std::size_t iterations = 20000;
+    auto tasks = make_tasks(8);
+    atomic_stack_t stack;
+    for (auto& t : tasks) {
+        stack.push(tcb::ptr_to_mut(t));
+    }
+
+    std::vector<std::atomic<int>> held(tasks.size());
+    std::atomic<bool> bad{false};
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t t = 0; t < num_threads; ++t) {
+            threads.emplace_back([&] {
+                for (std::size_t i = 0; i < iterations; ++i) {
+                    auto const popped = stack.pop();
+                    if (!popped) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    auto const id = static_cast<std::size_t>((*popped)->id);
+                    // No-one else may hold this element
+                    if (held[id].fetch_add(1) != 0) {
+                        bad = true;
+                    }
+                    held[id].fetch_sub(1);
+                    stack.push(*popped);
+                }
+            });
+        }
+    }
+
+    REQUIRE(!bad);
+    stack_t all = stack.pop_all();
+    auto result = ids(all);
+    std::ranges::sort(result);
+    REQUIRE((result == std::vector{0, 1, 2, 3, 4, 5, 6, 7}));
+
+    return true;
+}
+
+/*
+ * MARK: intrusive_rbtree tests
+ */
+
+bool test_rbtree()
+{
+    auto tasks = make_tasks(8);
+    auto ptr = [&](std::size_t i) { return tcb::ptr_to_mut(tasks[i]); };
+
+    tree_t tree;
+    REQUIRE(tree.empty());
+    REQUIRE(!tree.find(3).has_value());
+    REQUIRE(tree.begin() == tree.end());
+
+    for (std::size_t i : {5u, 1u, 7u, 3u, 0u, 6u, 2u, 4u}) {
+        tree.insert(ptr(i));
+    }
+    REQUIRE(tree.size() == 8);
+    REQUIRE((ids(tree) == std::vector{0, 1, 2, 3, 4, 5, 6, 7}));
+    REQUIRE(*tree.front() == ptr(0));
+    REQUIRE(*tree.back() == ptr(7));
+    REQUIRE(*tree.find(4) == ptr(4));
+    REQUIRE(!tree.find(8).has_value());
+    REQUIRE(*tree.lower_bound(3) == ptr(3));
+    REQUIRE(*tree.upper_bound(3) == ptr(4));
+    REQUIRE(tree.upper_bound(7) == tree.end());
+
+    std::vector<int> rev;
+    for (auto it = tree.end(); it != tree.begin();) {
+        --it;
+        rev.push_back((*it)->id);
+    }
+    REQUIRE((rev == std::vector{7, 6, 5, 4, 3, 2, 1, 0}));
+
+    tree.erase(ptr(3));
+    tree.erase(ptr(0));
+    tree.erase(ptr(7));
+    REQUIRE((ids(tree) == std::vector{1, 2, 4, 5, 6}));
+    REQUIRE(!tree.find(3).has_value());
+
+    // Equal keys are kept in insertion order
+    task dup1;
+    task dup2;
+    dup1.id = 4;
+    dup2.id = 4;
+    tree.insert(tcb::ptr_to_mut(dup1));
+    tree.insert(tcb::ptr_to_mut(dup2));
+    auto it = tree.lower_bound(4);
+    REQUIRE(*it++ == ptr(4));
+    REQUIRE(*it++ == tcb::ptr_to_mut(dup1));
+    REQUIRE(*it++ == tcb::ptr_to_mut(dup2));
+    REQUIRE(*it == ptr(5));
+    tree.erase(tcb::ptr_to_mut(dup1));
+    tree.erase(tcb::ptr_to_mut(dup2));
+
+    // The same elements in a list and a tree
+    run_queue_t queue;
+    for (tcb::pointer<task> t : tree) {
+        queue.push_front(t);
+    }
+    REQUIRE((ids(queue) == std::vector{6, 5, 4, 2, 1}));
+
+    tree.clear();
+    REQUIRE(tree.empty());
+    tree.insert(ptr(2));
+    REQUIRE((ids(tree) == std::vector{2}));
+
+    return true;
+}
+
+bool test_rbtree_random()
+{
+    // Compare against std::multiset, with plenty of duplicate keys
+    std::mt19937 gen(42);
+    constexpr std::size_t n = 5000;
+    std::vector<task> tasks(n);
+    std::vector<bool> in_tree(n);
+    std::vector<task> sorted = make_tasks(200000);
+    // Declared after the elements, so that it is destroyed first
+    tree_t tree;
+    std::multiset<int> expected;
+
+    for (int round = 0; round < 20000; ++round) {
+        std::size_t const i = gen() % n;
+        if (in_tree[i]) {
+            tree.erase(tcb::ptr_to_mut(tasks[i]));
+            expected.erase(expected.find(tasks[i].id));
+        } else {
+            tasks[i].id = static_cast<int>(gen() % 1000);
+            tree.insert(tcb::ptr_to_mut(tasks[i]));
+            expected.insert(tasks[i].id);
+        }
+        in_tree[i] = !in_tree[i];
+    }
+    REQUIRE(tree.size() == expected.size());
+    REQUIRE(std::ranges::equal(ids(tree), expected));
+
+    // Sorted insertions, which would make an unbalanced tree quadratic
+    tree.clear();
+    for (auto& t : sorted) {
+        tree.insert(tcb::ptr_to_mut(t));
+    }
+    for (std::size_t i = 0; i < sorted.size(); i += 2) {
+        tree.erase(tcb::ptr_to_mut(sorted[i]));
+    }
+    REQUIRE(tree.size() == sorted.size() / 2);
+    REQUIRE((*tree.front())->id == 1);
+    REQUIRE(*tree.find(199999) == tcb::ptr_to_mut(sorted.back()));
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    auto tasks = make_tasks(3);
+    auto ptr = [&](std::size_t i) { return tcb::ptr_to_mut(tasks[i]); };
+
+    run_queue_t queue;
+    queue.push_back(ptr(0));
+    REQUIRE_ERROR(queue.push_back(ptr(0)));
+    REQUIRE_ERROR(queue.push_front(ptr(0)));
+    REQUIRE_ERROR(queue.erase(ptr(1)));
+    REQUIRE_ERROR(queue.insert_before(ptr(1), ptr(2)));
+    REQUIRE_ERROR(*queue.end());
+    auto end = queue.end();
+    REQUIRE_ERROR(++end);
+    auto begin = queue.begin();
+    REQUIRE_ERROR(--begin);
+
+    stack_t stack;
+    stack.push(ptr(0));
+    REQUIRE_ERROR(stack.push(ptr(0)));
+
+    tree_t tree;
+    tree.insert(ptr(0));
+    REQUIRE_ERROR(tree.insert(ptr(0)));
+    REQUIRE_ERROR(tree.erase(ptr(1)));
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_list();
+    REQUIRE(b);
+
+    b = test_stack();
+    REQUIRE(b);
+
+    b = test_atomic_stack();
+    REQUIRE(b);
+
+    b = test_atomic_stack_concurrent();
+    REQUIRE(b);
+
+    b = test_rbtree();
+    REQUIRE(b);
+
+    b = test_rbtree_random();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+}
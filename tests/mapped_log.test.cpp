@@ -0,0 +1,285 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <tcb/mapped_log.hpp>
+
+#include "test_machinery.hpp"
+
+#if TCB_PTR_HAVE_MAPPED_LOG
+
+#    include "temp_file.hpp"
+
+/*
+ * MARK: Test helpers
+ */
+
+auto bytes(std::string_view str) -> tcb::pointer<std::byte const[]>
+{
+    return tcb::pointer<std::byte const[]>::from_address_with_size(
+        reinterpret_cast<std::byte const*>(str.data()), str.size());
+}
+
+// Small enough to test growing, and to not need much address space
+constexpr tcb::mapped_log_options small_options{
+    .capacity = 1 << 24, .extent = 1 << 16, .writeback_interval = 1 << 14};
+
+/*
+ * MARK: Basic tests
+ */
+
+bool test_reserve_commit()
+{
+    temp_file file;
+    {
+        tcb::mapped_log log(file.fd, small_options);
+        REQUIRE(log.committed() == 0);
+        auto const empty = log.committed_data();
+        REQUIRE(empty->empty());
+
+        tcb::pointer<std::byte[]> const space = log.reserve(5);
+        REQUIRE(space->size() == 5);
+        REQUIRE(log.reserved() == 5);
+        REQUIRE(log.committed() == 0);
+        std::memcpy(space->data(), "hello", 5);
+        log.commit(space);
+        REQUIRE(log.committed() == 5);
+
+        REQUIRE(log.append(bytes(", world")) == 5);
+        REQUIRE(log.committed() == 12);
+
+        // Committed data can be read through the mapping
+        auto const data = log.committed_data();
+        REQUIRE(std::string_view(reinterpret_cast<char const*>(data->data()), data->size())
+                == "hello, world");
+
+        // The file is grown a whole extent at a time
+        REQUIRE(log.allocated() == 1 << 16);
+        REQUIRE(file.size() == 1 << 16);
+        log.sync();
+    }
+    // ...and trimmed when the log is destroyed
+    REQUIRE(file.contents() == "hello, world");
+
+    return true;
+}
+
+bool test_existing_file()
+{
+    temp_file file;
+    REQUIRE(::write(file.fd, "first\n", 6) == 6);
+    {
+        tcb::mapped_log log(file.fd, small_options);
+        REQUIRE(log.committed() == 6);
+        REQUIRE(log.append(bytes("second\n")) == 6);
+    }
+    REQUIRE(file.contents() == "first\nsecond\n");
+
+    return true;
+}
+
+bool test_growth()
+{
+    temp_file file;
+    std::string expected;
+    {
+        tcb::mapped_log log(file.fd, small_options);
+        // Records of assorted sizes, some bigger than an extent, and some
+        // crossing extent boundaries
+        for (std::size_t i = 0; i < 200; ++i) {
+            std::size_t const size = i % 50 == 49 ? 100'000 : 1 + i * 97 % 3000;
+            std::string const record(size, static_cast<char>('a' + i % 26));
+            log.append(bytes(record));
+            expected += record;
+            REQUIRE(log.allocated() >= log.committed());
+            REQUIRE(log.allocated() % (1 << 16) == 0);
+        }
+        log.sync();
+        REQUIRE(log.committed() == expected.size());
+    }
+    REQUIRE(file.contents() == expected);
+
+    return true;
+}
+
+/*
+ * MARK: Concurrency tests
+ */
+
+struct record {
+    std::uint32_t thread;
+    std::uint32_t seq;
+    std::uint64_t check;
+};
+
+bool test_concurrent_writers()
+{
+    constexpr std::uint32_t threads = 4;
+    constexpr std::uint32_t per_thread = 20'000;
+
+    temp_file file;
+    {
+        tcb::mapped_log log(file.fd, small_options);
+        std::vector<std::jthread> writers;
+        for (std::uint32_t t = 0; t < threads; ++t) {
+            writers.emplace_back([&log, t] {
+                for (std::uint32_t i = 0; i < per_thread; ++i) {
+                    record const rec{t, i, std::uint64_t{t} * 1'000'003 + i};
+                    tcb::pointer<std::byte[]> const space = log.reserve(sizeof(record));
+                    std::memcpy(space->data(), &rec, sizeof(record));
+                    log.commit(space);
+                }
+            });
+        }
+        writers.clear();
+        REQUIRE(log.reserved() == log.committed());
+        REQUIRE(log.committed() == threads * per_thread * sizeof(record));
+    }
+
+    // Every record is there, whole, and each thread's are in order
+    auto const contents = file.contents();
+    REQUIRE(contents.size() == threads * per_thread * sizeof(record));
+    std::vector<std::uint32_t> next(threads, 0);
+    for (std::size_t off = 0; off < contents.size(); off += sizeof(record)) {
+        record rec{};
+        std::memcpy(&rec, contents.data() + off, sizeof(record));
+        REQUIRE(rec.thread < threads);
+        REQUIRE(rec.seq == next[rec.thread]);
+        REQUIRE(rec.check == std::uint64_t{rec.thread} * 1'000'003 + rec.seq);
+        ++next[rec.thread];
+    }
+
+    return true;
+}
+
+bool test_commit_order()
+{
+    temp_file file;
+    tcb::mapped_log log(file.fd, small_options);
+    tcb::pointer<std::byte[]> const first = log.reserve(10);
+    tcb::pointer<std::byte[]> const second = log.reserve(20);
+    tcb::pointer<std::byte[]> const third = log.reserve(30);
+
+    // Later reservations can be committed first, but the watermark waits
+    // for the earliest
+    log.commit(third);
+    log.commit(second);
+    REQUIRE(log.committed() == 0);
+    log.commit(first);
+    REQUIRE(log.committed() == 60);
+
+    // In every order
+    std::size_t const n = 6;
+    std::vector<std::size_t> order = {0, 1, 2, 3, 4, 5};
+    do {
+        std::uint64_t const start = log.committed();
+        std::vector<tcb::pointer<std::byte[]>> spaces;
+        for (std::size_t i = 0; i < n; ++i) {
+            spaces.push_back(log.reserve(i + 1));
+        }
+        std::size_t lowest = 0;
+        std::vector<bool> done(n);
+        for (std::size_t i : order) {
+            log.commit(spaces[i]);
+            done[i] = true;
+            while (lowest < n && done[lowest]) {
+                ++lowest;
+            }
+            REQUIRE(log.committed() == start + lowest * (lowest + 1) / 2);
+        }
+    } while (std::next_permutation(order.begin(), order.end()));
+
+    // Committing from several threads
+    std::vector<tcb::pointer<std::byte[]>> spaces;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        spaces.push_back(log.reserve(8));
+    }
+    std::vector<std::jthread> committers;
+    for (std::size_t t = 0; t < 4; ++t) {
+        committers.emplace_back([&, t] {
+            for (std::size_t i = 999 - t; i < 1000; i -= 4) {
+                log.commit(spaces[i]);
+            }
+        });
+    }
+    committers.clear();
+    REQUIRE(log.committed() == log.reserved());
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    REQUIRE_ERROR(tcb::mapped_log(0, {.capacity = 0}));
+    REQUIRE_ERROR(tcb::mapped_log(0, {.extent = 0}));
+    REQUIRE_THROWS_AS(std::system_error, tcb::mapped_log(-1));
+
+    temp_file big;
+    REQUIRE(::ftruncate(big.fd, 1 << 20) == 0);
+    REQUIRE_THROWS_AS(std::length_error, tcb::mapped_log(big.fd, {.capacity = 4096}));
+
+    temp_file file;
+    tcb::mapped_log log(file.fd, {.capacity = 8192, .extent = 4096});
+    REQUIRE_ERROR(log.reserve(0));
+    REQUIRE_THROWS_AS(std::length_error, log.reserve(8193));
+
+    // Filling the log, which can be caught, and leaves it as it was
+    auto const all = log.reserve(8192);
+    REQUIRE_THROWS_AS(std::length_error, log.reserve(1));
+    REQUIRE(log.reserved() == 8192);
+    log.commit(all);
+    REQUIRE(log.committed() == 8192);
+
+    // Commits must be of reservations, once
+    REQUIRE_ERROR(log.commit(all));
+    std::byte elsewhere[4];
+    REQUIRE_ERROR(log.commit(tcb::ptr_to_mut_array(elsewhere)));
+
+    return true;
+}
+
+#endif // TCB_PTR_HAVE_MAPPED_LOG
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+#if TCB_PTR_HAVE_MAPPED_LOG
+    bool b = true;
+
+    b = test_reserve_commit();
+    REQUIRE(b);
+
+    b = test_existing_file();
+    REQUIRE(b);
+
+    b = test_growth();
+    REQUIRE(b);
+
+    b = test_concurrent_writers();
+    REQUIRE(b);
+
+    b = test_commit_order();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+#endif
+}
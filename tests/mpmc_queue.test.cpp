@@ -0,0 +1,200 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <tcb/mpmc_queue.hpp>
+
+#include "test_machinery.hpp"
+
+/*
+ * MARK: mpmc_queue tests
+ */
+
+bool test_push_pop()
+{
+    std::vector<int> objects(10);
+    auto ptr = [&](std::size_t i) { return tcb::ptr_to_mut(objects[i]); };
+
+    tcb::mpmc_queue<int> queue(4);
+    REQUIRE(queue.capacity() == 4);
+    REQUIRE(queue.size_approx() == 0);
+    REQUIRE(!queue.try_pop().has_value());
+
+    for (std::size_t i = 0; i < 4; ++i) {
+        REQUIRE(queue.try_push(ptr(i)));
+    }
+    REQUIRE(queue.size_approx() == 4);
+    REQUIRE(!queue.try_push(ptr(4)));
+
+    // First in, first out, and around the end of the ring several times
+    for (std::size_t i = 0; i < 9; ++i) {
+        auto const popped = queue.try_pop();
+        REQUIRE(popped.has_value());
+        REQUIRE(*popped == ptr(i));
+        REQUIRE(queue.try_push(ptr(i + 4 < 10 ? i + 4 : 0)));
+    }
+    REQUIRE(queue.size_approx() == 4);
+
+    // Capacities are rounded up to a power of two
+    REQUIRE(tcb::mpmc_queue<int>(5).capacity() == 8);
+    REQUIRE(tcb::mpmc_queue<int>(1).capacity() == 1);
+
+    return true;
+}
+
+bool test_batches()
+{
+    std::vector<int> objects(10);
+    std::vector<tcb::pointer<int>> in;
+    for (int& obj : objects) {
+        in.push_back(tcb::ptr_to_mut(obj));
+    }
+
+    tcb::mpmc_queue<int> queue(8);
+
+    // Only as many as fit are pushed
+    REQUIRE(queue.try_push(tcb::ptr_to_array(in)) == 8);
+    REQUIRE(queue.try_push(tcb::ptr_to_array(in)) == 0);
+
+    // Pops fill the start of the output
+    std::vector<tcb::pointer<int>> out(5, tcb::ptr_to_mut(objects[9]));
+    REQUIRE(queue.try_pop(tcb::ptr_to_mut_array(out)) == 5);
+    REQUIRE(std::equal(out.begin(), out.end(), in.begin()));
+
+    auto const whole = tcb::ptr_to_mut_array(out);
+    REQUIRE(queue.try_push(tcb::ptr_to_array(in)) == 5);
+    REQUIRE(queue.try_pop(whole) == 5);
+    REQUIRE(out[0] == in[5]);
+    REQUIRE(out[2] == in[7]);
+    REQUIRE(out[3] == in[0]);
+
+    // Empty batches are fine
+    REQUIRE(queue.try_pop(whole->first(0)) == 0);
+    REQUIRE(queue.try_pop(whole) == 3);
+    REQUIRE(queue.try_pop(whole) == 0);
+    REQUIRE(out[2] == in[4]);
+
+    // The rest of the output is left alone
+    REQUIRE(out[3] == in[0]);
+
+    return true;
+}
+
+bool test_concurrent()
+{
+    // Every element must be popped exactly once
+    constexpr std::size_t producers = 3;
+    constexpr std::size_t consumers = 3;
+    constexpr std::size_t per_producer = 20000;
+
+    std::vector<std::size_t> objects(producers * per_producer);
+    for (std::size_t i = 0; i < objects.size(); ++i) {
+        objects[i] = i;
+    }
+    std::vector<std::atomic<int>> seen(objects.size());
+    std::atomic<std::size_t> popped{0};
+    std::atomic<bool> bad{false};
+
+    // Small enough to wrap around many times. (When the queue is full or
+    // empty, threads yield, so that the test doesn't crawl on machines with
+    // fewer cores than threads.)
+    tcb::mpmc_queue<std::size_t> queue(16);
+
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                std::size_t i = 0;
+                while (i < per_producer) {
+                    std::size_t const base = p * per_producer + i;
+                    if (i % 3 == 0) {
+                        // Batches of up to four
+                        std::vector<tcb::pointer<std::size_t>> batch;
+                        for (std::size_t j = 0; j < 4 && i + j < per_producer; ++j) {
+                            batch.push_back(tcb::ptr_to_mut(objects[base + j]));
+                        }
+                        std::size_t const n = queue.try_push(tcb::ptr_to_array(batch));
+                        i += n;
+                        if (n == 0) {
+                            std::this_thread::yield();
+                        }
+                    } else if (queue.try_push(tcb::ptr_to_mut(objects[base]))) {
+                        ++i;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (std::size_t c = 0; c < consumers; ++c) {
+            threads.emplace_back([&, c] {
+                auto record = [&](tcb::pointer<std::size_t> ptr) {
+                    if (seen[*ptr].fetch_add(1) != 0) {
+                        bad = true;
+                    }
+                    ++popped;
+                };
+                std::vector<tcb::pointer<std::size_t>> batch(3, tcb::ptr_to_mut(objects[0]));
+                while (popped.load() < objects.size()) {
+                    if (c == 0) {
+                        std::size_t const n = queue.try_pop(tcb::ptr_to_mut_array(batch));
+                        for (std::size_t j = 0; j < n; ++j) {
+                            record(batch[j]);
+                        }
+                        if (n == 0) {
+                            std::this_thread::yield();
+                        }
+                    } else if (auto ptr = queue.try_pop()) {
+                        record(*ptr);
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+    }
+
+    REQUIRE(!bad);
+    REQUIRE(popped == objects.size());
+    REQUIRE(std::ranges::all_of(seen, [](std::atomic<int> const& s) { return s.load() == 1; }));
+    REQUIRE(queue.size_approx() == 0);
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    REQUIRE_ERROR(tcb::mpmc_queue<int>(0));
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_push_pop();
+    REQUIRE(b);
+
+    b = test_batches();
+    REQUIRE(b);
+
+    b = test_concurrent();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <tcb/parallel.hpp>
+
+#include "test_machinery.hpp"
+
+/*
+ * MARK: parallel tests
+ */
+
+bool test_task_count()
+{
+    using tcb::parallel_t;
+    using tcb::detail::task_count;
+
+    REQUIRE(task_count(parallel_t{4}, 1000, 10) == 4);
+    REQUIRE(task_count(parallel_t{4}, 30, 10) == 3);
+    REQUIRE(task_count(parallel_t{4}, 5, 10) == 1);
+    REQUIRE(task_count(parallel_t{4}, 0, 10) == 1);
+    REQUIRE(task_count(parallel_t{1}, 1000, 10) == 1);
+
+    // Zero means one per hardware thread
+    std::size_t const hw = std::thread::hardware_concurrency();
+    REQUIRE(task_count(tcb::parallel, 1'000'000'000, 1) == (hw > 0 ? hw : 1));
+
+    return true;
+}
+
+bool test_parallel_for()
+{
+    for (std::size_t n : {0u, 1u, 2u, 7u}) {
+        std::vector<int> hits(n);
+        std::atomic<std::size_t> calls = 0;
+        tcb::detail::parallel_for(n, [&](std::size_t task) {
+            ++hits[task];
+            ++calls;
+        });
+        REQUIRE(calls == n);
+        REQUIRE(std::ranges::all_of(hits, [](int h) { return h == 1; }));
+    }
+
+    // Task 0 runs on the calling thread
+    std::thread::id first;
+    tcb::detail::parallel_for(3, [&](std::size_t task) {
+        if (task == 0) {
+            first = std::this_thread::get_id();
+        }
+    });
+    REQUIRE(first == std::this_thread::get_id());
+
+    // Exceptions are propagated once every task has finished
+    std::atomic<std::size_t> finished = 0;
+    auto throw_from_task_2 = [&](std::size_t task) {
+        ++finished;
+        if (task == 2) {
+            throw std::runtime_error("oops");
+        }
+    };
+    REQUIRE_THROWS_AS(std::runtime_error, tcb::detail::parallel_for(4, throw_from_task_2));
+    REQUIRE(finished == 4);
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_task_count();
+    REQUIRE(b);
+
+    b = test_parallel_for();
+    REQUIRE(b);
+}
@@ -0,0 +1,120 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+#include <string_view>
+
+#include <tcb/perfect_hash.hpp>
+
+#include "test_machinery.hpp"
+
+using namespace std::string_view_literals;
+
+constexpr tcb::perfect_hash methods("GET", "HEAD", "POST", "PUT", "DELETE", "CONNECT", "OPTIONS",
+                                    "TRACE", "PATCH");
+
+// Lookups of string_views work in constant expressions
+static_assert(methods.size() == 9);
+static_assert(methods.find("GET"sv) == 0);
+static_assert(methods.find("PATCH"sv) == 8);
+static_assert(!methods.find("get"sv));
+static_assert(!methods.find(""sv));
+static_assert(!methods.contains("GETS"sv));
+
+// Keys may be empty, or contain NULs
+constexpr tcb::perfect_hash odd("", "\0", "a\0b");
+static_assert(odd.find(""sv) == 0);
+static_assert(odd.find(std::string_view("\0", 1)) == 1);
+static_assert(odd.find(std::string_view("a\0b", 3)) == 2);
+static_assert(!odd.find("a"sv));
+
+constexpr tcb::perfect_hash<0> none{};
+static_assert(!none.contains("anything"sv));
+
+/*
+ * MARK: Test helpers
+ */
+
+auto ptr(std::string const& str) -> tcb::pointer<char const[]>
+{
+    return tcb::pointer<char const[]>::from_address_with_size(str.data(), str.size());
+}
+
+/*
+ * MARK: perfect_hash tests
+ */
+
+bool test_find()
+{
+    // At run time, with keys which aren't string literals
+    std::string const request = "POST /index.html HTTP/1.1";
+    auto const token = tcb::pointer<char const[]>::from_address_with_size(request.data(), 4);
+    REQUIRE(methods.find(token) == 2);
+
+    for (std::size_t i = 0; i < methods.size(); ++i) {
+        auto const key = methods.key(i);
+        std::string const copy(key->data(), key->size());
+        REQUIRE(methods.find(ptr(copy)) == i);
+        REQUIRE(!methods.find(ptr(copy + "X")));
+        REQUIRE(!methods.find(ptr(copy.substr(1))));
+    }
+
+    return true;
+}
+
+bool test_many_keys()
+{
+    // Enough keys that buckets have several, including keys which differ
+    // only after the first word
+    constexpr tcb::perfect_hash headers(
+        "accept", "accept-charset", "accept-encoding", "accept-language", "accept-ranges",
+        "access-control-allow-origin", "age", "allow", "authorization", "cache-control",
+        "connection", "content-disposition", "content-encoding", "content-language",
+        "content-length", "content-location", "content-range", "content-type", "cookie", "date",
+        "etag", "expect", "expires", "from", "host", "if-match", "if-modified-since",
+        "if-none-match", "if-range", "if-unmodified-since", "last-modified", "link", "location",
+        "max-forwards", "proxy-authenticate", "proxy-authorization", "range", "referer",
+        "refresh", "retry-after", "server", "set-cookie", "strict-transport-security",
+        "transfer-encoding", "user-agent", "vary", "via", "www-authenticate");
+    static_assert(headers.size() == 48);
+
+    for (std::size_t i = 0; i < headers.size(); ++i) {
+        auto const key = headers.key(i);
+        std::string const copy(key->data(), key->size());
+        REQUIRE(headers.find(ptr(copy)) == i);
+    }
+    REQUIRE(!headers.find(ptr("content-lengths")));
+    REQUIRE(!headers.find(ptr("x-forwarded-for")));
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    REQUIRE_ERROR(methods.key(methods.size()));
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_find();
+    REQUIRE(b);
+
+    b = test_many_keys();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+}
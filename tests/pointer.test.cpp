@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <functional>
 #include <limits>
@@ -20,6 +21,8 @@ import tcb.pointer;
 #    include <tcb/pointer.hpp>
 #endif
 
+#include "test_machinery.hpp"
+
 /*
  * MARK: Test machinery
  */
@@ -41,37 +44,6 @@ constexpr bool compiler_is_msvc = true;
 constexpr bool compiler_is_msvc = false;
 #endif
 
-struct test_failure : std::runtime_error {
-    using std::runtime_error::runtime_error;
-};
-
-#define STRINGIFY2(x) #x
-#define STRINGIFY(x) STRINGIFY2(x)
-
-#define REQUIRE(...)        \
-    if (!(__VA_ARGS__))     \
-        throw test_failure( \
-            __FILE__ ":" STRINGIFY(__LINE__) ": Test \"" STRINGIFY(__VA_ARGS__) "\" failed");
-
-#define REQUIRE_THROWS_AS(type, ...)                                                   \
-    do {                                                                               \
-        bool caught = false;                                                           \
-        try {                                                                          \
-            (void)__VA_ARGS__;                                                         \
-        } catch (type const&) {                                                        \
-            caught = true;                                                             \
-        } catch (...) {                                                                \
-            throw test_failure(__FILE__ ":" STRINGIFY(__LINE__) ": Test \"" STRINGIFY( \
-                __VA_ARGS__) "\" threw an exception of unexpected type");              \
-        }                                                                              \
-        if (!caught) {                                                                 \
-            throw test_failure(__FILE__ ":" STRINGIFY(__LINE__) ": Test \"" STRINGIFY( \
-                __VA_ARGS__) "\" did not throw an exception when one was expected");   \
-        }                                                                              \
-    } while (0)
-
-#define REQUIRE_ERROR(...) REQUIRE_THROWS_AS(std::runtime_error, __VA_ARGS__)
-
 /*
  * MARK: Test types
  */
@@ -852,6 +824,24 @@ constexpr bool test_slice()
             REQUIRE(float_cmp == std::partial_ordering::unordered);
         }
 
+        // Byte slices compare as unsigned, then by length
+        {
+            std::uint8_t bytes[] = {1, 0x80, 3};
+            std::uint8_t lower[] = {1, 0x7F, 3, 4};
+            auto p_bytes = tcb::ptr_to_array(bytes);
+            auto p_lower = tcb::ptr_to_array(lower);
+            auto p_prefix = p_bytes->first(2);
+            REQUIRE(*p_bytes <=> *p_lower == std::strong_ordering::greater);
+            REQUIRE(*p_lower <=> *p_bytes == std::strong_ordering::less);
+            REQUIRE(*p_prefix <=> *p_bytes == std::strong_ordering::less);
+            REQUIRE(*p_bytes <=> *p_bytes == std::strong_ordering::equal);
+
+            std::byte raw[] = {std::byte{0xFF}, std::byte{0}};
+            auto p_raw = tcb::ptr_to_array(raw);
+            auto p_raw_tail = p_raw->last(1);
+            REQUIRE(*p_raw <=> *p_raw_tail == std::strong_ordering::greater);
+        }
+
         // We can compare types without a spaceship operator
         {
             no_spaceship ns[] = {{1}, {2}, {3}};
@@ -862,6 +852,43 @@ constexpr bool test_slice()
         }
     }
 
+    // Sub-slices work as expected
+    {
+        std::array arr{0, 1, 2, 3, 4};
+
+        auto ptr = tcb::ptr<int[]>::pointer_to(arr);
+
+        std::same_as<tcb::ptr<int[]>> auto first = ptr->first(2);
+        REQUIRE(first->data() == arr.data());
+        REQUIRE(first->size() == 2);
+
+        std::same_as<tcb::ptr<int[]>> auto last = ptr->last(2);
+        REQUIRE(last->data() == arr.data() + 3);
+        REQUIRE(last->size() == 2);
+
+        std::same_as<tcb::ptr<int[]>> auto sub = ptr->subslice(1, 3);
+        REQUIRE(sub->data() == arr.data() + 1);
+        REQUIRE(sub->size() == 3);
+
+        // Sub-slices may be empty, or the whole slice
+        auto empty_first = ptr->first(0);
+        auto empty_last = ptr->last(0);
+        auto empty_sub = ptr->subslice(5, 0);
+        REQUIRE(empty_first->empty());
+        REQUIRE(empty_last->empty());
+        REQUIRE(empty_sub->empty());
+        REQUIRE(ptr->subslice(0, 5) == ptr);
+
+        // Sub-slices of const slices are const
+        tcb::ptr<int const[]> cptr = ptr;
+        std::same_as<tcb::ptr<int const[]>> auto cfirst = cptr->first(2);
+        std::same_as<tcb::ptr<int const[]>> auto clast = cptr->last(2);
+        std::same_as<tcb::ptr<int const[]>> auto csub = cptr->subslice(1, 3);
+        REQUIRE(cfirst == ptr->first(2));
+        REQUIRE(clast == ptr->last(2));
+        REQUIRE(csub == ptr->subslice(1, 3));
+    }
+
     // Bounds checking works correctly
     if (!std::is_constant_evaluated()) {
         std::array array{1, 2, 3, 4, 5};
@@ -869,6 +896,16 @@ constexpr bool test_slice()
         auto p_array = tcb::ptr<int[]>::pointer_to(array);
         auto p_const_array = tcb::ptr<int const[]>::pointer_to(array);
 
+        // first(), last() and subslice()
+        REQUIRE_ERROR(p_array->first(6));
+        REQUIRE_ERROR(p_const_array->first(6));
+        REQUIRE_ERROR(p_array->last(6));
+        REQUIRE_ERROR(p_const_array->last(6));
+        REQUIRE_ERROR(p_array->subslice(6, 0));
+        REQUIRE_ERROR(p_array->subslice(2, 4));
+        REQUIRE_ERROR(p_const_array->subslice(0, 6));
+        REQUIRE_ERROR(p_const_array->subslice(1, SIZE_MAX));
+
         // op[]
         REQUIRE_ERROR((*p_array)[5]);
         REQUIRE_ERROR((*p_const_array)[5]);
@@ -894,6 +931,42 @@ constexpr bool test_slice()
 }
 static_assert(test_slice());
 
+bool test_slice_atomic_view()
+{
+    // Atomic views work as expected
+    {
+        std::array<std::uint64_t, 4> arr{0, 1, 2, 3};
+
+        auto ptr = tcb::ptr<std::uint64_t[]>::pointer_to(arr);
+        auto view = ptr->atomic_view();
+        REQUIRE(view.size() == 4);
+        REQUIRE(not view.empty());
+
+        std::same_as<std::atomic_ref<std::uint64_t>> auto ref = view[1];
+        REQUIRE(ref.fetch_add(10) == 1);
+        REQUIRE(view[2].fetch_or(0b100) == 2);
+        view[3].store(99);
+        REQUIRE(arr == (std::array<std::uint64_t, 4>{0, 11, 6, 99}));
+    }
+
+    // Atomic views of slices of non-trivially-copyable types are not allowed
+    {
+        auto has_atomic_view = [](auto* s) { return requires { s->atomic_view(); }; };
+        REQUIRE(has_atomic_view(static_cast<tcb::slice<int>*>(nullptr)));
+        REQUIRE(not has_atomic_view(static_cast<tcb::slice<std::vector<int>>*>(nullptr)));
+    }
+
+    // Bounds checking works correctly
+    {
+        std::array<std::uint64_t, 4> arr{};
+        auto ptr = tcb::ptr<std::uint64_t[]>::pointer_to(arr);
+        auto view = ptr->atomic_view();
+        REQUIRE_ERROR(view[4]);
+    }
+
+    return true;
+}
+
 /*
  * MARK: array ptr tests
  */
@@ -1681,6 +1754,8 @@ int main()
     // slice tests
     b = test_slice();
     REQUIRE(b);
+    b = test_slice_atomic_view();
+    REQUIRE(b);
 
     // array pointer tests
     b = test_array_pointer();
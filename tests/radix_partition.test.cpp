@@ -0,0 +1,207 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <tcb/radix_partition.hpp>
+
+#include "test_machinery.hpp"
+
+/*
+ * MARK: Test helpers
+ */
+
+// Too big to be write-combined
+struct record {
+    std::uint32_t key;
+    std::uint32_t payload[2];
+
+    bool operator==(record const&) const = default;
+};
+
+template <typename T>
+auto make_value(std::uint64_t x) -> T
+{
+    if constexpr (std::same_as<T, record>) {
+        return record{static_cast<std::uint32_t>(x), {static_cast<std::uint32_t>(x >> 32), 7}};
+    } else {
+        return static_cast<T>(x);
+    }
+}
+
+template <typename T>
+auto key_of(T const& elem) -> std::uint64_t
+{
+    if constexpr (std::same_as<T, record>) {
+        return elem.key;
+    } else {
+        return static_cast<std::uint64_t>(elem);
+    }
+}
+
+// The elements of in with each key, in their original order
+template <typename T>
+auto expected_partitions(std::vector<T> const& in, unsigned bits) -> std::vector<std::vector<T>>
+{
+    std::uint64_t const mask = (std::uint64_t{1} << bits) - 1;
+    std::vector<std::vector<T>> expected(std::size_t{1} << bits);
+    for (T const& elem : in) {
+        expected[key_of(elem) & mask].push_back(elem);
+    }
+    return expected;
+}
+
+// Checks that parts are the consecutive sub-arrays of out, and that each
+// holds the elements of in with that key, in their original order
+template <typename T>
+bool check_partitions(std::vector<T> const& in, unsigned bits, std::vector<T> const& out,
+                      std::vector<tcb::pointer<T[]>> const& parts)
+{
+    auto const expected = expected_partitions(in, bits);
+    REQUIRE(parts.size() == expected.size());
+
+    T const* next = out.data();
+    for (std::size_t p = 0; p < parts.size(); ++p) {
+        REQUIRE(parts[p]->data() == next);
+        REQUIRE(std::ranges::equal(*parts[p], expected[p]));
+        next += parts[p]->size();
+    }
+    REQUIRE(next == out.data() + out.size());
+
+    return true;
+}
+
+/*
+ * MARK: radix_partition() tests
+ */
+
+template <typename T>
+bool test_radix_partition()
+{
+    std::mt19937_64 gen(42);
+    auto key_fn = [](T const& elem) { return key_of(elem); };
+
+    for (std::size_t n : {0u, 1u, 15u, 100u, 5000u, 70000u}) {
+        std::vector<T> in(n);
+        std::ranges::generate(in, [&] { return make_value<T>(gen()); });
+
+        for (unsigned bits : {0u, 1u, 4u, 8u, 11u}) {
+            std::vector<T> out(n);
+            auto parts = tcb::radix_partition(tcb::ptr_to_array(in), key_fn, bits,
+                                              tcb::ptr_to_mut_array(out));
+            REQUIRE(check_partitions(in, bits, out, parts));
+        }
+    }
+
+    // An output which doesn't start on a cache line boundary
+    {
+        std::vector<T> in(10000);
+        std::ranges::generate(in, [&] { return make_value<T>(gen()); });
+        std::vector<T> storage(in.size() + 1);
+        auto const whole = tcb::ptr_to_mut_array(storage);
+        auto out = whole->last(in.size());
+
+        auto parts = tcb::radix_partition(tcb::ptr_to_array(in), key_fn, 7, out);
+        REQUIRE(parts.size() == 128);
+        REQUIRE(parts.front()->data() == storage.data() + 1);
+
+        auto const expected = expected_partitions(in, 7);
+        for (std::size_t p = 0; p < parts.size(); ++p) {
+            REQUIRE(std::ranges::equal(*parts[p], expected[p]));
+        }
+    }
+
+    return true;
+}
+
+template <typename T>
+bool test_parallel_radix_partition()
+{
+    std::mt19937_64 gen(1729);
+    auto key_fn = [](T const& elem) { return key_of(elem) >> 3; };
+
+    // Big enough to be split into several tasks
+    std::vector<T> in(300000);
+    std::ranges::generate(in, [&] { return make_value<T>(gen() % 100000); });
+
+    for (std::size_t threads : {1u, 3u, 4u}) {
+        for (unsigned bits : {0u, 3u, 10u}) {
+            std::vector<T> seq(in.size());
+            std::vector<T> par(in.size());
+            auto seq_parts = tcb::radix_partition(tcb::ptr_to_array(in), key_fn, bits,
+                                                  tcb::ptr_to_mut_array(seq));
+            auto par_parts = tcb::radix_partition(tcb::parallel_t{threads}, tcb::ptr_to_array(in),
+                                                  key_fn, bits, tcb::ptr_to_mut_array(par));
+
+            // The parallel version gives exactly the same result
+            REQUIRE(seq == par);
+            REQUIRE(par_parts.size() == seq_parts.size());
+            for (std::size_t p = 0; p < seq_parts.size(); ++p) {
+                REQUIRE(par_parts[p]->size() == seq_parts[p]->size());
+                REQUIRE(par_parts[p]->data() == par.data() + (seq_parts[p]->data() - seq.data()));
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    auto key_fn = [](int i) { return i; };
+    std::vector<int> in_vec(10);
+    std::vector<int> out_vec(10);
+    auto const in = tcb::ptr_to_array(in_vec);
+    auto const out = tcb::ptr_to_mut_array(out_vec);
+    auto const short_out = out->first(9);
+
+    REQUIRE_ERROR(tcb::radix_partition(in, key_fn, 17, out));
+    REQUIRE_ERROR(tcb::radix_partition(in, key_fn, 2, short_out));
+    REQUIRE_ERROR(tcb::radix_partition(tcb::parallel, in, key_fn, 2, short_out));
+
+    // Partitioning in place isn't supported
+    REQUIRE_ERROR(tcb::radix_partition(out, key_fn, 2, out));
+    std::vector<int> big_vec(15);
+    auto const big = tcb::ptr_to_mut_array(big_vec);
+    REQUIRE_ERROR(tcb::radix_partition(big->first(10), key_fn, 2, big->last(10)));
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_radix_partition<std::uint8_t>();
+    REQUIRE(b);
+
+    b = test_radix_partition<std::uint32_t>();
+    REQUIRE(b);
+
+    b = test_radix_partition<std::uint64_t>();
+    REQUIRE(b);
+
+    b = test_radix_partition<record>();
+    REQUIRE(b);
+
+    b = test_parallel_radix_partition<std::uint32_t>();
+    REQUIRE(b);
+
+    b = test_parallel_radix_partition<record>();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+}
@@ -0,0 +1,183 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <tcb/record_batch.hpp>
+
+#include "test_machinery.hpp"
+
+/*
+ * MARK: Test helpers
+ */
+
+template <typename T>
+auto col(std::vector<T> const& vec) -> tcb::pointer<T const[]>
+{
+    return tcb::ptr_to_array(vec);
+}
+
+auto indices(tcb::record_batch<std::int32_t, double, char> const& batch)
+    -> std::vector<std::uint32_t>
+{
+    std::vector<std::uint32_t> out;
+    if (auto const sel = batch.selection()) {
+        out.assign((*sel)->begin(), (*sel)->end());
+    }
+    return out;
+}
+
+/*
+ * MARK: record_batch tests
+ */
+
+bool test_record_batch()
+{
+    std::vector<std::int32_t> const ids = {10, 11, 12, 13, 14, 15, 16, 17};
+    std::vector<double> const prices = {1.0, 5.0, 2.5, 9.0, 0.5, 7.5, 3.0, 8.0};
+    std::vector<char> const kinds = {'a', 'b', 'a', 'b', 'a', 'b', 'a', 'b'};
+
+    tcb::record_batch batch(col(ids), col(prices), col(kinds));
+    REQUIRE(batch.num_rows() == 8);
+    REQUIRE(batch.size() == 8);
+    REQUIRE(!batch.selection());
+    REQUIRE(batch.num_columns() == 3);
+    auto const price_col = batch.column<1>();
+    REQUIRE(price_col->data() == prices.data());
+
+    // Filtering writes a selection vector, and copies no column data
+    std::vector<std::uint32_t> sel(batch.size());
+    auto const pricey
+        = batch.filter<1>([](double p) { return p > 2.0; }, tcb::ptr_to_mut_array(sel));
+    REQUIRE(pricey.size() == 6);
+    REQUIRE((indices(pricey) == std::vector<std::uint32_t>{1, 2, 3, 5, 6, 7}));
+    auto const pricey_prices = pricey.column<1>();
+    REQUIRE(pricey_prices->data() == prices.data());
+
+    // Filters compose, in place
+    auto const pricey_a = pricey.filter<2>([](char k) { return k == 'a'; },
+                                           tcb::ptr_to_mut_array(sel));
+    REQUIRE((indices(pricey_a) == std::vector<std::uint32_t>{2, 6}));
+
+    // Gathering materialises the selected values
+    std::vector<std::int32_t> out(8);
+    auto const gathered = pricey_a.gather<0>(tcb::ptr_to_mut_array(out));
+    REQUIRE(gathered->size() == 2);
+    REQUIRE(out[0] == 12);
+    REQUIRE(out[1] == 16);
+
+    // Projection keeps the selection
+    auto const projected = pricey_a.project<2, 0>();
+    REQUIRE(projected.num_columns() == 2);
+    REQUIRE(projected.size() == 2);
+    std::string seen;
+    projected.for_each_row([&](char k, std::int32_t id) { seen += k + std::to_string(id); });
+    REQUIRE(seen == "a12a16");
+
+    std::size_t rows = 0;
+    batch.for_each_row([&](std::int32_t, double, char) { ++rows; });
+    REQUIRE(rows == 8);
+
+    // Explicit selections, and dropping them
+    std::vector<std::uint32_t> const picked = {7, 0};
+    auto const picked_batch = batch.with_selection(tcb::ptr_to_array(picked));
+    auto const picked_ids = picked_batch.gather<0>(tcb::ptr_to_mut_array(out));
+    REQUIRE(picked_ids->size() == 2);
+    REQUIRE(out[0] == 17);
+    REQUIRE(out[1] == 10);
+    REQUIRE(picked_batch.without_selection().size() == 8);
+
+    return true;
+}
+
+bool test_select_bitmap()
+{
+    // Several words, the last one partial, with bits set past the end
+    std::size_t const n = 150;
+    std::vector<std::int32_t> ids(n);
+    std::vector<double> values(n);
+    std::vector<char> kinds(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        ids[i] = static_cast<std::int32_t>(i);
+    }
+    tcb::record_batch batch(col(ids), col(values), col(kinds));
+
+    std::vector<std::uint64_t> bitmap(3, 0);
+    std::vector<std::uint32_t> expected;
+    for (std::size_t i = 0; i < n; i += 7) {
+        bitmap[i / 64] |= std::uint64_t{1} << (i % 64);
+        expected.push_back(static_cast<std::uint32_t>(i));
+    }
+    bitmap[2] |= std::uint64_t{1} << 63;
+
+    std::vector<std::uint32_t> sel(n);
+    auto const selected = batch.select(tcb::ptr_to_array(bitmap), tcb::ptr_to_mut_array(sel));
+    REQUIRE(indices(selected) == expected);
+
+    // Selecting from a selection intersects them
+    auto const odd = batch.filter<0>([](std::int32_t id) { return id % 2 == 1; },
+                                     tcb::ptr_to_mut_array(sel));
+    std::vector<std::uint32_t> sel2(n);
+    auto const both = odd.select(tcb::ptr_to_array(bitmap), tcb::ptr_to_mut_array(sel2));
+    std::vector<std::uint32_t> odd_expected;
+    for (auto i : expected) {
+        if (i % 2 == 1) {
+            odd_expected.push_back(i);
+        }
+    }
+    REQUIRE(indices(both) == odd_expected);
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    std::vector<std::int32_t> const ids = {1, 2, 3};
+    std::vector<double> const short_col = {1.0, 2.0};
+    std::vector<char> const kinds = {'a', 'b', 'c'};
+    REQUIRE_ERROR(tcb::record_batch(col(ids), col(short_col), col(kinds)));
+
+    std::vector<double> const values = {1.0, 2.0, 3.0};
+    tcb::record_batch batch(col(ids), col(values), col(kinds));
+
+    std::vector<std::uint32_t> const bad = {0, 3};
+    REQUIRE_ERROR(batch.with_selection(tcb::ptr_to_array(bad)));
+
+    std::vector<std::uint32_t> small(2);
+    auto const all = [](std::int32_t) { return true; };
+    REQUIRE_ERROR(batch.filter<0>(all, tcb::ptr_to_mut_array(small)));
+    std::vector<std::int32_t> small_out(2);
+    REQUIRE_ERROR(batch.gather<0>(tcb::ptr_to_mut_array(small_out)));
+
+    std::vector<std::uint64_t> const bitmap = {1};
+    auto const bitmap_ptr = tcb::ptr_to_array(bitmap);
+    std::vector<std::uint32_t> sel(3);
+    REQUIRE_ERROR(batch.select(bitmap_ptr->first(0), tcb::ptr_to_mut_array(sel)));
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_record_batch();
+    REQUIRE(b);
+
+    b = test_select_bitmap();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+}
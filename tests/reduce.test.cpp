@@ -0,0 +1,254 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <tcb/reduce.hpp>
+
+#include "test_machinery.hpp"
+
+/*
+ * MARK: Test data
+ */
+
+template <typename T>
+std::vector<T> make_data(std::size_t n, unsigned seed = 1234)
+{
+    std::mt19937 gen(seed);
+    std::vector<T> vec(n);
+    if constexpr (std::is_floating_point_v<T>) {
+        std::uniform_real_distribution<T> dist(T(-100), T(100));
+        std::ranges::generate(vec, [&] { return dist(gen); });
+    } else {
+        // uniform_int_distribution isn't specified for character types
+        using D = std::conditional_t<(sizeof(T) < sizeof(int)), int, T>;
+        std::uniform_int_distribution<D> dist(std::numeric_limits<T>::min(),
+                                              std::numeric_limits<T>::max());
+        std::ranges::generate(vec, [&] { return static_cast<T>(dist(gen)); });
+    }
+    return vec;
+}
+
+// Sizes chosen to exercise the empty case, inputs shorter than one block,
+// and every possible tail length
+constexpr std::size_t test_sizes[] = {0, 1, 2, 3, 7, 8, 15, 16, 17, 31, 63, 64, 65, 127, 1000};
+
+/*
+ * MARK: sum() tests
+ */
+
+template <typename T>
+bool test_integer_sum()
+{
+    for (std::size_t n : test_sizes) {
+        auto vec = make_data<T>(n);
+        auto ptr = tcb::ptr_to_array(vec);
+
+        // Wrapping sum in T is the same however it's ordered
+        using U = std::make_unsigned_t<std::common_type_t<T, int>>;
+        T expected = std::accumulate(vec.begin(), vec.end(), T{}, [](T a, T b) {
+            return static_cast<T>(static_cast<U>(a) + static_cast<U>(b));
+        });
+        REQUIRE(tcb::sum(ptr) == expected);
+        REQUIRE(tcb::sum(*ptr) == expected);
+
+        // Accumulating into a wider type
+        auto wide = std::accumulate(vec.begin(), vec.end(), std::int64_t{0});
+        REQUIRE(tcb::sum(ptr, std::int64_t{0}) == wide);
+        REQUIRE(tcb::sum(ptr, std::int64_t{10}) == wide + 10);
+    }
+    return true;
+}
+
+template <typename T>
+bool test_float_sum()
+{
+    for (std::size_t n : test_sizes) {
+        auto vec = make_data<T>(n);
+        auto ptr = tcb::ptr_to_array(vec);
+
+        // Strict mode is bit-for-bit identical to std::accumulate
+        T expected = std::accumulate(vec.begin(), vec.end(), T{});
+        REQUIRE(tcb::sum(ptr) == expected);
+        REQUIRE(tcb::sum(ptr, tcb::fp_mode::strict) == expected);
+
+        // Fast mode is close enough
+        T fast = tcb::sum(ptr, tcb::fp_mode::fast);
+        REQUIRE(std::abs(fast - expected) <= T(1e-3) * static_cast<T>(n + 1));
+
+        // Accumulating floats as doubles
+        double dexpected = std::accumulate(vec.begin(), vec.end(), 0.0);
+        REQUIRE(tcb::sum(ptr, 0.0) == dexpected);
+    }
+
+    // Summing integers into a floating point accumulator is allowed
+    {
+        std::vector<int> vec{1, 2, 3, 4, 5};
+        REQUIRE(tcb::sum(tcb::ptr_to_array(vec), 0.5, tcb::fp_mode::fast) == 15.5);
+    }
+
+    return true;
+}
+
+/*
+ * MARK: dot() tests
+ */
+
+bool test_dot()
+{
+    for (std::size_t n : test_sizes) {
+        // 16-bit values, so that the sum of products can't overflow
+        auto a16 = make_data<std::int16_t>(n, 1);
+        auto b16 = make_data<std::int16_t>(n, 2);
+        std::vector<int> a(a16.begin(), a16.end());
+        std::vector<int> b(b16.begin(), b16.end());
+
+        auto expected = std::inner_product(a.begin(), a.end(), b.begin(), std::int64_t{0},
+                                           std::plus<>{}, [](std::int64_t x, std::int64_t y) {
+                                               return x * y;
+                                           });
+        REQUIRE(tcb::dot(tcb::ptr_to_array(a), tcb::ptr_to_array(b), std::int64_t{0})
+                == expected);
+    }
+
+    // Integer-valued doubles have exact products and sums, so the result
+    // doesn't depend on the evaluation order
+    for (std::size_t n : test_sizes) {
+        std::vector<double> a(n);
+        std::vector<double> b(n);
+        std::iota(a.begin(), a.end(), -10.0);
+        std::iota(b.begin(), b.end(), 3.0);
+
+        double expected = std::inner_product(a.begin(), a.end(), b.begin(), 0.0);
+        auto pa = tcb::ptr_to_array(a);
+        auto pb = tcb::ptr_to_array(b);
+        REQUIRE(tcb::dot(pa, pb) == expected);
+        REQUIRE(tcb::dot(pa, pb, tcb::fp_mode::fast) == expected);
+        REQUIRE(tcb::dot(*pa, *pb, 1.0, tcb::fp_mode::fast) == expected + 1.0);
+    }
+
+    // Mutable and const pointers can be mixed
+    {
+        std::vector<float> a{1, 2, 3};
+        std::vector<float> b{4, 5, 6};
+        REQUIRE(tcb::dot(tcb::ptr_to_mut_array(a), tcb::ptr_to_array(b)) == 32.0f);
+    }
+
+    // Size mismatches are an error
+    {
+        std::vector<int> a{1, 2, 3};
+        std::vector<int> b{1, 2};
+        REQUIRE_ERROR(tcb::dot(tcb::ptr_to_array(a), tcb::ptr_to_array(b)));
+    }
+
+    return true;
+}
+
+/*
+ * MARK: min()/max() tests
+ */
+
+template <typename T>
+bool test_extrema()
+{
+    for (std::size_t n : test_sizes) {
+        if (n == 0) {
+            continue;
+        }
+
+        auto vec = make_data<T>(n);
+        auto ptr = tcb::ptr_to_array(vec);
+
+        for (auto mode : {tcb::fp_mode::strict, tcb::fp_mode::fast}) {
+            REQUIRE(tcb::min(ptr, mode) == std::ranges::min(vec));
+            REQUIRE(tcb::max(ptr, mode) == std::ranges::max(vec));
+
+            auto [lo, hi] = tcb::minmax(ptr, mode);
+            REQUIRE(lo == std::ranges::min(vec));
+            REQUIRE(hi == std::ranges::max(vec));
+
+            auto min_pos = std::ranges::min_element(vec) - vec.begin();
+            auto max_pos = std::ranges::max_element(vec) - vec.begin();
+            REQUIRE(tcb::argmin(ptr, mode) == static_cast<std::size_t>(min_pos));
+            REQUIRE(tcb::argmax(ptr, mode) == static_cast<std::size_t>(max_pos));
+        }
+    }
+
+    // argmin() and argmax() return the *first* extreme element
+    {
+        std::vector<T> vec(100, T{5});
+        vec[40] = vec[70] = T{1};
+        vec[20] = vec[90] = T{9};
+        auto ptr = tcb::ptr_to_array(vec);
+        REQUIRE(tcb::argmin(ptr, tcb::fp_mode::fast) == 40);
+        REQUIRE(tcb::argmax(ptr, tcb::fp_mode::fast) == 20);
+    }
+
+    // Extrema of empty slices are an error
+    {
+        std::vector<T> empty;
+        auto ptr = tcb::ptr_to_array(empty);
+        REQUIRE_ERROR(tcb::min(ptr));
+        REQUIRE_ERROR(tcb::max(ptr));
+        REQUIRE_ERROR(tcb::minmax(ptr));
+        REQUIRE_ERROR(tcb::argmin(ptr));
+        REQUIRE_ERROR(tcb::argmax(ptr));
+    }
+
+    return true;
+}
+
+bool test_extrema_with_nan()
+{
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+
+    std::vector<double> vec(100, 1.0);
+    vec[50] = nan;
+    vec[60] = -1.0;
+    auto ptr = tcb::ptr_to_array(vec);
+
+    // Strict mode matches the standard library exactly
+    auto min_pos = std::ranges::min_element(vec) - vec.begin();
+    REQUIRE(tcb::argmin(ptr) == static_cast<std::size_t>(min_pos));
+    REQUIRE(tcb::min(ptr) == std::ranges::min(vec));
+
+    // Fast mode still returns a valid index
+    REQUIRE(tcb::argmin(ptr, tcb::fp_mode::fast) < vec.size());
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    // sum() tests
+    b = test_integer_sum<std::int8_t>() && test_integer_sum<std::uint16_t>()
+        && test_integer_sum<int>() && test_integer_sum<std::uint32_t>();
+    REQUIRE(b);
+    b = test_float_sum<float>() && test_float_sum<double>();
+    REQUIRE(b);
+
+    // dot() tests
+    b = test_dot();
+    REQUIRE(b);
+
+    // min()/max() tests
+    b = test_extrema<std::int8_t>() && test_extrema<int>() && test_extrema<std::uint64_t>()
+        && test_extrema<float>() && test_extrema<double>();
+    REQUIRE(b);
+    b = test_extrema_with_nan();
+    REQUIRE(b);
+}
@@ -0,0 +1,113 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <tcb/search_index.hpp>
+
+#include "test_machinery.hpp"
+
+/*
+ * MARK: search_index tests
+ */
+
+template <typename T>
+bool test_lower_bound()
+{
+    std::mt19937 gen(42);
+
+    // Sizes around powers of two give complete and nearly-complete trees
+    for (std::size_t n :
+         {0u, 1u, 2u, 3u, 4u, 7u, 8u, 9u, 15u, 16u, 17u, 100u, 255u, 256u, 1000u, 4097u}) {
+        std::uniform_int_distribution<int> dist(0, static_cast<int>(n) * 2);
+        std::vector<T> vec(n);
+        std::ranges::generate(vec, [&] { return static_cast<T>(dist(gen)); });
+        std::ranges::sort(vec);
+
+        auto index = tcb::search_index(tcb::ptr_to_array(vec));
+        REQUIRE(index.size() == n);
+
+        // Every key in range, plus keys below and above it
+        std::vector<T> keys;
+        for (int i = -1; i <= static_cast<int>(n) * 2 + 1; ++i) {
+            keys.push_back(static_cast<T>(i));
+        }
+
+        for (T key : keys) {
+            auto expected = std::ranges::lower_bound(vec, key) - vec.begin();
+            REQUIRE(index.lower_bound(key) == static_cast<std::size_t>(expected));
+        }
+
+        // Batched lookup gives the same answers, in order
+        std::ranges::shuffle(keys, gen);
+        std::vector<std::size_t> results(keys.size());
+        index.lower_bound(tcb::ptr_to_array(keys), tcb::ptr_to_mut_array(results));
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            auto expected = std::ranges::lower_bound(vec, keys[i]) - vec.begin();
+            REQUIRE(results[i] == static_cast<std::size_t>(expected));
+        }
+    }
+
+    return true;
+}
+
+bool test_duplicates()
+{
+    // lower_bound() finds the *first* of a run of equal elements
+    std::vector<int> vec{1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 3, 3, 5};
+    auto index = tcb::search_index(tcb::ptr_to_array(vec));
+
+    REQUIRE(index.lower_bound(0) == 0);
+    REQUIRE(index.lower_bound(1) == 0);
+    REQUIRE(index.lower_bound(2) == 3);
+    REQUIRE(index.lower_bound(3) == 10);
+    REQUIRE(index.lower_bound(4) == 12);
+    REQUIRE(index.lower_bound(5) == 12);
+    REQUIRE(index.lower_bound(6) == vec.size());
+
+    return true;
+}
+
+bool test_errors()
+{
+    // Unsorted input is an error
+    {
+        std::vector<int> vec{3, 2, 1};
+        REQUIRE_ERROR(tcb::search_index(tcb::ptr_to_array(vec)));
+    }
+
+    // Batched lookup output must be the same size as the input
+    {
+        std::vector<int> vec{1, 2, 3};
+        auto index = tcb::search_index(tcb::ptr_to_array(vec));
+
+        std::vector<int> keys{1, 2};
+        std::vector<std::size_t> out(3);
+        REQUIRE_ERROR(index.lower_bound(tcb::ptr_to_array(keys), tcb::ptr_to_mut_array(out)));
+    }
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_lower_bound<int>() && test_lower_bound<std::uint64_t>()
+        && test_lower_bound<double>() && test_lower_bound<std::int16_t>();
+    REQUIRE(b);
+
+    b = test_duplicates();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+}
@@ -0,0 +1,243 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <tcb/seqlock.hpp>
+
+#include "test_machinery.hpp"
+
+/*
+ * MARK: Test helpers
+ */
+
+// Not a whole number of words
+struct odd_size {
+    std::uint8_t bytes[3];
+
+    bool operator==(odd_size const&) const = default;
+};
+
+/*
+ * MARK: seqlock_buffer tests
+ */
+
+bool test_read_write()
+{
+    std::vector<int> init(100);
+    std::iota(init.begin(), init.end(), 0);
+    tcb::seqlock_buffer<int> buf(tcb::ptr_to_array(init));
+    REQUIRE(buf.size() == 100);
+
+    std::vector<int> out(100);
+    buf.read(tcb::ptr_to_mut_array(out));
+    REQUIRE(out == init);
+
+    // The writer starts with the current contents, and publishes on
+    // destruction
+    {
+        auto guard = buf.writer();
+        auto const data = guard.data();
+        REQUIRE(std::ranges::equal(*data, init));
+        (*data)[5] = -5;
+
+        // Not visible to readers until the guard is gone
+        buf.read(tcb::ptr_to_mut_array(out));
+        REQUIRE(out[5] == 5);
+    }
+    buf.read(tcb::ptr_to_mut_array(out));
+    REQUIRE(out[5] == -5);
+
+    int const old = buf.write([](tcb::pointer<int[]> data) {
+        int const prev = (*data)[0];
+        std::ranges::fill(*data, 3);
+        return prev;
+    });
+    REQUIRE(old == 0);
+
+    // Read in place
+    long const sum = buf.read([](tcb::pointer<int const[]> data) {
+        return std::accumulate(data->begin(), data->end(), 0L);
+    });
+    REQUIRE(sum == 300);
+
+    bool called = false;
+    buf.read([&](tcb::pointer<int const[]> data) { called = (*data)[99] == 3; });
+    REQUIRE(called);
+
+    return true;
+}
+
+bool test_odd_sizes()
+{
+    constexpr odd_size canary{{0xAA, 0xAA, 0xAA}};
+
+    for (std::size_t n : {0u, 1u, 2u, 3u, 5u, 8u, 13u}) {
+        std::vector<odd_size> init(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            auto const b = static_cast<std::uint8_t>(i);
+            init[i] = odd_size{
+                {b, static_cast<std::uint8_t>(b + 1), static_cast<std::uint8_t>(b + 2)}};
+        }
+        tcb::seqlock_buffer<odd_size> buf(tcb::ptr_to_array(init));
+
+        // Reads must not write past the end of the output
+        std::vector<odd_size> out(n + 1, canary);
+        auto const whole = tcb::ptr_to_mut_array(out);
+        buf.read(whole->first(n));
+        REQUIRE(std::equal(init.begin(), init.end(), out.begin()));
+        REQUIRE(out.back() == canary);
+
+        buf.write([](tcb::pointer<odd_size[]> data) {
+            for (auto& elem : *data) {
+                elem.bytes[1] = 0xFF;
+            }
+        });
+        buf.read(whole->first(n));
+        REQUIRE(std::ranges::all_of(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(n),
+                                    [](odd_size const& e) { return e.bytes[1] == 0xFF; }));
+        REQUIRE(out.back() == canary);
+    }
+
+    return true;
+}
+
+bool test_writer_exception()
+{
+    std::vector<int> init(10, 1);
+    tcb::seqlock_buffer<int> buf(tcb::ptr_to_array(init));
+
+    // Changes made by a writer which throws are discarded
+    REQUIRE_THROWS_AS(std::logic_error, buf.write([](tcb::pointer<int[]> data) {
+        (*data)[0] = 2;
+        throw std::logic_error("oops");
+    }));
+
+    std::vector<int> out(10);
+    buf.read(tcb::ptr_to_mut_array(out));
+    REQUIRE(out == init);
+
+    // ...and the next writer starts from the published contents
+    buf.write([](tcb::pointer<int[]> data) { REQUIRE((*data)[0] == 1); });
+
+    return true;
+}
+
+bool test_concurrent()
+{
+    // Writers set every element to the same version number, so a reader
+    // which sees two different values has seen a torn write
+    constexpr std::size_t size = 1000;
+    constexpr std::uint64_t writes_per_writer = 2000;
+    std::vector<std::uint64_t> init(size, 0);
+    tcb::seqlock_buffer<std::uint64_t> buf(tcb::ptr_to_array(init));
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> torn{false};
+
+    auto reader = [&](bool in_place) {
+        std::vector<std::uint64_t> out(size);
+        std::uint64_t last = 0;
+        while (!done.load(std::memory_order_relaxed)) {
+            std::uint64_t first_elem = 0;
+            bool consistent = true;
+            if (in_place) {
+                buf.read([&](tcb::pointer<std::uint64_t const[]> data) {
+                    first_elem = (*data)[0];
+                    consistent = std::ranges::all_of(
+                        *data, [&](std::uint64_t v) { return v == first_elem; });
+                });
+            } else {
+                buf.read(tcb::ptr_to_mut_array(out));
+                first_elem = out[0];
+                consistent
+                    = std::ranges::all_of(out, [&](std::uint64_t v) { return v == first_elem; });
+            }
+            // Versions never go backwards
+            if (!consistent || first_elem < last) {
+                torn = true;
+            }
+            last = first_elem;
+        }
+    };
+
+    {
+        std::vector<std::jthread> readers;
+        readers.emplace_back(reader, false);
+        readers.emplace_back(reader, true);
+
+        {
+            std::vector<std::jthread> writers;
+            for (int w = 0; w < 2; ++w) {
+                writers.emplace_back([&] {
+                    for (std::uint64_t i = 0; i < writes_per_writer; ++i) {
+                        buf.write([](tcb::pointer<std::uint64_t[]> data) {
+                            std::uint64_t const next = (*data)[0] + 1;
+                            for (auto& v : *data) {
+                                v = next;
+                            }
+                        });
+                    }
+                });
+            }
+        }
+        done = true;
+    }
+
+    REQUIRE(!torn);
+
+    // No writes were lost
+    std::vector<std::uint64_t> out(size);
+    buf.read(tcb::ptr_to_mut_array(out));
+    REQUIRE(std::ranges::all_of(out, [](std::uint64_t v) { return v == 2 * writes_per_writer; }));
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    std::vector<int> init(10);
+    tcb::seqlock_buffer<int> buf(tcb::ptr_to_array(init));
+
+    std::vector<int> out(11);
+    auto const whole = tcb::ptr_to_mut_array(out);
+    REQUIRE_ERROR(buf.read(whole));
+    REQUIRE_ERROR(buf.read(whole->first(9)));
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_read_write();
+    REQUIRE(b);
+
+    b = test_odd_sizes();
+    REQUIRE(b);
+
+    b = test_writer_exception();
+    REQUIRE(b);
+
+    b = test_concurrent();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+}
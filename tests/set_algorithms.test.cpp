@@ -0,0 +1,281 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tcb/set_algorithms.hpp>
+
+#include "test_machinery.hpp"
+
+/*
+ * MARK: Test helpers
+ */
+
+// A sorted vector of n distinct values drawn from [0, range)
+template <typename T>
+auto make_set(std::size_t n, int range, std::mt19937& gen) -> std::vector<T>
+{
+    std::uniform_int_distribution<int> dist(0, range - 1);
+    std::vector<T> vec(n);
+    std::ranges::generate(vec, [&] { return static_cast<T>(dist(gen)); });
+    std::ranges::sort(vec);
+    vec.erase(std::unique(vec.begin(), vec.end()), vec.end());
+    return vec;
+}
+
+template <typename T>
+auto as_vector(tcb::pointer<T[]> const& ptr) -> std::vector<std::remove_const_t<T>>
+{
+    return std::vector<std::remove_const_t<T>>(ptr->begin(), ptr->end());
+}
+
+/*
+ * MARK: set_intersection() tests
+ */
+
+template <typename T>
+bool test_intersection()
+{
+    std::mt19937 gen(42);
+
+    // Sizes either side of the block width, and skewed enough to gallop
+    std::pair<std::size_t, std::size_t> const sizes[] = {
+        {0, 0},   {0, 10},   {10, 0},    {1, 1},      {7, 9},     {8, 8},
+        {15, 17}, {100, 100}, {1000, 500}, {10, 1000}, {1000, 10}, {3, 10000},
+    };
+
+    for (auto [na, nb] : sizes) {
+        for (int range : {20, 1000, 100000}) {
+            auto const a = make_set<T>(na, range, gen);
+            auto const b = make_set<T>(nb, range, gen);
+
+            std::vector<T> expected;
+            std::ranges::set_intersection(a, b, std::back_inserter(expected));
+
+            std::vector<T> buffer(std::min(a.size(), b.size()));
+            auto result = tcb::set_intersection(tcb::ptr_to_array(a), tcb::ptr_to_array(b),
+                                                tcb::ptr_to_mut_array(buffer));
+            REQUIRE(as_vector(result) == expected);
+            REQUIRE(result->data() == buffer.data());
+        }
+    }
+
+    return true;
+}
+
+bool test_intersection_non_arithmetic()
+{
+    std::vector<std::string> const a{"apple", "banana", "cherry", "damson", "elderberry"};
+    std::vector<std::string> const b{"banana", "cranberry", "damson", "fig"};
+
+    std::vector<std::string> buffer(4);
+    auto result = tcb::set_intersection(tcb::ptr_to_array(a), tcb::ptr_to_array(b),
+                                        tcb::ptr_to_mut_array(buffer));
+    REQUIRE(as_vector(result) == (std::vector<std::string>{"banana", "damson"}));
+
+    return true;
+}
+
+template <typename T>
+bool test_intersection_duplicates()
+{
+    std::mt19937 gen(7);
+
+    // Runs of equal elements, within and across blocks, in either input
+    std::vector<T> const sixteen_fives(16, T(5));
+    std::vector<T> const five_to_twelve{5, 6, 7, 8, 9, 10, 11, 12};
+    std::vector<std::pair<std::vector<T>, std::vector<T>>> cases{
+        {sixteen_fives, five_to_twelve},
+        {five_to_twelve, sixteen_fives},
+        {sixteen_fives, sixteen_fives},
+    };
+    for (std::size_t n : {20u, 100u, 1000u}) {
+        std::uniform_int_distribution<int> dist(0, 30);
+        std::vector<T> a(n);
+        std::vector<T> b(n / 2 + 9);
+        std::ranges::generate(a, [&] { return static_cast<T>(dist(gen)); });
+        std::ranges::generate(b, [&] { return static_cast<T>(dist(gen)); });
+        std::ranges::sort(a);
+        std::ranges::sort(b);
+        cases.emplace_back(std::move(a), std::move(b));
+    }
+
+    for (auto const& [a, b] : cases) {
+        std::vector<T> expected;
+        std::ranges::set_intersection(a, b, std::back_inserter(expected));
+
+        // Exactly as much room as required, so ASan sees any overflow
+        auto buffer = std::make_unique<T[]>(std::min(a.size(), b.size()));
+        auto result = tcb::set_intersection(
+            tcb::ptr_to_array(a), tcb::ptr_to_array(b),
+            tcb::pointer<T[]>::from_address_with_size(buffer.get(), std::min(a.size(), b.size())));
+        REQUIRE(as_vector(result) == expected);
+    }
+
+    return true;
+}
+
+/*
+ * MARK: set_union() and merge() tests
+ */
+
+template <typename T>
+bool test_union_and_merge()
+{
+    std::mt19937 gen(1729);
+
+    for (std::size_t n : {0u, 1u, 5u, 16u, 100u, 1000u}) {
+        auto const a = make_set<T>(n, 1000, gen);
+        auto const b = make_set<T>(n / 2 + 3, 1000, gen);
+        std::vector<T> buffer(a.size() + b.size());
+
+        std::vector<T> expected;
+        std::ranges::set_union(a, b, std::back_inserter(expected));
+        auto result = tcb::set_union(tcb::ptr_to_array(a), tcb::ptr_to_array(b),
+                                     tcb::ptr_to_mut_array(buffer));
+        REQUIRE(as_vector(result) == expected);
+
+        expected.clear();
+        std::ranges::merge(a, b, std::back_inserter(expected));
+        result = tcb::merge(tcb::ptr_to_array(a), tcb::ptr_to_array(b),
+                            tcb::ptr_to_mut_array(buffer));
+        REQUIRE(as_vector(result) == expected);
+    }
+
+    return true;
+}
+
+bool test_kway_merge()
+{
+    std::mt19937 gen(99);
+
+    for (std::size_t k : {0u, 1u, 2u, 3u, 5u, 8u, 13u}) {
+        std::vector<std::vector<std::uint32_t>> lists;
+        for (std::size_t i = 0; i < k; ++i) {
+            // Include some empty inputs, and plenty of duplicates
+            std::uniform_int_distribution<std::uint32_t> dist(0, 50);
+            std::vector<std::uint32_t> list(i % 4 == 3 ? 0 : 20 * i + 1);
+            std::ranges::generate(list, [&] { return dist(gen); });
+            std::ranges::sort(list);
+            lists.push_back(std::move(list));
+        }
+
+        std::vector<std::uint32_t> expected;
+        std::vector<tcb::pointer<std::uint32_t const[]>> inputs;
+        for (auto const& list : lists) {
+            expected.insert(expected.end(), list.begin(), list.end());
+            inputs.push_back(tcb::ptr_to_array(list));
+        }
+        std::ranges::sort(expected);
+
+        std::vector<std::uint32_t> buffer(expected.size() + 5);
+        auto result = tcb::merge(tcb::ptr_to_array(inputs), tcb::ptr_to_mut_array(buffer));
+        REQUIRE(as_vector(result) == expected);
+    }
+
+    return true;
+}
+
+bool test_kway_merge_stability()
+{
+    // Elements compare by key only; equal keys must come out in input order
+    struct item {
+        int key;
+        int source;
+
+        bool operator==(item const& other) const { return key == other.key; }
+        auto operator<=>(item const& other) const { return key <=> other.key; }
+    };
+
+    std::vector<item> const a{{1, 0}, {2, 0}, {2, 0}, {5, 0}};
+    std::vector<item> const b{{2, 1}, {5, 1}};
+    std::vector<item> const c{{1, 2}, {2, 2}, {6, 2}};
+    std::vector<item> const d{{2, 3}};
+
+    std::vector inputs{tcb::ptr_to_array(a), tcb::ptr_to_array(b), tcb::ptr_to_array(c),
+                       tcb::ptr_to_array(d)};
+    std::vector<item> buffer(10);
+    auto result = tcb::merge(tcb::ptr_to_array(inputs), tcb::ptr_to_mut_array(buffer));
+
+    std::vector<std::pair<int, int>> actual;
+    for (item const& i : *result) {
+        actual.emplace_back(i.key, i.source);
+    }
+    REQUIRE(actual
+            == (std::vector<std::pair<int, int>>{
+                {1, 0}, {1, 2}, {2, 0}, {2, 0}, {2, 1}, {2, 2}, {2, 3}, {5, 0}, {5, 1}, {6, 2}}));
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    std::vector<int> const a{1, 2, 3, 4};
+    std::vector<int> const b{2, 4, 6};
+    std::vector<int> small(2);
+
+    REQUIRE_ERROR(tcb::set_intersection(tcb::ptr_to_array(a), tcb::ptr_to_array(b),
+                                        tcb::ptr_to_mut_array(small)));
+    REQUIRE_ERROR(
+        tcb::set_union(tcb::ptr_to_array(a), tcb::ptr_to_array(b), tcb::ptr_to_mut_array(small)));
+    REQUIRE_ERROR(
+        tcb::merge(tcb::ptr_to_array(a), tcb::ptr_to_array(b), tcb::ptr_to_mut_array(small)));
+
+    std::vector inputs{tcb::ptr_to_array(a), tcb::ptr_to_array(b), tcb::ptr_to_array(a)};
+    REQUIRE_ERROR(tcb::merge(tcb::ptr_to_array(inputs), tcb::ptr_to_mut_array(small)));
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_intersection<std::uint32_t>();
+    REQUIRE(b);
+
+    b = test_intersection<std::int16_t>();
+    REQUIRE(b);
+
+    b = test_intersection<double>();
+    REQUIRE(b);
+
+    b = test_intersection_duplicates<std::uint32_t>();
+    REQUIRE(b);
+
+    b = test_intersection_duplicates<double>();
+    REQUIRE(b);
+
+    b = test_intersection_non_arithmetic();
+    REQUIRE(b);
+
+    b = test_union_and_merge<std::uint32_t>();
+    REQUIRE(b);
+
+    b = test_union_and_merge<float>();
+    REQUIRE(b);
+
+    b = test_kway_merge();
+    REQUIRE(b);
+
+    b = test_kway_merge_stability();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+}
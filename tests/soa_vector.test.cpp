@@ -0,0 +1,197 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <tcb/reduce.hpp>
+#include <tcb/soa_vector.hpp>
+
+#include "test_machinery.hpp"
+
+using particles = tcb::soa_vector<float, float, std::int32_t>;
+
+static_assert(std::ranges::random_access_range<particles>);
+static_assert(std::ranges::random_access_range<particles const>);
+static_assert(std::ranges::sized_range<particles>);
+static_assert(std::is_nothrow_default_constructible_v<particles>);
+static_assert(std::is_nothrow_move_constructible_v<particles>);
+
+/*
+ * MARK: soa_vector tests
+ */
+
+bool test_soa_vector()
+{
+    particles p;
+    REQUIRE(p.empty());
+    REQUIRE(p.capacity() == 0);
+    auto const empty_xs = p.column<0>();
+    REQUIRE(empty_xs->size() == 0);
+
+    for (std::int32_t i = 0; i < 100; ++i) {
+        p.push_back(static_cast<float>(i), 1.0f, i);
+    }
+    REQUIRE(p.size() == 100);
+    // Capacity doubles from the minimum of 16
+    REQUIRE(p.capacity() == 128);
+
+    // Rows unpack into references to the fields
+    for (auto [x, v, id] : p) {
+        x += v * 2;
+    }
+    auto const [x5, v5, id5] = p[5];
+    REQUIRE(x5 == 7.0f);
+    REQUIRE(v5 == 1.0f);
+    REQUIRE(id5 == 5);
+
+    // Columns are contiguous, aligned, and work with the slice algorithms
+    tcb::pointer<float[]> const xs = p.column<0>();
+    REQUIRE(xs->size() == 100);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(xs->data()) % 64 == 0);
+    REQUIRE(tcb::sum(p.column<2>()) == 4950);
+    REQUIRE(tcb::sum(xs, 0.0) == 4950.0 + 200.0);
+    (*xs)[0] = -1.0f;
+    REQUIRE(std::get<0>(p[0]) == -1.0f);
+
+    // emplace_back returns the new row
+    auto [x, v, id] = p.emplace_back(1.5, 2.5f, 7);
+    REQUIRE(x == 1.5f);
+    id = 8;
+    auto const ids = p.column<2>();
+    REQUIRE(ids->back() == 8);
+
+    p.pop_back();
+    REQUIRE(p.size() == 100);
+    p.resize(10);
+    REQUIRE(p.size() == 10);
+    p.resize(20);
+    REQUIRE(std::get<2>(p[19]) == 0);
+    p.clear();
+    REQUIRE(p.empty());
+
+    return true;
+}
+
+bool test_iterators()
+{
+    particles p(10);
+    std::int32_t n = 0;
+    auto const ids = p.column<2>();
+    for (auto& id : *ids) {
+        id = n++;
+    }
+
+    auto it = p.begin();
+    REQUIRE(std::get<2>(it[3]) == 3);
+    it += 4;
+    REQUIRE(std::get<2>(*it) == 4);
+    REQUIRE(p.end() - it == 6);
+    REQUIRE(it > p.begin());
+
+    particles const& cp = p;
+    particles::const_iterator cit = p.begin();
+    REQUIRE(cit == cp.begin());
+    REQUIRE(std::ranges::distance(cp) == 10);
+
+    auto evens = p | std::views::filter([](auto row) { return std::get<2>(row) % 2 == 0; });
+    REQUIRE(std::ranges::distance(evens) == 5);
+
+    return true;
+}
+
+bool test_copy_move()
+{
+    // Non-trivial fields are constructed, copied, moved and destroyed
+    auto shared = std::make_shared<int>(0);
+    {
+        tcb::soa_vector<std::string, std::shared_ptr<int>> a;
+        for (int i = 0; i < 50; ++i) {
+            a.emplace_back(std::to_string(i), shared);
+        }
+        REQUIRE(shared.use_count() == 51);
+
+        auto b = a;
+        REQUIRE(shared.use_count() == 101);
+        REQUIRE(std::get<0>(b[49]) == "49");
+
+        auto c = std::move(a);
+        REQUIRE(a.empty());
+        // A moved-from vector's columns are empty, but still non-null
+        auto const names = a.column<0>();
+        REQUIRE(names->empty());
+        auto const ptrs = std::as_const(a).column<1>();
+        REQUIRE(ptrs->empty());
+        REQUIRE(a.begin() == a.end());
+        REQUIRE(shared.use_count() == 101);
+        REQUIRE(std::get<0>(c[10]) == "10");
+
+        // A moved-from vector can be reused
+        a.emplace_back("again", nullptr);
+        REQUIRE(a.size() == 1);
+
+        b = c;
+        REQUIRE(shared.use_count() == 101);
+        c = std::move(b);
+        REQUIRE(shared.use_count() == 51);
+    }
+    REQUIRE(shared.use_count() == 1);
+
+    // A throwing field constructor leaves the vector unchanged
+    struct throws {
+        explicit throws(int i)
+        {
+            if (i < 0) {
+                throw std::runtime_error("negative");
+            }
+        }
+    };
+    tcb::soa_vector<std::string, throws> t;
+    t.emplace_back("ok", 1);
+    REQUIRE_THROWS_AS(std::runtime_error, t.emplace_back("bad", -1));
+    REQUIRE(t.size() == 1);
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    particles p(3);
+    REQUIRE_THROWS_AS(std::out_of_range, p[3]);
+    REQUIRE_ERROR(*p.end());
+
+    particles empty;
+    REQUIRE_ERROR(empty.pop_back());
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_soa_vector();
+    REQUIRE(b);
+
+    b = test_iterators();
+    REQUIRE(b);
+
+    b = test_copy_move();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+}
@@ -0,0 +1,186 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tcb/split.hpp>
+
+#include "test_machinery.hpp"
+
+static_assert(std::ranges::view<tcb::split_view>);
+static_assert(std::ranges::forward_range<tcb::split_view>);
+
+/*
+ * MARK: Test helpers
+ */
+
+auto ptr(std::string const& str) -> tcb::pointer<char const[]>
+{
+    return tcb::pointer<char const[]>::from_address_with_size(str.data(), str.size());
+}
+
+auto tokens(std::string const& text, std::string_view delims,
+            tcb::empty_tokens empty = tcb::empty_tokens::keep) -> std::vector<std::string_view>
+{
+    std::vector<std::string_view> out;
+    for (tcb::pointer<char const[]> token : tcb::split(ptr(text), delims, empty)) {
+        out.emplace_back(token->data(), token->size());
+    }
+    return out;
+}
+
+// The obvious implementation
+auto naive_tokens(std::string_view text, std::string_view delims, tcb::empty_tokens empty)
+    -> std::vector<std::string_view>
+{
+    std::vector<std::string_view> out;
+    if (text.empty()) {
+        return out;
+    }
+    std::size_t start = 0;
+    while (true) {
+        std::size_t const pos = text.find_first_of(delims, start);
+        std::size_t const end = pos == std::string_view::npos ? text.size() : pos;
+        if (end > start || empty == tcb::empty_tokens::keep) {
+            out.push_back(text.substr(start, end - start));
+        }
+        if (pos == std::string_view::npos) {
+            return out;
+        }
+        start = pos + 1;
+    }
+}
+
+/*
+ * MARK: split tests
+ */
+
+bool test_split()
+{
+    using toks = std::vector<std::string_view>;
+    constexpr auto skip = tcb::empty_tokens::skip;
+
+    REQUIRE(tokens("", ",").empty());
+    REQUIRE((tokens("abc", ",") == toks{"abc"}));
+    REQUIRE((tokens("a,b,c", ",") == toks{"a", "b", "c"}));
+    REQUIRE((tokens("a,b,", ",") == toks{"a", "b", ""}));
+    REQUIRE((tokens(",a,,b", ",") == toks{"", "a", "", "b"}));
+    REQUIRE((tokens(",", ",") == toks{"", ""}));
+    REQUIRE((tokens("a b\tc=d", " \t=") == toks{"a", "b", "c", "d"}));
+
+    REQUIRE(tokens(",,,", ",", skip).empty());
+    REQUIRE((tokens("  GET   /index.html  HTTP/1.1 ", " ", skip)
+             == toks{"GET", "/index.html", "HTTP/1.1"}));
+
+    // The char overload, and tokens which point into the text
+    std::string const text = "key=value";
+    auto view = tcb::split(ptr(text), '=');
+    auto it = view.begin();
+    tcb::pointer<char const[]> const key = *it;
+    REQUIRE(key->data() == text.data());
+    ++it;
+    tcb::pointer<char const[]> const value = *it;
+    REQUIRE(value->data() == text.data() + 4);
+    REQUIRE(value->size() == 5);
+    ++it;
+    REQUIRE(it == view.end());
+
+    // Iterators are forward iterators, and can be compared
+    auto a = view.begin();
+    auto b = a++;
+    REQUIRE(b == view.begin());
+    REQUIRE(a != b);
+    REQUIRE(std::ranges::distance(view) == 2);
+
+    return true;
+}
+
+bool test_against_naive()
+{
+    std::mt19937 gen(1234);
+    // Delimiter sets which exercise the single-character, SWAR, table and
+    // shuffle paths, including bytes with the top bit set and NUL
+    std::vector<std::string> const delim_sets = {
+        ",",
+        " \t",
+        std::string("\0\n", 2),
+        ",;:|",
+        " \t\r\n,;:=",
+        "\x80\xff\x7f\x01",
+        std::string("abcdefghijklmnop"),
+        std::string("\x00\x10\x20\x30\x40\x50\x60\x70\x80\x90\xa0\xb0\xc0\xd0\xe0\xf0", 16),
+    };
+    for (auto const& delims : delim_sets) {
+        std::uniform_int_distribution<int> byte_dist(0, 255);
+        std::uniform_int_distribution<std::size_t> delim_dist(0, delims.size() - 1);
+        for (std::size_t size : {1u, 63u, 64u, 65u, 130u, 1000u, 5000u}) {
+            for (int density : {2, 10, 100}) {
+                std::string text(size, '\0');
+                for (auto& c : text) {
+                    c = byte_dist(gen) % density == 0 ? delims[delim_dist(gen)]
+                                                      : static_cast<char>(byte_dist(gen));
+                }
+                for (auto empty : {tcb::empty_tokens::keep, tcb::empty_tokens::skip}) {
+                    REQUIRE(tokens(text, delims, empty) == naive_tokens(text, delims, empty));
+                }
+            }
+        }
+    }
+
+    // Every byte value, alone and as the 16th delimiter
+    for (int c = 0; c < 256; ++c) {
+        std::string text;
+        for (int i = 0; i < 300; ++i) {
+            text.push_back(static_cast<char>((i * 7 + c) % 256));
+        }
+        std::string const one(1, static_cast<char>(c));
+        std::string const many = "ABCDEFGHIJKLMNO" + one;
+        REQUIRE(tokens(text, one) == naive_tokens(text, one, tcb::empty_tokens::keep));
+        REQUIRE(tokens(text, many) == naive_tokens(text, many, tcb::empty_tokens::keep));
+    }
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    std::string const text = "a,b";
+    REQUIRE_ERROR(tcb::split(ptr(text), ""));
+    REQUIRE_ERROR(tcb::split(ptr(text), "0123456789abcdefg"));
+
+    auto view = tcb::split(ptr(text), ",");
+    auto it = view.begin();
+    ++it;
+    ++it;
+    REQUIRE(it == view.end());
+    REQUIRE_ERROR(*it);
+    REQUIRE_ERROR(++it);
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_split();
+    REQUIRE(b);
+
+    b = test_against_naive();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+}
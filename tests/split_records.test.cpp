@@ -0,0 +1,236 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <tcb/split_records.hpp>
+
+#include "test_machinery.hpp"
+
+/*
+ * MARK: Test helpers
+ */
+
+auto view(tcb::pointer<char const[]> slice) -> std::string_view
+{
+    return std::string_view(slice->data(), slice->size());
+}
+
+// The obvious implementation
+auto naive_split(std::string_view text, char delimiter) -> std::vector<std::string_view>
+{
+    std::vector<std::string_view> records;
+    std::size_t start = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == delimiter) {
+            records.push_back(text.substr(start, i - start));
+            start = i + 1;
+        }
+    }
+    if (start < text.size()) {
+        records.push_back(text.substr(start));
+    }
+    return records;
+}
+
+auto views(std::vector<tcb::pointer<char const[]>> const& slices) -> std::vector<std::string_view>
+{
+    std::vector<std::string_view> out;
+    for (auto const& slice : slices) {
+        out.push_back(view(slice));
+    }
+    return out;
+}
+
+// Random text, with records of lengths up to max_len
+auto random_text(std::mt19937& gen, std::size_t size, std::size_t max_len, char delimiter)
+    -> std::string
+{
+    std::uniform_int_distribution<std::size_t> len_dist(0, max_len);
+    std::uniform_int_distribution<int> char_dist('a', 'z');
+    std::string text;
+    while (text.size() < size) {
+        std::size_t const len = len_dist(gen);
+        for (std::size_t i = 0; i < len; ++i) {
+            text.push_back(static_cast<char>(char_dist(gen)));
+        }
+        text.push_back(delimiter);
+    }
+    text.resize(size);
+    return text;
+}
+
+auto ptr(std::string const& str) -> tcb::pointer<char const[]>
+{
+    return tcb::pointer<char const[]>::from_address_with_size(str.data(), str.size());
+}
+
+/*
+ * MARK: split_records tests
+ */
+
+bool test_split_records()
+{
+    // Small cases
+    using records = std::vector<std::string_view>;
+    auto split = [](std::string const& text) { return views(tcb::split_records(ptr(text))); };
+    REQUIRE(split("").empty());
+    REQUIRE((split("abc") == records{"abc"}));
+    REQUIRE((split("a\nb\n") == records{"a", "b"}));
+    REQUIRE((split("a\nb") == records{"a", "b"}));
+    REQUIRE((split("a\n\nb") == records{"a", "", "b"}));
+    REQUIRE((split("\n") == records{""}));
+    REQUIRE((split("\n\n") == records{"", ""}));
+
+    // Records which point into the text
+    std::string const text = "one,two,three";
+    auto const parts = tcb::split_records(ptr(text), ',');
+    REQUIRE(parts.size() == 3);
+    REQUIRE(parts[1]->data() == text.data() + 4);
+
+    // Delimiters everywhere around block boundaries, and bytes with the top
+    // bit set, which mustn't confuse the SWAR comparison
+    for (std::size_t size : {63u, 64u, 65u, 127u, 128u, 129u, 200u}) {
+        for (std::size_t pos = 0; pos < size; ++pos) {
+            std::string str(size, '\x8a');
+            str[pos] = '\x0a';
+            REQUIRE(views(tcb::split_records(ptr(str))) == naive_split(str, '\n'));
+        }
+        std::string all(size, '\n');
+        REQUIRE(tcb::split_records(ptr(all)).size() == size);
+    }
+
+    // Random texts, with short and long records
+    std::mt19937 gen(1234);
+    for (std::size_t max_len : {0u, 1u, 5u, 80u, 1000u}) {
+        for (char delimiter : {'\n', '\0', '|'}) {
+            auto const str = random_text(gen, 10'000, max_len, delimiter);
+            REQUIRE(views(tcb::split_records(ptr(str), delimiter)) == naive_split(str, delimiter));
+        }
+    }
+
+    // The appending overload
+    std::vector<tcb::pointer<char const[]>> out;
+    tcb::split_records(ptr(text), ',', out);
+    tcb::split_records(ptr(text), 'o', out);
+    REQUIRE(out.size() == 6);
+
+    return true;
+}
+
+/*
+ * MARK: partition_records tests
+ */
+
+bool test_partition_records()
+{
+    std::mt19937 gen(42);
+    for (std::size_t max_len : {0u, 10u, 100u, 5000u}) {
+        auto const str = random_text(gen, 20'000, max_len, '\n');
+        auto const text = ptr(str);
+        for (std::size_t parts : {1u, 2u, 3u, 7u, 64u, 50'000u}) {
+            auto const pieces = tcb::partition_records(text, parts);
+            REQUIRE(!pieces.empty());
+            REQUIRE(pieces.size() <= parts);
+
+            // Contiguous, non-empty, covering the text, and ending after a
+            // delimiter
+            char const* next = str.data();
+            for (std::size_t i = 0; i < pieces.size(); ++i) {
+                REQUIRE(pieces[i]->data() == next);
+                REQUIRE(!pieces[i]->empty());
+                if (i + 1 < pieces.size()) {
+                    REQUIRE(pieces[i]->back() == '\n');
+                }
+                next += pieces[i]->size();
+            }
+            REQUIRE(next == str.data() + str.size());
+
+            // Short records go round
+            if (max_len == 10 && parts <= 64) {
+                REQUIRE(pieces.size() == parts);
+            }
+        }
+    }
+
+    // Boundaries which land just after a delimiter stay put
+    std::string const even = "aaa\nbbb\nccc\nddd\n";
+    auto const pieces = tcb::partition_records(ptr(even), 4);
+    REQUIRE(pieces.size() == 4);
+    REQUIRE(view(pieces[1]) == "bbb\n");
+
+    // One long record can't be divided
+    std::string const single(1000, 'x');
+    REQUIRE(tcb::partition_records(ptr(single), 8).size() == 1);
+    REQUIRE(tcb::partition_records(ptr(std::string()), 8).empty());
+
+    return true;
+}
+
+/*
+ * MARK: Parallel tests
+ */
+
+bool test_parallel_split()
+{
+    std::mt19937 gen(7);
+    auto const str = random_text(gen, 10 << 20, 120, '\n');
+    auto const expected = naive_split(str, '\n');
+
+    for (std::size_t threads : {1u, 3u, 8u}) {
+        auto const per_task = tcb::split_records(tcb::parallel_t{threads}, ptr(str));
+        REQUIRE(per_task.size() <= threads);
+        std::vector<std::string_view> all;
+        for (auto const& records : per_task) {
+            REQUIRE(!records.empty());
+            auto const v = views(records);
+            all.insert(all.end(), v.begin(), v.end());
+        }
+        REQUIRE(all == expected);
+    }
+
+    // Small inputs use one task
+    std::string const small = "a\nb\nc";
+    REQUIRE(tcb::split_records(tcb::parallel, ptr(small)).size() == 1);
+    REQUIRE(tcb::split_records(tcb::parallel, ptr(std::string())).empty());
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    std::string const text = "a\nb";
+    REQUIRE_ERROR(tcb::partition_records(ptr(text), 0));
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_split_records();
+    REQUIRE(b);
+
+    b = test_partition_records();
+    REQUIRE(b);
+
+    b = test_parallel_split();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+}
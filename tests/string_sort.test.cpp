@@ -0,0 +1,250 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <tcb/string_sort.hpp>
+
+#include "test_machinery.hpp"
+
+/*
+ * MARK: Test helpers
+ */
+
+template <typename C>
+auto slices(std::vector<std::basic_string<C>> const& strs) -> std::vector<tcb::pointer<C const[]>>
+{
+    std::vector<tcb::pointer<C const[]>> out;
+    for (auto const& str : strs) {
+        out.push_back(tcb::pointer<C const[]>::from_address_with_size(str.data(), str.size()));
+    }
+    return out;
+}
+
+// Sorts with string_sort, and checks the result against std::sort
+template <typename C>
+bool sorts_like_std_sort(std::vector<tcb::pointer<C const[]>> keys)
+{
+    auto expected = keys;
+    std::sort(expected.begin(), expected.end(),
+              [](auto const& a, auto const& b) { return *a < *b; });
+
+    tcb::string_sort(tcb::ptr_to_mut_array(keys));
+    // Equal keys may be in any order, so compare the contents
+    return std::ranges::equal(keys, expected,
+                              [](auto const& a, auto const& b) { return *a == *b; });
+}
+
+auto random_strings(std::size_t n, std::size_t max_len, int alphabet, std::string const& prefix)
+    -> std::vector<std::string>
+{
+    std::mt19937 gen(5678);
+    std::uniform_int_distribution<std::size_t> len_dist(0, max_len);
+    std::uniform_int_distribution<int> char_dist(0, alphabet - 1);
+    std::vector<std::string> out;
+    for (std::size_t i = 0; i < n; ++i) {
+        std::string str = prefix;
+        for (std::size_t len = len_dist(gen); len > 0; --len) {
+            str.push_back(static_cast<char>(char_dist(gen) + (alphabet > 26 ? 0 : 'a')));
+        }
+        out.push_back(std::move(str));
+    }
+    return out;
+}
+
+// Keys which make every partitioning step of string_sort() split off just
+// two keys, so that without a limit on its recursion it would go n / 2
+// levels deep. It replays the partitioning on labels whose values are
+// decided as late as possible, as McIlroy's adversary does for comparison
+// sorts: two of the three keys sampled for the pivot get the next smallest
+// values, and every key without a value yet is greater than them.
+auto quicksort_killer(std::size_t n) -> std::vector<std::string>
+{
+    std::vector<std::size_t> labels(n);
+    std::iota(labels.begin(), labels.end(), std::size_t{0});
+    std::vector<std::size_t> values(n, SIZE_MAX);
+    std::size_t next = 0;
+
+    for (std::size_t first = 0; n - first > 16;) {
+        std::size_t* const items = labels.data() + first;
+        std::size_t const size = n - first;
+        values[items[0]] = next++;
+        values[items[size / 2]] = next++;
+        std::size_t const pivot = next - 1;
+        std::size_t lt = 0;
+        std::size_t i = 0;
+        std::size_t gt = size;
+        while (i < gt) {
+            if (values[items[i]] < pivot) {
+                std::swap(items[lt++], items[i++]);
+            } else if (values[items[i]] > pivot) {
+                std::swap(items[i], items[--gt]);
+            } else {
+                ++i;
+            }
+        }
+        first += gt;
+    }
+    for (std::size_t& value : values) {
+        if (value == SIZE_MAX) {
+            value = next++;
+        }
+    }
+
+    // Zero-padded to eight digits, so that the strings' order is the
+    // values' and each fills one cache
+    std::vector<std::string> out;
+    for (std::size_t value : values) {
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "%08zu", value);
+        out.emplace_back(buf);
+    }
+    return out;
+}
+
+/*
+ * MARK: string_sort tests
+ */
+
+bool test_string_sort()
+{
+    std::vector<std::string> const strs = {
+        "banana", "apple", "", "cherry", "apple", "app", "applesauce", "b", "",
+        "a longer string than eight bytes", "a longer string than eight bytez",
+        "a longer string", std::string("app\0", 4), std::string("app\0\0", 5),
+    };
+    auto keys = slices(strs);
+    tcb::string_sort(tcb::ptr_to_mut_array(keys));
+    for (std::size_t i = 1; i < keys.size(); ++i) {
+        REQUIRE(*keys[i - 1] <= *keys[i]);
+    }
+    REQUIRE(keys.front()->size() == 0);
+    REQUIRE(std::string(keys.back()->data(), keys.back()->size()) == "cherry");
+
+    // Empty and single-element arrays
+    auto none = keys;
+    tcb::string_sort(tcb::pointer<tcb::pointer<char const[]>[]>::from_address_with_size(
+        none.data(), 0));
+    REQUIRE(none == keys);
+    REQUIRE(sorts_like_std_sort(slices(std::vector<std::string>{"one"})));
+
+    return true;
+}
+
+bool test_against_std_sort()
+{
+    // Short and long strings, over small and large alphabets, with and
+    // without a long common prefix
+    for (std::size_t n : {10u, 17u, 100u, 1000u, 20000u}) {
+        for (std::size_t max_len : {3u, 12u, 40u}) {
+            for (int alphabet : {2, 26, 256}) {
+                for (std::string prefix : {"", "https://www.example.com/"}) {
+                    auto const strs = random_strings(n, max_len, alphabet, prefix);
+                    REQUIRE(sorts_like_std_sort(slices(strs)));
+                }
+            }
+        }
+    }
+
+    // Keys which defeat median-of-three pivots
+    REQUIRE(sorts_like_std_sort(slices(quicksort_killer(20'000))));
+
+    // Many copies of a few keys
+    std::vector<std::string> dups;
+    for (std::size_t i = 0; i < 5000; ++i) {
+        dups.push_back(std::string(i % 3 * 9, 'x'));
+    }
+    REQUIRE(sorts_like_std_sort(slices(dups)));
+
+    return true;
+}
+
+bool test_char_types()
+{
+    // Plain char compares as char does, so on platforms where it is signed,
+    // bytes with the top bit set come before the others
+    std::vector<std::string> const strs = {"\x80", "\x7f", "\xff", "a", "\x01", std::string(1, 0)};
+    REQUIRE(sorts_like_std_sort(slices(strs)));
+    auto const high = random_strings(3000, 20, 256, "");
+    REQUIRE(sorts_like_std_sort(slices(high)));
+
+    std::vector<std::basic_string<unsigned char>> ustrs;
+    std::vector<std::basic_string<signed char>> sstrs;
+    std::vector<std::basic_string<char8_t>> u8strs;
+    for (auto const& str : high) {
+        ustrs.emplace_back(str.begin(), str.end());
+        sstrs.emplace_back(str.begin(), str.end());
+        u8strs.emplace_back(str.begin(), str.end());
+    }
+    REQUIRE(sorts_like_std_sort(slices(ustrs)));
+    REQUIRE(sorts_like_std_sort(slices(sstrs)));
+    REQUIRE(sorts_like_std_sort(slices(u8strs)));
+
+    // Bytes
+    std::vector<std::vector<std::byte>> bytes;
+    for (auto const& str : high) {
+        auto& b = bytes.emplace_back();
+        b.reserve(str.size() + 1); // so that empty keys have an address
+        for (char c : str) {
+            b.push_back(static_cast<std::byte>(c));
+        }
+    }
+    std::vector<tcb::pointer<std::byte const[]>> byte_keys;
+    for (auto const& b : bytes) {
+        byte_keys.push_back(tcb::pointer<std::byte const[]>::from_address_with_size(b.data(),
+                                                                                    b.size()));
+    }
+    REQUIRE(sorts_like_std_sort(byte_keys));
+
+    return true;
+}
+
+bool test_parallel()
+{
+    // Enough keys for several tasks, including runs of equal keys which all
+    // go to one task
+    auto strs = random_strings(300'000, 16, 26, "key/");
+    for (std::size_t i = 0; i < 50'000; ++i) {
+        strs.push_back("key/same");
+    }
+    auto const keys = slices(strs);
+    auto expected = keys;
+    tcb::string_sort(tcb::ptr_to_mut_array(expected));
+
+    for (std::size_t threads : {1u, 2u, 3u, 4u}) {
+        auto par_keys = keys;
+        tcb::string_sort(tcb::parallel_t{threads}, tcb::ptr_to_mut_array(par_keys));
+        REQUIRE(std::ranges::equal(par_keys, expected,
+                                   [](auto const& a, auto const& b) { return *a == *b; }));
+    }
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_string_sort();
+    REQUIRE(b);
+
+    b = test_against_std_sort();
+    REQUIRE(b);
+
+    b = test_char_types();
+    REQUIRE(b);
+
+    b = test_parallel();
+    REQUIRE(b);
+}
@@ -0,0 +1,60 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+// A temporary file for the tests of the POSIX I/O headers. Include it only
+// where they are available.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib> // for mkstemp
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "test_machinery.hpp"
+
+// An anonymous file, unlinked as soon as it is made, and closed when this
+// is destroyed
+struct temp_file {
+    int fd;
+
+    temp_file()
+    {
+        char path[] = "/tmp/tcb_test_XXXXXX";
+        fd = ::mkstemp(path);
+        REQUIRE(fd >= 0);
+        ::unlink(path);
+    }
+
+    // A file holding contents, positioned at its start
+    explicit temp_file(std::vector<std::byte> const& contents) : temp_file()
+    {
+        auto const written = ::write(fd, contents.data(), contents.size());
+        REQUIRE(written == static_cast<::ssize_t>(contents.size()));
+        REQUIRE(::lseek(fd, 0, SEEK_SET) == 0);
+    }
+
+    temp_file(temp_file const&) = delete;
+    auto operator=(temp_file const&) -> temp_file& = delete;
+
+    ~temp_file() { ::close(fd); }
+
+    auto size() const -> std::uint64_t
+    {
+        struct ::stat st {};
+        REQUIRE(::fstat(fd, &st) == 0);
+        return static_cast<std::uint64_t>(st.st_size);
+    }
+
+    auto contents() const -> std::string
+    {
+        std::string out(size(), '\0');
+        REQUIRE(::pread(fd, out.data(), out.size(), 0) == static_cast<::ssize_t>(out.size()));
+        return out;
+    }
+};
@@ -0,0 +1,38 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include <stdexcept>
+
+struct test_failure : std::runtime_error {
+    using std::runtime_error::runtime_error;
+};
+
+#define STRINGIFY2(x) #x
+#define STRINGIFY(x) STRINGIFY2(x)
+
+#define REQUIRE(...)        \
+    if (!(__VA_ARGS__))     \
+        throw test_failure( \
+            __FILE__ ":" STRINGIFY(__LINE__) ": Test \"" STRINGIFY(__VA_ARGS__) "\" failed");
+
+#define REQUIRE_THROWS_AS(type, ...)                                                   \
+    do {                                                                               \
+        bool caught = false;                                                           \
+        try {                                                                          \
+            (void)__VA_ARGS__;                                                         \
+        } catch (type const&) {                                                        \
+            caught = true;                                                             \
+        } catch (...) {                                                                \
+            throw test_failure(__FILE__ ":" STRINGIFY(__LINE__) ": Test \"" STRINGIFY( \
+                __VA_ARGS__) "\" threw an exception of unexpected type");              \
+        }                                                                              \
+        if (!caught) {                                                                 \
+            throw test_failure(__FILE__ ":" STRINGIFY(__LINE__) ": Test \"" STRINGIFY( \
+                __VA_ARGS__) "\" did not throw an exception when one was expected");   \
+        }                                                                              \
+    } while (0)
+
+#define REQUIRE_ERROR(...) REQUIRE_THROWS_AS(std::runtime_error, __VA_ARGS__)
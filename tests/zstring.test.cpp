@@ -0,0 +1,146 @@
+// Copyright (c) 2025 Tristan Brindle (tcbrindle at gmail dot com)
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <tcb/zstring.hpp>
+
+#include "test_machinery.hpp"
+
+static_assert(std::ranges::contiguous_range<tcb::zstring_ptr>);
+static_assert(std::ranges::borrowed_range<tcb::zstring_ptr>);
+static_assert(std::ranges::sized_range<tcb::zstring_ptr>);
+static_assert(!std::ranges::common_range<tcb::zstring_ptr>);
+static_assert(std::is_convertible_v<tcb::zstring_ptr, tcb::pointer<char const[]>>);
+
+// Usable in constant expressions
+static_assert(tcb::zstring_ptr::from_address("hello").size() == 5);
+static_assert(tcb::zstring_ptr::from_address("").empty());
+static_assert(std::ranges::count(tcb::zstring_ptr::from_address("banana"), 'a') == 3);
+
+/*
+ * MARK: zstring_ptr tests
+ */
+
+bool test_zstring_ptr()
+{
+    char const* const c_str = "hello, world";
+    auto const z = tcb::zstring_ptr::from_address(c_str);
+    REQUIRE(z.c_str() == c_str);
+    REQUIRE(!z.empty());
+
+    // Iterating doesn't need the length
+    std::string copy(z.begin(), std::ranges::next(z.begin(), z.end()));
+    REQUIRE(copy == c_str);
+    REQUIRE(!z.size_known());
+
+    REQUIRE(z.size() == 12);
+    REQUIRE(z.size_known());
+
+    // Copies keep the length
+    auto const other = z;
+    REQUIRE(other.size_known());
+    REQUIRE(other == z);
+
+    // Converting to an array pointer
+    tcb::pointer<char const[]> const arr = z;
+    REQUIRE(arr->data() == c_str);
+    REQUIRE(arr->size() == 12);
+
+    // Strings whose length is known already
+    std::string const str = "known length";
+    auto const known = tcb::zstring_ptr::from_address_with_size(str.c_str(), str.size());
+    REQUIRE(known.size_known());
+    REQUIRE(known.size() == str.size());
+
+    auto const empty = tcb::zstring_ptr::from_address("");
+    REQUIRE(empty.empty());
+    REQUIRE(empty.size() == 0);
+    REQUIRE(empty.begin() == empty.end());
+
+    return true;
+}
+
+bool test_lengths()
+{
+    // Every length up to a few blocks, at every alignment, with garbage
+    // after the terminator
+    std::vector<char> buffer(512, 'x');
+    for (std::size_t start = 0; start < 64; ++start) {
+        for (std::size_t len = 0; len < 300; ++len) {
+            std::ranges::fill(buffer, 'x');
+            buffer[start + len] = '\0';
+            char const* const s = buffer.data() + start;
+            REQUIRE(tcb::zstring_ptr::from_address(s).size() == len);
+        }
+    }
+
+    // Bytes with the top bit set aren't terminators
+    std::string high(200, '\x80');
+    REQUIRE(tcb::zstring_ptr::from_address(high.c_str()).size() == 200);
+
+    // Strings which end at the end of their allocation
+    for (std::size_t len : {0u, 1u, 63u, 64u, 4095u}) {
+        auto const alloc = std::make_unique<char[]>(len + 1);
+        std::memset(alloc.get(), 'y', len);
+        REQUIRE(tcb::zstring_ptr::from_address(alloc.get()).size() == len);
+    }
+
+    return true;
+}
+
+bool test_threads()
+{
+    // Several threads can measure the same zstring_ptr at once
+    std::string const str(100'000, 'z');
+    auto const z = tcb::zstring_ptr::from_address(str.c_str());
+    std::vector<std::jthread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&z] { REQUIRE(z.size() == 100'000); });
+    }
+    threads.clear();
+    REQUIRE(z.size_known());
+
+    return true;
+}
+
+/*
+ * MARK: Error tests
+ */
+
+bool test_errors()
+{
+    char const* const null = nullptr;
+    REQUIRE_ERROR(tcb::zstring_ptr::from_address(null));
+    REQUIRE_ERROR(tcb::zstring_ptr::from_address_with_size(null, 0));
+    REQUIRE_ERROR(tcb::zstring_ptr::from_address_with_size("abc", 2));
+
+    return true;
+}
+
+/*
+ * MARK: main()
+ */
+
+int main()
+{
+    bool b = true;
+
+    b = test_zstring_ptr();
+    REQUIRE(b);
+
+    b = test_lengths();
+    REQUIRE(b);
+
+    b = test_threads();
+    REQUIRE(b);
+
+    b = test_errors();
+    REQUIRE(b);
+}